@@ -0,0 +1,264 @@
+#!/usr/bin/env python3
+
+"""
+Convert a VCD file into a SAIF switching activity file, and summarise
+signal toggle rates per module.
+
+    vcd2saif.py waves.vcd -o waves.saif --report toggles.txt
+    <model> +WAVES=/dev/fd/3 3>&1 >log | vcd2saif.py - -o waves.saif
+
+The VCD is read as a stream, so it can come straight from a running
+model through a pipe, without ever being written to disk. Values are
+treated as 2-state: x and z count as 0. TX is only the time before a
+signal's first value, and IG is always 0.
+
+Run via the saif-embench-<benchmark> make targets. See
+docs/energy-efficiency.md.
+"""
+
+import argparse
+import re
+import sys
+import time
+
+
+class Var:
+    """One $var reference: a scope, name and bit range."""
+
+    def __init__(self, scope, name, width, lsb):
+        self.scope = scope
+        self.name  = name
+        self.width = width
+        self.lsb   = lsb
+
+
+class Signal:
+    """Per-bit activity of one VCD identifier code."""
+
+    def __init__(self, width):
+        self.width  = width
+        self.value  = None
+        self.first_t= None
+        self.last_t = [0] * width
+        self.t0     = [0] * width
+        self.t1     = [0] * width
+        self.tc     = [0] * width
+
+    def change(self, t, value):
+        if self.value is None:
+            self.value  = value
+            self.first_t= t
+            self.last_t = [t] * self.width
+            return
+        diff = self.value ^ value
+        while diff:
+            low = diff & -diff
+            i   = low.bit_length() - 1
+            if self.value & low:
+                self.t1[i] += t - self.last_t[i]
+            else:
+                self.t0[i] += t - self.last_t[i]
+            self.last_t[i] = t
+            self.tc[i]    += 1
+            diff          ^= low
+        self.value = value
+
+    def finish(self, t):
+        if self.value is None:
+            return
+        for i in range(self.width):
+            if (self.value >> i) & 1:
+                self.t1[i] += t - self.last_t[i]
+            else:
+                self.t0[i] += t - self.last_t[i]
+            self.last_t[i] = t
+
+
+def parse_bits(text):
+    """Binary VCD value to an int. x and z count as 0."""
+    return int(text.translate(str.maketrans("xXzZ", "0000")), 2)
+
+
+def read_vcd(fh):
+    """Return (timescale, vars, signals, t_start, t_end)."""
+    timescale = "1 ps"
+    scope     = []
+    vars      = []
+    signals   = {}
+    t         = None
+    t_start   = None
+
+    tokens = iter_tokens(fh)
+
+    # Header.
+    for tok in tokens:
+        if tok == "$timescale":
+            m = re.match(r"(\d+)\s*(\w+)", " ".join(until_end(tokens)))
+            if m:
+                timescale = "%s %s" % m.groups()
+        elif tok == "$scope":
+            scope.append(until_end(tokens)[1])
+        elif tok == "$upscope":
+            until_end(tokens)
+            scope.pop()
+        elif tok == "$var":
+            f     = until_end(tokens)
+            width = int(f[1])
+            code  = f[2]
+            name  = f[3]
+            rng   = f[4] if len(f) > 4 and f[4].startswith("[") else ""
+            if "[" in name:
+                name, rng = name.split("[", 1)
+            lsb   = 0
+            if rng:
+                lsb = min(int(r) for r in rng.strip("[]").split(":"))
+            vars.append((code, Var("/".join(scope), name, width, lsb)))
+            if code not in signals:
+                signals[code] = Signal(width)
+        elif tok == "$enddefinitions":
+            until_end(tokens)
+            break
+        elif tok.startswith("$"):
+            until_end(tokens)
+
+    # Value changes.
+    for tok in tokens:
+        c = tok[0]
+        if c == "#":
+            t = int(tok[1:])
+            if t_start is None:
+                t_start = t
+        elif c in "01xXzZ":
+            s = signals.get(tok[1:])
+            if s is not None:
+                s.change(t, 1 if c == "1" else 0)
+        elif c in "bB":
+            s = signals.get(next(tokens))
+            if s is not None:
+                s.change(t, parse_bits(tok[1:]))
+        elif c in "rR":
+            next(tokens)
+        # $dumpvars, $end etc. need no action.
+
+    t_end = t if t is not None else 0
+    t_start = t_start if t_start is not None else 0
+
+    for s in signals.values():
+        s.finish(t_end)
+
+    return timescale, vars, signals, t_start, t_end
+
+
+def iter_tokens(fh):
+    for line in fh:
+        for tok in line.split():
+            yield tok
+
+
+def until_end(tokens):
+    out = []
+    for tok in tokens:
+        if tok == "$end":
+            break
+        out.append(tok)
+    return out
+
+
+def saif_name(name):
+    for c in "[]()":
+        name = name.replace(c, "\\" + c)
+    return name
+
+
+def write_saif(fh, timescale, vars, signals, t_start, t_end):
+    """Write every bit of every var, grouped into nested instances."""
+    tree = {}
+    for code, v in vars:
+        node = tree
+        for part in v.scope.split("/"):
+            node = node.setdefault(part, {})
+        node.setdefault(None, []).append((code, v))
+
+    fh.write('(SAIFILE\n(SAIFVERSION "2.0")\n(DIRECTION "backward")\n')
+    fh.write('(DESIGN )\n(DATE "%s")\n' % time.strftime("%c"))
+    fh.write('(VENDOR "croyde-riscv")\n(PROGRAM_NAME "vcd2saif.py")\n')
+    fh.write('(VERSION "1.0")\n(DIVIDER / )\n')
+    fh.write('(TIMESCALE %s)\n(DURATION %d)\n' % (timescale,
+                                                   t_end - t_start))
+
+    def write_node(name, node, indent):
+        pad = "  " * indent
+        fh.write('%s(INSTANCE %s\n' % (pad, saif_name(name)))
+        if None in node:
+            fh.write('%s  (NET\n' % pad)
+            for code, v in node[None]:
+                s  = signals[code]
+                tx = t_end if s.first_t is None else s.first_t
+                tx = tx - t_start
+                for i in range(v.width):
+                    net = v.name
+                    if v.width > 1:
+                        net = "%s[%d]" % (v.name, v.lsb + i)
+                    fh.write('%s    (%s (T0 %d) (T1 %d) (TX %d) (TC %d) '
+                             '(IG 0))\n' % (pad, saif_name(net), s.t0[i],
+                                            s.t1[i], tx, s.tc[i]))
+            fh.write('%s  )\n' % pad)
+        for child in sorted(k for k in node if k is not None):
+            write_node(child, node[child], indent + 1)
+        fh.write('%s)\n' % pad)
+
+    for name in sorted(k for k in tree if k is not None):
+        write_node(name, tree[name], 0)
+
+    fh.write(')\n')
+
+
+def write_report(fh, vars, signals, cycles):
+    """Toggles per bit per clock cycle, for the signals in each scope."""
+    bits    = {}
+    toggles = {}
+    for code, v in vars:
+        bits   [v.scope] = bits   .get(v.scope, 0) + v.width
+        toggles[v.scope] = toggles.get(v.scope, 0) + sum(signals[code].tc)
+
+    fh.write("# %d clock cycles\n" % cycles)
+    fh.write("%-60s %8s %12s %10s\n" % ("scope", "bits", "toggles",
+                                        "rate"))
+    rows = sorted(bits, key=lambda k: -toggles[k])
+    for scope in rows:
+        rate = toggles[scope] / float(bits[scope] * cycles) if cycles else 0
+        fh.write("%-60s %8d %12d %10.4f\n" % (scope, bits[scope],
+                                              toggles[scope], rate))
+
+
+def main():
+    p = argparse.ArgumentParser(description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    p.add_argument("vcd", help="VCD file to read, or - for stdin.")
+    p.add_argument("-o", "--output", help="SAIF file to write.")
+    p.add_argument("--report", help="Write per-scope toggle rates here.")
+    p.add_argument("--period", type=int, default=20,
+        help="VCD time units per clock cycle. The Verilator testbench "
+             "uses 20.")
+    args = p.parse_args()
+
+    fh = sys.stdin if args.vcd == "-" else open(args.vcd)
+
+    timescale, vars, signals, t_start, t_end = read_vcd(fh)
+
+    duration = t_end - t_start
+    cycles   = duration // args.period
+
+    if args.output:
+        with open(args.output, "w") as out:
+            write_saif(out, timescale, vars, signals, t_start, t_end)
+
+    if args.report:
+        with open(args.report, "w") as out:
+            write_report(out, vars, signals, cycles)
+    else:
+        write_report(sys.stdout, vars, signals, cycles)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,277 @@
+#!/usr/bin/env python3
+
+"""
+Fmax / area sweep over core_top configurations.
+
+    sweep.py synth   - Synthesise every configuration at every ABC delay
+                       target using synth-cmos.tcl.
+    sweep.py embench - Build the CCX model for every configuration, and
+                       run the Embench benchmarks on it.
+    sweep.py report  - Join the synthesis and Embench results into one
+                       performance per area table.
+
+Run via the synthesise-sweep, embench-sweep and report-sweep make
+targets. See docs/flows-synthesis.md.
+"""
+
+import argparse
+import concurrent.futures
+import math
+import os
+import re
+import subprocess
+import sys
+
+# core_top parameters which ccx_top does not rename with a CORE_ prefix.
+CCX_UNPREFIXED = ["FPGA_REGFILE", "CLK_GATE_EN"]
+
+
+def read_configs(path):
+    """Return an ordered list of (name, [NAME=VALUE, ...]) tuples."""
+    configs = []
+    text    = open(path).read().replace("\\\n", " ")
+    for line in text.splitlines():
+        line = line.split("#")[0].split()
+        if not line:
+            continue
+        for p in line[1:]:
+            if "=" not in p:
+                sys.exit("Bad parameter '%s' for config %s" % (p, line[0]))
+        configs.append((line[0], line[1:]))
+    return configs
+
+
+def synth_dir(args, name, delay):
+    return os.path.join(args.out, name, "d%d" % delay)
+
+
+def synth_one(args, name, params, delay):
+    """Run yosys for one configuration. Returns (name, delay, exit code)."""
+    sdir = synth_dir(args, name, delay)
+    os.makedirs(sdir, exist_ok=True)
+    env = dict(os.environ)
+    env["SYNTH_DIR"]       = sdir
+    env["SYNTH_PARAMS"]    = " ".join(params)
+    env["SYNTH_ABC_DELAY"] = str(delay)
+    env.pop("SYNTH_MUL_IMPL"   , None)
+    env.pop("SYNTH_CRYPTO_IMPL", None)
+    cmd = [args.yosys, "-QT", "-l", os.path.join(sdir, "synth.log"),
+           args.script]
+    with open(os.path.join(sdir, "yosys.out"), "w") as fh:
+        rc = subprocess.call(cmd, env=env, stdout=fh, stderr=subprocess.STDOUT)
+    return (name, delay, rc)
+
+
+def cmd_synth(args):
+    configs = read_configs(args.configs)
+    jobs    = [(n, p, d) for (n, p) in configs for d in args.delays]
+    failed  = 0
+    with concurrent.futures.ThreadPoolExecutor(args.jobs) as pool:
+        futures = [pool.submit(synth_one, args, n, p, d) for (n, p, d) in jobs]
+        for f in concurrent.futures.as_completed(futures):
+            name, delay, rc = f.result()
+            print("%-20s delay=%-6d %s" % (name, delay,
+                  "ok" if rc == 0 else "FAILED (%d)" % rc))
+            failed += rc != 0
+    return 1 if failed else 0
+
+
+def ccx_flags(params):
+    flags = []
+    for p in params:
+        k, v = p.split("=", 1)
+        if k not in CCX_UNPREFIXED:
+            k = "CORE_" + k
+        flags.append("-G%s=%s" % (k, v))
+    return flags
+
+
+def parse_embench_log(path):
+    """Return the simulated cycle count from a CCX testbench log."""
+    if not os.path.isfile(path):
+        return None
+    m = re.search(r">> Finished after (\d+) simulated clock cycles",
+                  open(path).read())
+    return int(m.group(1)) if m else None
+
+
+def cmd_embench(args):
+    configs = read_configs(args.configs)
+    base    = os.environ.get("FLG_CCX", "")
+    failed  = 0
+    for name, params in configs:
+        flags = " ".join([base] + ccx_flags(params))
+        logs  = [(bm, os.path.join(args.embench_build, "src", bm, bm+".log"))
+                 for bm in args.benchmarks]
+        # Logs are written to the same place for every configuration.
+        # Remove the last one's, so a benchmark which does not run shows
+        # up as missing rather than with stale cycle counts.
+        for bm, log in logs:
+            if os.path.isfile(log):
+                os.remove(log)
+        print(">> Embench: %s (%s)" % (name, flags.strip()))
+        rc = subprocess.call(["make", "-C", args.repo_home, "-k",
+                              "run-embench-targets", "FLG_CCX=%s" % flags])
+        if rc != 0:
+            print(">> Embench: %s FAILED (%d)" % (name, rc))
+            failed += 1
+        os.makedirs(os.path.join(args.out, name), exist_ok=True)
+        with open(os.path.join(args.out, name, "embench.txt"), "w") as fh:
+            fh.write("# status %s\n" % ("ok" if rc == 0 else "failed"))
+            for bm, log in logs:
+                cycles = parse_embench_log(log)
+                fh.write("%s %s\n" % (bm, "-" if cycles is None else cycles))
+    return 1 if failed else 0
+
+
+def parse_synth_rpt(path):
+    """Return cells, transistors, path depth and endpoints from a report."""
+    r = {"cells": None, "transistors": None, "depth": None,
+         "start": "-", "end": "-"}
+    if not os.path.isfile(path):
+        return r
+    text = open(path).read()
+    m = re.search(r"Number of cells:\s+(\d+)", text)
+    if m:
+        r["cells"] = int(m.group(1))
+    m = re.search(r"Estimated number of transistors:\s+(\d+)", text)
+    if m:
+        r["transistors"] = int(m.group(1))
+    m = re.search(r"Longest topological path in \S+ \(length=(\d+)\):", text)
+    if m:
+        r["depth"] = int(m.group(1))
+        path  = text[m.end():].strip("\n").split("\n\n")[0]
+        nodes = re.findall(r"^\s*\d+: (\S+)$", path, re.M)
+        # Internal ABC nets are unnamed; report the nearest named signals.
+        named = [n for n in nodes if not n.startswith("$")] or nodes
+        if named:
+            r["start"] = named[ 0].lstrip("\\")
+            r["end"  ] = named[-1].lstrip("\\")
+    return r
+
+
+def read_embench(path):
+    """Return ({benchmark: cycles}, status) for one configuration. status
+    is "ok", "failed", or None if Embench was never run for it."""
+    cycles = {}
+    status = None
+    if os.path.isfile(path):
+        status = "failed"
+        for line in open(path):
+            if line.startswith("#"):
+                if line.split() == ["#", "status", "ok"]:
+                    status = "ok"
+                continue
+            bm, c = line.split()
+            if c != "-":
+                cycles[bm] = int(c)
+    return (cycles, status)
+
+
+def geomean(values):
+    return math.exp(sum(math.log(v) for v in values) / len(values))
+
+
+def fmt(v, f="%d"):
+    return "-" if v is None else f % v
+
+
+def cmd_report(args):
+    configs = read_configs(args.configs)
+    embench = {}
+    failed  = []
+    for n, _ in configs:
+        cycles, status = read_embench(os.path.join(args.out, n,
+                                                   "embench.txt"))
+        # A failed run's results are incomplete. Leave them out.
+        embench[n] = cycles if status == "ok" else {}
+        if status == "failed":
+            failed.append(n)
+
+    # Only compare benchmarks which ran on every configuration.
+    common = None
+    for c in embench.values():
+        if c:
+            common = set(c) if common is None else common & set(c)
+    common = sorted(common or [])
+
+    rows = []
+    for delay in args.delays:
+        base = None
+        for name, _ in configs:
+            r = parse_synth_rpt(os.path.join(synth_dir(args, name, delay),
+                                             "synth-cmos.rpt"))
+            r["name"]   = name
+            r["delay"]  = delay
+            have        = embench[name]
+            r["cycles"] = geomean([have[b] for b in common]) \
+                          if common and set(common) <= set(have) else None
+            r["perf"] = r["perf_area"] = None
+            if base is None:
+                base = r
+            # Assume Fmax scales with 1 / critical path depth.
+            if None not in (r["cycles"], r["depth"], base["cycles"],
+                            base["depth"]):
+                r["perf"] = (base["cycles"] * base["depth"]) / \
+                            (r["cycles"] * r["depth"])
+                if None not in (r["transistors"], base["transistors"]):
+                    r["perf_area"] = r["perf"] / \
+                        (r["transistors"] / base["transistors"])
+            rows.append(r)
+
+    hdr = ["config", "delay", "cells", "transistors", "depth", "cycles",
+           "perf", "perf/area", "path start", "path end"]
+    with open(os.path.join(args.out, "sweep-report.csv"), "w") as fh:
+        fh.write(",".join(hdr) + "\n")
+        for r in rows:
+            fh.write(",".join([r["name"], str(r["delay"]),
+                fmt(r["cells"]), fmt(r["transistors"]), fmt(r["depth"]),
+                fmt(r["cycles"], "%.0f"), fmt(r["perf"], "%.3f"),
+                fmt(r["perf_area"], "%.3f"), r["start"], r["end"]]) + "\n")
+
+    print("Embench cycles are the geometric mean over %d benchmarks." %
+          len(common))
+    if failed:
+        print("Embench failed for: %s. Their cycles are left out." %
+              " ".join(failed))
+    print("perf and perf/area are relative to %s at the same delay." %
+          configs[0][0])
+    print("%-16s %6s %8s %11s %6s %10s %6s %9s  %s" % tuple(hdr[:-2] +
+          ["critical path"]))
+    for r in rows:
+        print("%-16s %6d %8s %11s %6s %10s %6s %9s  %s -> %s" % (
+            r["name"], r["delay"], fmt(r["cells"]), fmt(r["transistors"]),
+            fmt(r["depth"]), fmt(r["cycles"], "%.0f"), fmt(r["perf"], "%.3f"),
+            fmt(r["perf_area"], "%.3f"), r["start"], r["end"]))
+    return 0
+
+
+def main():
+    p = argparse.ArgumentParser(description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    p.add_argument("command", choices=["synth", "embench", "report"])
+    p.add_argument("--configs", required=True,
+        help="Configuration list. See sweep-configs.txt")
+    p.add_argument("--out", required=True, help="Sweep output directory")
+    p.add_argument("--delays", type=int, nargs="+", default=[0],
+        help="ABC delay targets in ps. 0 = no delay target")
+    p.add_argument("--jobs", type=int, default=1,
+        help="Parallel yosys runs")
+    p.add_argument("--yosys", default="yosys", help="Yosys executable")
+    p.add_argument("--script", default=os.path.join(
+        os.path.dirname(os.path.abspath(__file__)), "synth-cmos.tcl"),
+        help="Yosys synthesis script")
+    p.add_argument("--repo-home", default=os.environ.get("REPO_HOME", "."))
+    p.add_argument("--embench-build", default="",
+        help="Embench build directory, containing src/<benchmark>/")
+    p.add_argument("--benchmarks", nargs="*", default=[],
+        help="Embench benchmark names")
+    args = p.parse_args()
+
+    return {"synth"  : cmd_synth,
+            "embench": cmd_embench,
+            "report" : cmd_report}[args.command](args)
+
+
+if __name__ == "__main__":
+    sys.exit(main())
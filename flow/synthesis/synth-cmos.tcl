@@ -9,6 +9,7 @@ read_verilog -sv $::env(REPO_HOME)/rtl/core/core_pipe_fetch_buffer.sv
 read_verilog -sv $::env(REPO_HOME)/rtl/core/core_pipe_fetch.sv
 read_verilog -sv $::env(REPO_HOME)/rtl/core/core_pipe_decode_immediates.sv
 read_verilog -sv $::env(REPO_HOME)/rtl/core/core_pipe_decode.sv
+read_verilog -sv $::env(REPO_HOME)/rtl/core/core_pipe_decode_pair.sv
 read_verilog -sv $::env(REPO_HOME)/rtl/core/core_pipe_exec_alu.sv
 read_verilog -sv $::env(REPO_HOME)/rtl/core/core_pipe_exec_cfu.sv
 read_verilog -sv $::env(REPO_HOME)/rtl/core/core_pipe_exec_lsu.sv
@@ -28,11 +29,36 @@ read_verilog -sv $::env(REPO_HOME)/rtl/core/core_regfile.sv
 read_verilog -sv $::env(REPO_HOME)/rtl/core/core_interrupts.sv
 read_verilog -sv $::env(REPO_HOME)/rtl/core/core_top.sv
 
+# Optionally select the multiplier implementation.
+if {[info exists ::env(SYNTH_MUL_IMPL)]} {
+    chparam -set MUL_IMPL $::env(SYNTH_MUL_IMPL) core_top
+}
+
+# Optionally select the crypto datapath implementation.
+if {[info exists ::env(SYNTH_CRYPTO_IMPL)]} {
+    chparam -set CRYPTO_IMPL $::env(SYNTH_CRYPTO_IMPL) core_top
+}
+
+# Optionally override any other core_top parameters. SYNTH_PARAMS is a
+# space separated list of NAME=VALUE pairs, e.g. "MUL_UNROLL=8 ARCH_ZK=0".
+if {[info exists ::env(SYNTH_PARAMS)]} {
+    foreach p [split [string trim $::env(SYNTH_PARAMS)]] {
+        if {$p eq ""} { continue }
+        set kv [split $p "="]
+        chparam -set [lindex $kv 0] [lindex $kv 1] core_top
+    }
+}
+
 # Generic yosys synthesis command
 synth -top core_top -flatten
 
-# Map to CMOS cells
-abc -g cmos4
+# Map to CMOS cells. SYNTH_ABC_DELAY optionally sets an ABC delay target,
+# in picoseconds, to trade area for a shorter critical path.
+if {[info exists ::env(SYNTH_ABC_DELAY)] && $::env(SYNTH_ABC_DELAY) > 0} {
+    abc -g cmos4 -D $::env(SYNTH_ABC_DELAY)
+} else {
+    abc -g cmos4
+}
 
 # Simple optimisations
 opt fast
@@ -41,4 +67,5 @@ write_verilog   $::env(SYNTH_DIR)/synth-cmos.v
 
 # Statistics: size and latency
 tee -o $::env(SYNTH_DIR)/synth-cmos.rpt stat
+tee -a $::env(SYNTH_DIR)/synth-cmos.rpt stat -tech cmos
 tee -a $::env(SYNTH_DIR)/synth-cmos.rpt ltp  -noff
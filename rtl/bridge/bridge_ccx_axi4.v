@@ -0,0 +1,358 @@
+
+//
+// module: bridge_ccx_axi4
+//
+//  A module for bridging the Core Complex (CCX) external memory
+//  interface into a full AXI4 implementation.
+//
+//  - Instruction fetches (and optionally data reads) are served from
+//    RD_LINES line buffers. Each buffer is refilled with a single
+//    LINE_BEATS long INCR burst, using its index as the AXI read ID.
+//    While one line is being consumed, the next sequential line is
+//    prefetched into another buffer, so up to RD_LINES bursts may be
+//    outstanding at once.
+//  - Other data reads are single beat transactions, using read ID
+//    RD_LINES.
+//  - Writes are posted: the CCX request is granted as soon as the
+//    address and data beats are accepted, and up to WR_OUTSTANDING
+//    write responses may be pending. Error responses to posted writes
+//    are signalled on wr_err. With WR_OUTSTANDING=0, each write waits
+//    for its response, and errors are returned on ccx_err.
+//  - Reads are not issued while writes are outstanding, and writes
+//    invalidate any line buffer they hit, so reads always observe
+//    earlier writes.
+//
+module bridge_ccx_axi4 (
+
+input  wire            axi_aclk    , // AXI Clock
+input  wire            axi_aresetn , // AXI Reset
+
+output wire            axi_awvalid , //
+input  wire            axi_awready , //
+output wire [ID_W-1:0] axi_awid    , //
+output wire [  AW-1:0] axi_awaddr  , //
+output wire [     7:0] axi_awlen   , //
+output wire [     2:0] axi_awsize  , //
+output wire [     1:0] axi_awburst , //
+output wire [     3:0] axi_awcache , //
+output wire [     2:0] axi_awprot  , //
+
+output wire            axi_wvalid  , //
+input  wire            axi_wready  , //
+output wire [  DW-1:0] axi_wdata   , //
+output wire [     7:0] axi_wstrb   , //
+output wire            axi_wlast   , //
+
+input  wire            axi_bvalid  , //
+output wire            axi_bready  , //
+input  wire [ID_W-1:0] axi_bid     , //
+input  wire [     1:0] axi_bresp   , //
+
+output reg             axi_arvalid , //
+input  wire            axi_arready , //
+output reg  [ID_W-1:0] axi_arid    , //
+output reg  [  AW-1:0] axi_araddr  , //
+output reg  [     7:0] axi_arlen   , //
+output wire [     2:0] axi_arsize  , //
+output wire [     1:0] axi_arburst , //
+output wire [     3:0] axi_arcache , //
+output reg  [     2:0] axi_arprot  , //
+
+input  wire            axi_rvalid  , //
+output wire            axi_rready  , //
+input  wire [ID_W-1:0] axi_rid     , //
+input  wire [  DW-1:0] axi_rdata   , //
+input  wire [     1:0] axi_rresp   , //
+input  wire            axi_rlast   , //
+
+input  wire            ccx_req     , // Memory request
+input  wire            ccx_rtype   , // Request type: 0=data,1=instr.
+input  wire [  AW-1:0] ccx_addr    , // Memory request address
+input  wire            ccx_wen     , // Memory request write enable
+input  wire [     7:0] ccx_strb    , // Memory request write strobe
+input  wire [  DW-1:0] ccx_wdata   , // Memory write data.
+output wire            ccx_gnt     , // Memory response valid
+output reg             ccx_err     , // Memory response error
+output reg  [  DW-1:0] ccx_rdata   , // Memory response read data
+
+output wire            wr_err        // Posted write got an error response.
+
+);
+
+parameter   AW = 39;    // Address width
+parameter   DW = 64;    // Data width
+
+parameter   RD_LINES        = 2; // Line buffers / outstanding bursts.
+parameter   LINE_BEATS      = 4; // Beats per line refill burst. Power of 2.
+parameter   RD_BURST_DATA   = 0; // Serve data reads from line buffers too.
+parameter   WR_OUTSTANDING  = 4; // Max posted writes. 0 = not posted.
+parameter   ID_W            = 2; // AXI ID width. Must hold RD_LINES.
+
+localparam  BEAT_W  = $clog2(LINE_BEATS);   // Beat index width.
+localparam  OFF_W   = 3 + BEAT_W;           // Line byte offset width.
+localparam  TAG_W   = AW - OFF_W;           // Line address width.
+localparam  LINE_W  = RD_LINES > 1 ? $clog2(RD_LINES) : 1;
+
+localparam  [ID_W-1:0] SINGLE_ID = RD_LINES;
+
+localparam  WR_CNT_W = $clog2(WR_OUTSTANDING + 2);
+
+//
+// Constant signal assignments:
+// ------------------------------------------------------------
+
+assign axi_rready  = 1'b1;
+assign axi_bready  = 1'b1;
+
+assign axi_arsize  = 3'b011;    // 8 byte beats.
+assign axi_arburst = 2'b01 ;    // INCR
+assign axi_arcache = 4'b0010;   // Normal, non-cacheable, modifiable.
+
+assign axi_awid    = {ID_W{1'b0}};
+assign axi_awaddr  = ccx_addr;
+assign axi_awlen   = 8'd0  ;
+assign axi_awsize  = 3'b011;
+assign axi_awburst = 2'b01 ;
+//                   Bufferable iff writes are posted.
+assign axi_awcache = {3'b000, WR_OUTSTANDING > 0};
+//                   Unprivilidged, Un-secured, Data
+assign axi_awprot  = {1'b0         , 1'b0      , 1'b0};
+
+assign axi_wdata   = ccx_wdata;
+assign axi_wstrb   = ccx_strb ;
+assign axi_wlast   = 1'b1     ;
+
+//
+// Request decoding
+// ------------------------------------------------------------
+
+wire                rd_req      = ccx_req && !ccx_wen;
+wire                wr_req      = ccx_req &&  ccx_wen;
+
+wire                rd_burst    = rd_req  && (ccx_rtype || RD_BURST_DATA);
+wire                rd_single   = rd_req  && !rd_burst;
+
+wire [ TAG_W-1:0]   req_tag     = ccx_addr[AW-1:OFF_W];
+wire [BEAT_W-1:0]   req_beat    = ccx_addr[OFF_W-1:3];
+
+// New response this cycle?
+wire                rsp_rd      = axi_rvalid  && axi_rready;
+wire                rsp_wr      = axi_bvalid  && axi_bready;
+
+//
+// Write path
+// ------------------------------------------------------------
+
+reg  [WR_CNT_W-1:0] wr_cnt      ; // Writes issued, awaiting a response.
+reg                 wr_wait     ; // Waiting for response to current write.
+reg                 aw_done     ; // Current write address accepted.
+reg                 w_done      ; // Current write data accepted.
+
+wire                aw_ok       = aw_done || axi_awvalid && axi_awready;
+wire                w_ok        = w_done  || axi_wvalid  && axi_wready ;
+
+wire                wr_room     = WR_OUTSTANDING > 0            ?
+                                  wr_cnt < WR_OUTSTANDING       :
+                                  !wr_wait                      ;
+
+assign              axi_awvalid = wr_req && wr_room && !aw_done && !wr_wait;
+assign              axi_wvalid  = wr_req && wr_room && !w_done  && !wr_wait;
+
+// Both address and data beats of the current write are now accepted.
+wire                wr_sent     = wr_req && aw_ok && w_ok && !wr_wait;
+
+wire                wr_gnt      = WR_OUTSTANDING > 0 ? wr_sent              :
+                                                       wr_wait && rsp_wr    ;
+
+wire [WR_CNT_W-1:0] n_wr_cnt    = wr_cnt + wr_sent - rsp_wr;
+
+assign              wr_err      = WR_OUTSTANDING > 0 && rsp_wr && |axi_bresp;
+
+// No reads are issued while a write might still be in flight.
+wire                wr_idle     = wr_cnt == 0 && !wr_req;
+
+always @(posedge axi_aclk) begin
+    if(!axi_aresetn) begin
+        wr_cnt  <= {WR_CNT_W{1'b0}};
+        wr_wait <= 1'b0;
+        aw_done <= 1'b0;
+        w_done  <= 1'b0;
+    end else begin
+        wr_cnt  <= n_wr_cnt;
+        wr_wait <= wr_gnt ? 1'b0 : wr_wait || wr_sent && WR_OUTSTANDING == 0;
+        aw_done <= wr_gnt ? 1'b0 : aw_ok;
+        w_done  <= wr_gnt ? 1'b0 : w_ok ;
+    end
+end
+
+//
+// Read line buffers
+// ------------------------------------------------------------
+
+wire [RD_LINES-1:0]     lines_hit   ; // Line holds requested address.
+wire [RD_LINES-1:0]     lines_rdy   ; // ... and requested beat arrived.
+wire [RD_LINES-1:0]     lines_next  ; // Line holds the next line.
+wire [RD_LINES-1:0]     lines_pend  ; // Line refill in progress.
+wire [RD_LINES-1:0]     lines_err   ; // Requested beat error.
+wire [RD_LINES*DW-1:0]  lines_data  ; // Requested beat data.
+
+reg  [  LINE_W-1:0]     lb_next     ; // Next line buffer to allocate.
+reg  [  LINE_W-1:0]     hit_idx     ; // Which line buffer was hit.
+
+integer l;
+always @(*) begin
+    hit_idx = {LINE_W{1'b0}};
+    for(l = 0; l < RD_LINES; l = l + 1) begin
+        if(lines_hit[l]) hit_idx = l;
+    end
+end
+
+wire                line_hit    = rd_burst && |lines_hit;
+wire                line_gnt    = rd_burst && |lines_rdy;
+
+wire                victim_free = !lines_pend[lb_next];
+
+//
+// Read request launching
+// ------------------------------------------------------------
+
+reg                 sr_pend     ; // Single beat read outstanding.
+
+wire                ar_free     = !axi_arvalid || axi_arready;
+
+// Requested line is not buffered. Refill it.
+wire                ar_demand   = rd_burst && !line_hit && victim_free;
+
+// Requested line is buffered. Prefetch the next one if absent.
+wire                ar_prefetch = RD_LINES > 1      && line_gnt         &&
+                                  !(|lines_next)    && victim_free      &&
+                                  lb_next != hit_idx                    ;
+
+wire                ar_single   = rd_single && !sr_pend;
+
+wire                ar_launch   = ar_free && wr_idle &&
+                                  (ar_demand || ar_prefetch || ar_single);
+
+wire                ar_alloc    = ar_launch && (ar_demand || ar_prefetch);
+
+wire [ TAG_W-1:0]   ar_tag      = ar_prefetch ? req_tag + 1 : req_tag;
+
+wire                single_gnt  = sr_pend && rsp_rd && axi_rid == SINGLE_ID;
+
+always @(posedge axi_aclk) begin
+    if(!axi_aresetn) begin
+        axi_arvalid <= 1'b0;
+        axi_arid    <= {ID_W{1'b0}};
+        axi_araddr  <= {AW{1'b0}};
+        axi_arlen   <= 8'd0;
+        axi_arprot  <= 3'b0;
+    end else if(ar_launch) begin
+        axi_arvalid <= 1'b1;
+        axi_arid    <= ar_single ? SINGLE_ID : lb_next;
+        axi_araddr  <= ar_single ? ccx_addr  : {ar_tag, {OFF_W{1'b0}}};
+        axi_arlen   <= ar_single ? 8'd0      : LINE_BEATS - 1;
+        //             Unprivilidged, Un-secured, Instruction / Data
+        axi_arprot  <= {1'b0        , 1'b0      , ccx_rtype};
+    end else if(axi_arready) begin
+        axi_arvalid <= 1'b0;
+    end
+end
+
+always @(posedge axi_aclk) begin
+    if(!axi_aresetn) begin
+        sr_pend <= 1'b0;
+        lb_next <= {LINE_W{1'b0}};
+    end else begin
+        sr_pend <= ar_launch && ar_single || sr_pend && !single_gnt;
+        if(ar_alloc) begin
+            lb_next <= lb_next == RD_LINES - 1 ? 0 : lb_next + 1;
+        end
+    end
+end
+
+//
+// Line buffer storage
+// ------------------------------------------------------------
+
+genvar i;
+generate for(i = 0; i < RD_LINES; i = i + 1) begin : gen_line
+
+    reg               valid ;
+    reg               pend  ;
+    reg  [ TAG_W-1:0] tag   ;
+    reg  [LINE_BEATS-1:0] beats;
+    reg  [LINE_BEATS-1:0] errs ;
+    reg  [BEAT_W-1:0] ptr   ;
+    reg  [    DW-1:0] data  [LINE_BEATS-1:0];
+
+    wire alloc = ar_alloc && lb_next == i;
+    wire fill  = rsp_rd   && axi_rid == i;
+    wire inval = wr_sent  && lines_hit[i];
+
+    assign lines_hit [i] = valid && tag == req_tag;
+    assign lines_rdy [i] = lines_hit[i] && beats[req_beat];
+    assign lines_next[i] = valid && tag == req_tag + 1;
+    assign lines_pend[i] = pend;
+    assign lines_err [i] = errs[req_beat];
+    assign lines_data[i*DW+:DW] = data[req_beat];
+
+    always @(posedge axi_aclk) begin
+        if(!axi_aresetn) begin
+            valid <= 1'b0;
+            pend  <= 1'b0;
+            beats <= {LINE_BEATS{1'b0}};
+            errs  <= {LINE_BEATS{1'b0}};
+            ptr   <= {BEAT_W{1'b0}};
+        end else if(alloc) begin
+            valid <= 1'b1;
+            pend  <= 1'b1;
+            tag   <= ar_tag;
+            beats <= {LINE_BEATS{1'b0}};
+            ptr   <= {BEAT_W{1'b0}};
+        end else begin
+            if(inval) begin
+                valid <= 1'b0;
+            end
+            if(fill) begin
+                beats[ptr] <= 1'b1;
+                errs [ptr] <= |axi_rresp;
+                ptr        <= ptr + 1;
+                pend       <= !axi_rlast;
+            end
+        end
+    end
+
+    always @(posedge axi_aclk) begin
+        if(fill) begin
+            data[ptr] <= axi_rdata;
+        end
+    end
+
+end endgenerate
+
+//
+// CCX Response signals
+// ------------------------------------------------------------
+
+assign ccx_gnt = line_gnt || single_gnt || wr_gnt;
+
+wire [DW-1:0] n_ccx_rdata = line_gnt ? lines_data[hit_idx*DW+:DW] : axi_rdata;
+
+wire          n_ccx_err   =
+    line_gnt                ? lines_err[hit_idx]    :
+    single_gnt              ? |axi_rresp            :
+    WR_OUTSTANDING == 0     ? |axi_bresp            :
+                              1'b0                  ;
+
+always @(posedge axi_aclk) begin
+    if(!axi_aresetn) begin
+        ccx_rdata <= {DW{1'b0}} ;
+        ccx_err   <= 1'b0       ;
+    end else if(ccx_gnt) begin
+        ccx_rdata <= n_ccx_rdata ;
+        ccx_err   <= n_ccx_err   ;
+    end
+end
+
+endmodule
+
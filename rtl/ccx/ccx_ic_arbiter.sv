@@ -6,11 +6,15 @@
 //
 //  Core complex interconnect arbiter.
 //  - Arbitrates two requestors onto a single a requestor.
-//  - Port 0 has priority.
+//  - Round robin: the requestor not granted most recently has priority.
+//    With ROUND_ROBIN=0, requestor 0 always has priority instead.
+//  - A request which has been presented but not yet granted keeps the
+//    port until it is granted, so the responder sees a stable request.
 //
 module ccx_ic_arbiter #(
 parameter   AW = 39,    // Address width
-parameter   DW = 64     // Data width
+parameter   DW = 64,    // Data width
+parameter   ROUND_ROBIN = 1 // Round robin, or fixed priority to req_0.
 )(
 
 input  wire      g_clk      ,
@@ -23,29 +27,41 @@ core_mem_bus.REQ rsp          // Responder
 
 );
 
-reg    inflight_r1  ;
-wire n_inflight_r1  = inflight_r1 ? req_1.req && !req_1.gnt               :
-                                    req_1.req && !req_1.gnt && !req_0.req ;
+reg    locked       ; // Last cycle's request was not granted.
+reg    locked_r1    ; // ... and it came from requestor 1.
+reg    prio_r1      ; // Requestor 1 has priority next.
 
-wire route_req_r0   = req_0.req && !inflight_r1;
-wire route_req_r1   = req_1.req && !req_0.req  ;
+wire   pick_r1      = !req_0.req || (ROUND_ROBIN && prio_r1);
+
+wire route_req_r1   = req_1.req && (locked ? locked_r1 : pick_r1);
+wire route_req_r0   = req_0.req && (locked ?!locked_r1 :!route_req_r1);
+
+wire n_locked       = rsp.req && !rsp.gnt;
+
+wire n_prio_r1      = route_req_r0 && rsp.gnt ? 1'b1    :
+                      route_req_r1 && rsp.gnt ? 1'b0    :
+                                                prio_r1 ;
 
 reg  route_rsp_0    ;
 reg  route_rsp_1    ;
 
 always @(posedge g_clk) begin
     if(!g_resetn) begin
-        inflight_r1  <= 1'b0;
+        locked       <= 1'b0;
+        locked_r1    <= 1'b0;
+        prio_r1      <= 1'b0;
         route_rsp_0  <= 1'b0;
         route_rsp_1  <= 1'b0;
     end else begin
-        inflight_r1  <= n_inflight_r1;
-        route_rsp_0  <= route_req_r0;
-        route_rsp_1  <= route_req_r1;
+        locked       <= n_locked;
+        locked_r1    <= route_req_r1;
+        prio_r1      <= n_prio_r1;
+        route_rsp_0  <= route_req_r0 && rsp.gnt;
+        route_rsp_1  <= route_req_r1 && rsp.gnt;
     end
 end
 
-assign rsp.req      = route_req_r0 ? req_0.req   : req_1.req   ;
+assign rsp.req      = route_req_r0 || route_req_r1            ;
 assign rsp.rtype    = route_req_r0 ? req_0.rtype : req_1.rtype ;
 assign rsp.addr     = route_req_r0 ? req_0.addr  : req_1.addr  ;
 assign rsp.wen      = route_req_r0 ? req_0.wen   : req_1.wen   ;
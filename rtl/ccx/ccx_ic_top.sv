@@ -5,6 +5,15 @@
 // module: ccx_ic_top
 //
 //  Core complex interconnect top.
+//  - A 2x4 crossbar between the core instruction/data ports and the
+//    ROM/RAM/EXT/MMIO targets.
+//  - Each core port has its own router, and each target has its own
+//    round-robin arbiter, so accesses from the two core ports to
+//    different targets proceed in the same cycle. ROUND_ROBIN=0 gives
+//    data accesses fixed priority instead, for comparison.
+//  - With RAM_DUAL_PORT set, the RAM has no arbiter. Data accesses go
+//    to if_ram and instruction fetches to if_ram_b, so they never
+//    conflict.
 //
 module ccx_ic_top #(
 parameter        AW = 39,    // Address width
@@ -16,7 +25,9 @@ parameter RAM_SIZE  = 39'h0000FFFF,
 parameter EXT_BASE  = 39'h10000000,
 parameter EXT_SIZE  = 39'h0FFFFFFF,
 parameter MMIO_BASE = 39'h00020000,
-parameter MMIO_SIZE = 39'h000000FF
+parameter MMIO_SIZE = 39'h000000FF,
+parameter RAM_DUAL_PORT = 0, // Give imem/dmem their own RAM ports.
+parameter ROUND_ROBIN   = 1  // Round robin arbiters, else data first.
 )(
 
 input  wire       g_clk     ,
@@ -26,7 +37,8 @@ core_mem_bus.RSP  if_imem   , // CPU instruction memory
 core_mem_bus.RSP  if_dmem   , // CPU data        memory
 
 core_mem_bus.REQ  if_rom    ,
-core_mem_bus.REQ  if_ram    ,
+core_mem_bus.REQ  if_ram    , // RAM port A / only RAM port.
+core_mem_bus.REQ  if_ram_b  , // RAM port B. Unused if !RAM_DUAL_PORT
 core_mem_bus.REQ  if_ext    ,
 core_mem_bus.REQ  if_mmio
 
@@ -101,7 +113,9 @@ ccx_ic_router #(
 
 //
 // ROM arbiter
-ccx_ic_arbiter i_ccx_ic_arbiter_rom (
+ccx_ic_arbiter #(
+.ROUND_ROBIN(ROUND_ROBIN)
+) i_ccx_ic_arbiter_rom (
 .g_clk      (g_clk      ),
 .g_resetn   (g_resetn   ),
 .req_0      (if_dmem_rom),
@@ -111,19 +125,59 @@ ccx_ic_arbiter i_ccx_ic_arbiter_rom (
 
 
 //
-// RAM arbiter
-ccx_ic_arbiter i_ccx_ic_arbiter_ram (
-.g_clk      (g_clk      ),
-.g_resetn   (g_resetn   ),
-.req_0      (if_dmem_ram),
-.req_1      (if_imem_ram),
-.rsp        (if_ram     )
-);
+// RAM arbiter, or direct connections to each RAM port.
+generate if(RAM_DUAL_PORT) begin : gen_ram_dual_port
+
+    assign if_ram.req         = if_dmem_ram.req   ;
+    assign if_ram.rtype       = if_dmem_ram.rtype ;
+    assign if_ram.addr        = if_dmem_ram.addr  ;
+    assign if_ram.wen         = if_dmem_ram.wen   ;
+    assign if_ram.strb        = if_dmem_ram.strb  ;
+    assign if_ram.wdata       = if_dmem_ram.wdata ;
+    assign if_ram.prv         = if_dmem_ram.prv   ;
+    assign if_dmem_ram.gnt    = if_ram.gnt        ;
+    assign if_dmem_ram.err    = if_ram.err        ;
+    assign if_dmem_ram.rdata  = if_ram.rdata      ;
+
+    assign if_ram_b.req       = if_imem_ram.req   ;
+    assign if_ram_b.rtype     = if_imem_ram.rtype ;
+    assign if_ram_b.addr      = if_imem_ram.addr  ;
+    assign if_ram_b.wen       = if_imem_ram.wen   ;
+    assign if_ram_b.strb      = if_imem_ram.strb  ;
+    assign if_ram_b.wdata     = if_imem_ram.wdata ;
+    assign if_ram_b.prv       = if_imem_ram.prv   ;
+    assign if_imem_ram.gnt    = if_ram_b.gnt      ;
+    assign if_imem_ram.err    = if_ram_b.err      ;
+    assign if_imem_ram.rdata  = if_ram_b.rdata    ;
+
+end else begin : gen_ram_single_port
+
+    ccx_ic_arbiter #(
+    .ROUND_ROBIN(ROUND_ROBIN)
+    ) i_ccx_ic_arbiter_ram (
+    .g_clk      (g_clk      ),
+    .g_resetn   (g_resetn   ),
+    .req_0      (if_dmem_ram),
+    .req_1      (if_imem_ram),
+    .rsp        (if_ram     )
+    );
+
+    assign if_ram_b.req       = 1'b0;
+    assign if_ram_b.rtype     = 1'b0;
+    assign if_ram_b.addr      = {AW{1'b0}};
+    assign if_ram_b.wen       = 1'b0;
+    assign if_ram_b.strb      = {DW/8{1'b0}};
+    assign if_ram_b.wdata     = {DW{1'b0}};
+    assign if_ram_b.prv       = 2'b0;
+
+end endgenerate
 
 
 //
 // EXT arbiter
-ccx_ic_arbiter i_ccx_ic_arbiter_ext (
+ccx_ic_arbiter #(
+.ROUND_ROBIN(ROUND_ROBIN)
+) i_ccx_ic_arbiter_ext (
 .g_clk      (g_clk      ),
 .g_resetn   (g_resetn   ),
 .req_0      (if_dmem_ext),
@@ -132,8 +186,10 @@ ccx_ic_arbiter i_ccx_ic_arbiter_ext (
 );
 
 //
-// ROM arbiter
-ccx_ic_arbiter i_ccx_ic_arbiter_mmio(
+// MMIO arbiter
+ccx_ic_arbiter #(
+.ROUND_ROBIN(ROUND_ROBIN)
+) i_ccx_ic_arbiter_mmio(
 .g_clk      (g_clk       ),
 .g_resetn   (g_resetn    ),
 .req_0      (if_dmem_mmio),
@@ -9,6 +9,33 @@ parameter PC_RESET_ADDRESS  = 39'h00000000,
 // Use a FPGA-inference-friendly implementation of the register file.
 parameter FPGA_REGFILE      = 0,
 
+// Issue pairs of simple ALU instructions in the same cycle.
+parameter CORE_DUAL_ISSUE   = 0,
+
+// Multiplier implementation. 0=iterative, 1=pipelined, 2=FPGA DSP.
+parameter CORE_MUL_IMPL     = 0,
+
+// Iterative / carry-less multiplier bits per cycle.
+parameter CORE_MUL_UNROLL   = 4,
+parameter CORE_CLMUL_UNROLL = 8,
+
+// Divider quotient bits per cycle (1 or 2), and dead iteration skipping.
+parameter CORE_DIV_UNROLL   = 1,
+parameter CORE_DIV_NORMALISE= 1,
+
+// Crypto datapath. 0=area, 1=fast, 2=fast with shared AES/SM4 sboxes.
+parameter CORE_CRYPTO_IMPL  = 0,
+
+// Split misaligned loads/stores into aligned beats, rather than trap.
+parameter CORE_MISALIGNED_HW= 0,
+
+// Fetch buffer size in bits (128, 256 or 512) and prefetch enable.
+parameter CORE_FETCH_BUFFER_DEPTH = 128,
+parameter CORE_FETCH_PREFETCH     = 0,
+
+// Number of implemented mhpmcounter/mhpmevent pairs, from 0 to 29.
+parameter CORE_HPM_COUNTERS = 4,
+
 // Base address of the memory mapped IO region.
 parameter MMIO_BASE         = 39'h0000_0000_0002_0000,
 parameter MMIO_SIZE         = 39'h0000_0000_0000_00FF,
@@ -24,6 +51,18 @@ parameter EXT_BASE          = 39'h10000000,
 parameter EXT_SIZE          = 39'h0FFFFFFF,
 parameter CLK_GATE_EN       = 1'b1, // Enable core-level clock gating
 
+// Use a dual-port RAM, with instruction fetches and data accesses on
+// separate ports, so they never stall each other.
+parameter RAM_DUAL_PORT     = 0,
+
+// Round-robin arbitration between the core instruction and data ports at
+// each interconnect target. 0 gives data accesses fixed priority.
+parameter IC_ROUND_ROBIN    = 1,
+
+// Simulation only. Keep the ROM and RAM contents in the testbench, reached
+// through DPI, rather than in the RTL. ROM_MEMH and RAM_MEMH are ignored.
+parameter MEM_DPI           = 0,
+
 parameter CORE_ARCH_ZK      = 1, // Turn on entire crypto extension
 parameter CORE_ARCH_ZKB     = 1, // Turn on Bitmanip-borrowed crypto instructions
 parameter CORE_ARCH_ZKG     = 1, // Turn on CLMUL/CLMULH
@@ -33,7 +72,10 @@ parameter CORE_ARCH_ZKND    = 1, // Turn on NIST AES decrypt
 parameter CORE_ARCH_ZKNH    = 1, // Turn on NIST SHA2 instructions
 parameter CORE_ARCH_ZKS     = 1, // Turn on ShangMi suite crypto instructions
 parameter CORE_ARCH_ZKSED   = 1, // Turn on ShangMi SM4 instructions
-parameter CORE_ARCH_ZKSH    = 1  // Turn on ShangMi SM3 instructions
+parameter CORE_ARCH_ZKSH    = 1, // Turn on ShangMi SM3 instructions
+parameter CORE_ARCH_ZBA     = 1, // Turn on Zba address generation instructions
+parameter CORE_ARCH_ZBB     = 1, // Turn on Zbb basic bit-manipulation instructions
+parameter CORE_ARCH_ZBS     = 1  // Turn on Zbs single-bit instructions
 
 )(
 
@@ -112,6 +154,7 @@ core_mem_bus #() core_dmem ();
 //
 // RAM and ROM interfaces
 core_mem_bus #() if_ram    ();
+core_mem_bus #() if_ram_b  ();
 core_mem_bus #() if_rom    ();
 core_mem_bus #() if_mmio   ();
 
@@ -119,6 +162,7 @@ core_mem_bus #() if_mmio   ();
 // Core timer & counter related wires.
 wire                 core_int_ti       ; // Timer interrupt.
 wire                 core_instr_ret    ; // Instruction retired;
+wire                 core_instr_ret_b  ; // Second lane instr retired.
         
 wire [         63:0] core_ctr_time     ; // The time counter value.
 wire [         63:0] core_ctr_cycle    ; // The cycle counter value.
@@ -141,6 +185,17 @@ wire                 core_inhibit_ir   ; // Stop instret incrementing.
 core_top #(
 .PC_RESET_ADDRESS   (PC_RESET_ADDRESS),
 .FPGA_REGFILE       (FPGA_REGFILE    ),
+.DUAL_ISSUE         (CORE_DUAL_ISSUE ),
+.MUL_IMPL           (CORE_MUL_IMPL   ),
+.MUL_UNROLL         (CORE_MUL_UNROLL ),
+.CLMUL_UNROLL       (CORE_CLMUL_UNROLL),
+.DIV_UNROLL         (CORE_DIV_UNROLL ),
+.DIV_NORMALISE      (CORE_DIV_NORMALISE),
+.CRYPTO_IMPL        (CORE_CRYPTO_IMPL),
+.MISALIGNED_HW      (CORE_MISALIGNED_HW),
+.FETCH_BUFFER_DEPTH (CORE_FETCH_BUFFER_DEPTH),
+.FETCH_PREFETCH     (CORE_FETCH_PREFETCH    ),
+.HPM_COUNTERS       (CORE_HPM_COUNTERS      ),
 .CLK_GATE_EN        (CLK_GATE_EN     ),
 .ARCH_ZK   (CORE_ARCH_ZK   ), // Turn on entire crypto extension
 .ARCH_ZKB  (CORE_ARCH_ZKB  ), // Turn on Bitmanip-borrowed crypto instructions
@@ -151,7 +206,10 @@ core_top #(
 .ARCH_ZKNH (CORE_ARCH_ZKNH ), // Turn on NIST SHA2 instructions
 .ARCH_ZKS  (CORE_ARCH_ZKS  ), // Turn on ShangMi suite crypto instructions
 .ARCH_ZKSED(CORE_ARCH_ZKSED), // Turn on ShangMi SM4 instructions
-.ARCH_ZKSH (CORE_ARCH_ZKSH )  // Turn on ShangMi SM3 instructions
+.ARCH_ZKSH (CORE_ARCH_ZKSH ), // Turn on ShangMi SM3 instructions
+.ARCH_ZBA  (CORE_ARCH_ZBA  ), // Turn on Zba address generation instructions
+.ARCH_ZBB  (CORE_ARCH_ZBB  ), // Turn on Zbb basic bit-manipulation instructions
+.ARCH_ZBS  (CORE_ARCH_ZBS  )  // Turn on Zbs single-bit instructions
 ) i_core_top (
 .f_clk        (f_clk             ), // global free running clock
 .g_clk_test_en(g_clk_test_en     ), // Gated clock test enable.
@@ -181,6 +239,7 @@ core_top #(
 .dmem_rdata   (core_dmem.rdata   ), // Memory response read data
 .wfi_sleep    (wfi_sleep         ), // Core asleep due to WFI
 .instr_ret    (core_instr_ret    ), // Instruction retired;
+.instr_ret_b  (core_instr_ret_b  ), // Second lane instr retired.
 .ctr_time     (core_ctr_time     ), // The time counter value.
 .ctr_cycle    (core_ctr_cycle    ), // The cycle counter value.
 .ctr_instret  (core_ctr_instret  ), // The instret counter value.
@@ -208,7 +267,9 @@ ccx_ic_top #(
 .EXT_BASE (EXT_BASE  ),
 .EXT_SIZE (EXT_SIZE  ),
 .MMIO_BASE(MMIO_BASE ),
-.MMIO_SIZE(MMIO_SIZE )
+.MMIO_SIZE(MMIO_SIZE ),
+.RAM_DUAL_PORT(RAM_DUAL_PORT),
+.ROUND_ROBIN  (IC_ROUND_ROBIN)
 ) i_ccx_ic_top (
 .g_clk     (g_clk           ),
 .g_resetn  (g_resetn        ),
@@ -216,6 +277,7 @@ ccx_ic_top #(
 .if_dmem   (core_dmem       ), // cpu data        memory
 .if_rom    (if_rom          ),
 .if_ram    (if_ram          ),
+.if_ram_b  (if_ram_b        ),
 .if_ext    (if_ext          ),
 .if_mmio   (if_mmio         )
 );
@@ -238,6 +300,7 @@ core_counters #(
 .g_resetn        (g_resetn        ), // synchronous reset
 .timer_interrupt (core_int_ti     ), // Timer interrupt
 .instr_ret       (core_instr_ret  ), // Instruction retired;
+.instr_ret_b     (core_instr_ret_b), // Second lane instr retired.
 .ctr_time        (core_ctr_time   ), // The time counter value.
 .ctr_cycle       (core_ctr_cycle  ), // The cycle counter value.
 .ctr_instret     (core_ctr_instret), // The instret counter value.
@@ -258,6 +321,62 @@ core_counters #(
 // Memories
 // ------------------------------------------------------------
 
+assign if_rom.gnt = 1'b1;
+wire   [7:0] rom_wstrb = if_rom.wen ? if_rom.strb : 8'b0;
+
+
+wire   [7:0] ram_wstrb   = if_ram.wen   ? if_ram.strb   : 8'b0;
+wire   [7:0] ram_b_wstrb = if_ram_b.wen ? if_ram_b.strb : 8'b0;
+
+assign if_ram.gnt   = 1'b1;
+assign if_ram_b.gnt = 1'b1;
+
+generate if(MEM_DPI) begin : gen_mem_dpi
+
+mem_dpi_wxd #(
+.ROM   (        1),
+.DEPTH (ROM_DEPTH),
+.BASE  (64'(ROM_BASE))
+) i_rom (
+.g_clk       (g_clk             ),
+.g_resetn    (g_resetn          ),
+.a_cen       (if_rom.req        ),
+.a_wstrb     (rom_wstrb         ),
+.a_addr      (if_rom.addr[3+:1+ROMAW] ),
+.a_wdata     (if_rom.wdata      ),
+.a_rdata     (if_rom.rdata      ),
+.a_err       (if_rom.err        ),
+.b_cen       (1'b0              ),
+.b_wstrb     (8'b0              ),
+.b_addr      ({1+ROMAW{1'b0}}   ),
+.b_wdata     (64'b0             ),
+.b_rdata     (                  ),
+.b_err       (                  )
+);
+
+mem_dpi_wxd #(
+.ROM   (        0),
+.DEPTH (RAM_DEPTH),
+.BASE  (64'(RAM_BASE))
+) i_ram (
+.g_clk       (g_clk             ),
+.g_resetn    (g_resetn          ),
+.a_cen       (if_ram.req        ),
+.a_wstrb     (ram_wstrb         ),
+.a_addr      (if_ram.addr[3+:1+RAMAW] ),
+.a_wdata     (if_ram.wdata      ),
+.a_rdata     (if_ram.rdata      ),
+.a_err       (if_ram.err        ),
+.b_cen       (RAM_DUAL_PORT && if_ram_b.req),
+.b_wstrb     (ram_b_wstrb       ),
+.b_addr      (if_ram_b.addr[3+:1+RAMAW] ),
+.b_wdata     (if_ram_b.wdata    ),
+.b_rdata     (if_ram_b.rdata    ),
+.b_err       (if_ram_b.err      )
+);
+
+end else begin : gen_mem_sram
+
 mem_sram_wxd #(
 .WIDTH (ROM_WIDTH),
 .ROM   (        1),
@@ -274,9 +393,30 @@ mem_sram_wxd #(
 .err         (if_rom.err        )
 );
 
-assign if_rom.gnt = 1'b1;
-wire   [7:0] rom_wstrb = if_rom.wen ? if_rom.strb : 8'b0;
+if(RAM_DUAL_PORT) begin : gen_ram_dual_port
 
+mem_sram_dp_wxd #(
+.WIDTH (RAM_WIDTH),
+.DEPTH (RAM_DEPTH),
+.MEMH  (RAM_MEMH ) 
+) i_ram (
+.g_clk       (g_clk             ),
+.g_resetn    (g_resetn          ),
+.a_cen       (if_ram.req        ),
+.a_wstrb     (ram_wstrb         ),
+.a_addr      (if_ram.addr[3+:1+RAMAW] ),
+.a_wdata     (if_ram.wdata      ),
+.a_rdata     (if_ram.rdata      ),
+.a_err       (if_ram.err        ),
+.b_cen       (if_ram_b.req      ),
+.b_wstrb     (ram_b_wstrb       ),
+.b_addr      (if_ram_b.addr[3+:1+RAMAW] ),
+.b_wdata     (if_ram_b.wdata    ),
+.b_rdata     (if_ram_b.rdata    ),
+.b_err       (if_ram_b.err      )
+);
+
+end else begin : gen_ram_single_port
 
 mem_sram_wxd #(
 .WIDTH (RAM_WIDTH),
@@ -294,8 +434,12 @@ mem_sram_wxd #(
 .err         (if_ram.err        )
 );
 
-assign if_ram.gnt = 1'b1;
-wire   [7:0] ram_wstrb = if_ram.wen ? if_ram.strb : 8'b0;
+assign if_ram_b.rdata = {DW{1'b0}};
+assign if_ram_b.err   = 1'b0;
+
+end
+
+end endgenerate
 
 endmodule
 
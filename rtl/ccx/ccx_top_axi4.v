@@ -0,0 +1,200 @@
+
+//
+// module: ccx_top_axi4
+//
+//  The core complex, with its external memory port bridged onto
+//  an AXI4 master interface by bridge_ccx_axi4.
+//
+module ccx_top_axi4 #(
+// Inital address of the program counter post reset.
+parameter PC_RESET_ADDRESS  = 39'h00000000,
+
+// Use a FPGA-inference-friendly implementation of the register file.
+parameter FPGA_REGFILE      = 0,
+
+// Base address of the memory mapped IO region.
+parameter MMIO_BASE         = 39'h0000_0000_0002_0000,
+parameter MMIO_SIZE         = 39'h0000_0000_0000_00FF,
+
+parameter ROM_MEMH          = "none",
+parameter RAM_MEMH          = "none",
+
+parameter ROM_BASE          = 39'h00000000,
+parameter ROM_SIZE          = 39'h000003FF,
+parameter RAM_BASE          = 39'h00010000,
+parameter RAM_SIZE          = 39'h0000FFFF,
+parameter EXT_BASE          = 39'h10000000,
+parameter EXT_SIZE          = 39'h0FFFFFFF,
+parameter CLK_GATE_EN       = 1'b1, // Enable core-level clock gating
+parameter RAM_DUAL_PORT     = 0,    // Separate imem/dmem RAM ports.
+parameter MEM_DPI           = 0,    // Simulation only. ROM/RAM via DPI.
+
+// AXI4 bridge configuration. See bridge_ccx_axi4.
+parameter AXI_RD_LINES      = 2, // Line buffers / outstanding bursts.
+parameter AXI_LINE_BEATS    = 4, // Beats per line refill burst.
+parameter AXI_RD_BURST_DATA = 0, // Serve data reads from line buffers too.
+parameter AXI_WR_OUTSTANDING= 4, // Max posted writes. 0 = not posted.
+parameter AXI_ID_W          = 2  // AXI ID width.
+) (
+
+input  wire         f_clk        , // Global free-running clock.
+input  wire         g_resetn     , // Synchronous negative level reset.
+input  wire         g_clk_test_en, // Clock test enable.
+
+input  wire         int_sw       , // External interrupt
+input  wire         int_ext      , // Software interrupt
+
+output wire                 axi_awvalid , //
+input  wire                 axi_awready , //
+output wire [ AXI_ID_W-1:0] axi_awid    , //
+output wire [         38:0] axi_awaddr  , //
+output wire [          7:0] axi_awlen   , //
+output wire [          2:0] axi_awsize  , //
+output wire [          1:0] axi_awburst , //
+output wire [          3:0] axi_awcache , //
+output wire [          2:0] axi_awprot  , //
+
+output wire                 axi_wvalid  , //
+input  wire                 axi_wready  , //
+output wire [         63:0] axi_wdata   , //
+output wire [          7:0] axi_wstrb   , //
+output wire                 axi_wlast   , //
+
+input  wire                 axi_bvalid  , //
+output wire                 axi_bready  , //
+input  wire [ AXI_ID_W-1:0] axi_bid     , //
+input  wire [          1:0] axi_bresp   , //
+
+output wire                 axi_arvalid , //
+input  wire                 axi_arready , //
+output wire [ AXI_ID_W-1:0] axi_arid    , //
+output wire [         38:0] axi_araddr  , //
+output wire [          7:0] axi_arlen   , //
+output wire [          2:0] axi_arsize  , //
+output wire [          1:0] axi_arburst , //
+output wire [          3:0] axi_arcache , //
+output wire [          2:0] axi_arprot  , //
+
+input  wire                 axi_rvalid  , //
+output wire                 axi_rready  , //
+input  wire [ AXI_ID_W-1:0] axi_rid     , //
+input  wire [         63:0] axi_rdata   , //
+input  wire [          1:0] axi_rresp   , //
+input  wire                 axi_rlast   , //
+
+output wire         axi_wr_err   , // Posted write got an error response.
+
+output wire         wfi_sleep    , // Core is asleep due to WFI.
+
+output wire         trs_valid    , // Instruction trace valid
+output wire [ 31:0] trs_instr    , // Instruction trace data
+output wire [ 63:0] trs_pc         // Instruction trace PC
+
+);
+
+wire         emem_req     ; // Memory request
+wire         emem_rtype   ; // Memory request type.
+wire [ 38:0] emem_addr    ; // Memory request address
+wire         emem_wen     ; // Memory request write enable
+wire [  7:0] emem_strb    ; // Memory request write strobe
+wire [ 63:0] emem_wdata   ; // Memory write data.
+wire [  1:0] emem_prv     ; // Memory Privilidge level.
+wire         emem_gnt     ; // Memory response valid
+wire         emem_err     ; // Memory response error
+wire [ 63:0] emem_rdata   ; // Memory response read data
+
+ccx_top #(
+.PC_RESET_ADDRESS(PC_RESET_ADDRESS),
+.FPGA_REGFILE    (FPGA_REGFILE    ),
+.MMIO_BASE       (MMIO_BASE       ),
+.MMIO_SIZE       (MMIO_SIZE       ),
+.ROM_MEMH        (ROM_MEMH        ),
+.ROM_BASE        (ROM_BASE        ),
+.ROM_SIZE        (ROM_SIZE        ),
+.RAM_MEMH        (RAM_MEMH        ),
+.RAM_BASE        (RAM_BASE        ),
+.RAM_SIZE        (RAM_SIZE        ),
+.EXT_BASE        (EXT_BASE        ),
+.EXT_SIZE        (EXT_SIZE        ),
+.CLK_GATE_EN     (CLK_GATE_EN     ),
+.RAM_DUAL_PORT   (RAM_DUAL_PORT   ),
+.MEM_DPI         (MEM_DPI         )
+) i_ccx_top (
+.f_clk        (f_clk        ), // Global free-running clock.
+.g_resetn     (g_resetn     ), // Synchronous negative level reset.
+.g_clk_test_en(g_clk_test_en), // Clock test enable.
+.int_sw       (int_sw       ), // External interrupt
+.int_ext      (int_ext      ), // Software interrupt
+.emem_req     (emem_req     ), // Memory request
+.emem_rtype   (emem_rtype   ), // Memory request type.
+.emem_addr    (emem_addr    ), // Memory request address
+.emem_wen     (emem_wen     ), // Memory request write enable
+.emem_strb    (emem_strb    ), // Memory request write strobe
+.emem_wdata   (emem_wdata   ), // Memory write data.
+.emem_prv     (emem_prv     ), // Memory privilidge level.
+.emem_gnt     (emem_gnt     ), // Memory response valid
+.emem_err     (emem_err     ), // Memory response error
+.emem_rdata   (emem_rdata   ), // Memory response read data
+.wfi_sleep    (wfi_sleep    ), // Core is asleep due to WFI.
+.trs_valid    (trs_valid    ), // Instruction trace valid
+.trs_instr    (trs_instr    ), // Instruction trace data
+.trs_pc       (trs_pc       )  // Instruction trace PC
+);
+
+bridge_ccx_axi4 #(
+.AW            (39                ),
+.DW            (64                ),
+.RD_LINES      (AXI_RD_LINES      ),
+.LINE_BEATS    (AXI_LINE_BEATS    ),
+.RD_BURST_DATA (AXI_RD_BURST_DATA ),
+.WR_OUTSTANDING(AXI_WR_OUTSTANDING),
+.ID_W          (AXI_ID_W          )
+) i_bridge_ccx_axi4 (
+.axi_aclk    (f_clk       ), // AXI Clock
+.axi_aresetn (g_resetn    ), // AXI Reset
+.axi_awvalid (axi_awvalid ),
+.axi_awready (axi_awready ),
+.axi_awid    (axi_awid    ),
+.axi_awaddr  (axi_awaddr  ),
+.axi_awlen   (axi_awlen   ),
+.axi_awsize  (axi_awsize  ),
+.axi_awburst (axi_awburst ),
+.axi_awcache (axi_awcache ),
+.axi_awprot  (axi_awprot  ),
+.axi_wvalid  (axi_wvalid  ),
+.axi_wready  (axi_wready  ),
+.axi_wdata   (axi_wdata   ),
+.axi_wstrb   (axi_wstrb   ),
+.axi_wlast   (axi_wlast   ),
+.axi_bvalid  (axi_bvalid  ),
+.axi_bready  (axi_bready  ),
+.axi_bid     (axi_bid     ),
+.axi_bresp   (axi_bresp   ),
+.axi_arvalid (axi_arvalid ),
+.axi_arready (axi_arready ),
+.axi_arid    (axi_arid    ),
+.axi_araddr  (axi_araddr  ),
+.axi_arlen   (axi_arlen   ),
+.axi_arsize  (axi_arsize  ),
+.axi_arburst (axi_arburst ),
+.axi_arcache (axi_arcache ),
+.axi_arprot  (axi_arprot  ),
+.axi_rvalid  (axi_rvalid  ),
+.axi_rready  (axi_rready  ),
+.axi_rid     (axi_rid     ),
+.axi_rdata   (axi_rdata   ),
+.axi_rresp   (axi_rresp   ),
+.axi_rlast   (axi_rlast   ),
+.ccx_req     (emem_req    ), // Memory request
+.ccx_rtype   (emem_rtype  ), // Request type.
+.ccx_addr    (emem_addr   ), // Memory request address
+.ccx_wen     (emem_wen    ), // Memory request write enable
+.ccx_strb    (emem_strb   ), // Memory request write strobe
+.ccx_wdata   (emem_wdata  ), // Memory write data.
+.ccx_gnt     (emem_gnt    ), // Memory response valid
+.ccx_err     (emem_err    ), // Memory response error
+.ccx_rdata   (emem_rdata  ), // Memory response read data
+.wr_err      (axi_wr_err  )  // Posted write got an error response.
+);
+
+endmodule
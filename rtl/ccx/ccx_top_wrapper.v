@@ -26,7 +26,8 @@ parameter RAM_BASE          = 39'h0001_0000,
 parameter RAM_SIZE          = 39'h0000_FFFF,
 parameter EXT_BASE          = 39'h0010_0000,
 parameter EXT_SIZE          = 39'h000F_FFFF,
-parameter CLK_GATE_EN       = 1'b1  // Enable core-level clock gating
+parameter CLK_GATE_EN       = 1'b1, // Enable core-level clock gating
+parameter RAM_DUAL_PORT     = 0     // Separate imem/dmem RAM ports.
 ) (
 
 input  wire         f_clk        , // Global free-running clock.
@@ -68,7 +69,8 @@ ccx_top #(
 .RAM_SIZE        (RAM_SIZE        ),
 .EXT_BASE        (EXT_BASE        ),
 .EXT_SIZE        (EXT_SIZE        ),
-.CLK_GATE_EN     (CLK_GATE_EN     )
+.CLK_GATE_EN     (CLK_GATE_EN     ),
+.RAM_DUAL_PORT   (RAM_DUAL_PORT   )
 ) i_ccx_top (
 .f_clk        (f_clk        ), // Global free-running clock.
 .g_resetn     (g_resetn     ), // Synchronous negative level reset.
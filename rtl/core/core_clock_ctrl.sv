@@ -23,6 +23,12 @@ output wire g_clk_mul         // Multiplier gated clock
 
 parameter CLK_GATE_EN      = 1'b1; // Enable core-level clock gating
 
+//
+// Which gated clocks tick on the next f_clk edge: {mul, rf, core}. Only
+// read by the simulation testbench, to measure clock gating activity.
+wire [2:0] clk_en /*verilator public_flat_rd*/ = !CLK_GATE_EN ? 3'b111 :
+    {g_clk_mul_req, g_clk_rf_req, g_clk_req} | {3{g_clk_test_en}};
+
 generate if (CLK_GATE_EN == 1'b0) begin : clk_gating_disabled
 
 assign  g_clk       = f_clk;
@@ -11,10 +11,11 @@ input                      g_clk            , // global clock
 input                      g_resetn         , // synchronous reset
 
 input                      instr_ret        , // Instruction retired.
+input                      instr_ret_b      , // Second lane instr retired.
 output reg                 timer_interrupt  , // Raise a timer interrupt
 
 output wire [        63:0] ctr_time         , // The time counter value.
-output reg  [        63:0] ctr_cycle        , // The cycle counter value.
+output reg  [        63:0] ctr_cycle /*verilator public_flat_rw*/, // The cycle counter value.
 output reg  [        63:0] ctr_instret      , // The instret counter value.
 
 input  wire                inhibit_cy       , // Stop cycle counter incrementing.
@@ -61,8 +62,9 @@ wire    addr_mtime_lo    =
 wire    addr_mtimecmp_lo =
     (mmio_addr& MMIO_SIZE)==(MMIO_MTIMECMP_ADDR & MMIO_SIZE);
 
-reg  [63:0] mapped_mtime;
-reg  [63:0] mapped_mtimecmp;
+// The Verilator testbench reads and writes these to skip idle WFI cycles.
+reg  [63:0] mapped_mtime    /*verilator public_flat_rw*/;
+reg  [63:0] mapped_mtimecmp /*verilator public_flat_rd*/;
 
 wire [63:0] n_mapped_mtime = mapped_mtime + 1;
 
@@ -141,16 +143,21 @@ assign ctr_time = mapped_mtime;
 // instret register
 //
 
-wire [63:0] n_ctr_instret = ctr_instret + 1;
-
 // Register inserted to break up long timing path to instret register
 // load enable bit.
 reg     instr_ret_r;
+reg     instr_ret_b_r;
 
 always @(posedge g_clk) begin
-    instr_ret_r <= instr_ret;
+    instr_ret_r   <= instr_ret;
+    instr_ret_b_r <= instr_ret_b;
 end
 
+// With dual issue, two instructions may retire in the same cycle.
+wire [ 1:0] instret_incr  = instr_ret_b_r ? 2'd2 : 2'd1;
+
+wire [63:0] n_ctr_instret = ctr_instret + {62'b0, instret_incr};
+
 always @(posedge g_clk) begin
     if(!g_resetn) begin
 
@@ -51,6 +51,8 @@ output wire        inhibit_cy       , // Stop cycle counter incrementing.
 output wire        inhibit_tm       , // Stop time counter incrementing.
 output wire        inhibit_ir       , // Stop instret incrementing.
 
+input  wire [HPM_EVENTS_R:0] hpm_events, // Performance monitor events.
+
 input  wire        trap_cpu         , // A trap occured due to CPU
 input  wire        trap_int         , // A trap occured due to interrupt
 input  wire [CF_CAUSE_R:0] trap_cause, // A trap occured due to interrupt
@@ -75,6 +77,10 @@ localparam ADDR_MINSTRET    = 12'hB02;
 
 localparam ADDR_MCOUNTIN    = 12'h320;
 
+localparam ADDR_HPMCOUNTER3 = 12'hC03;
+localparam ADDR_MHPMCOUNTER3= 12'hB03;
+localparam ADDR_MHPMEVENT3  = 12'h323;
+
 localparam ADDR_MSTATUS     = 12'h300;
 localparam ADDR_MISA        = 12'h301;
 localparam ADDR_MEDELEG     = 12'h302;
@@ -120,6 +126,12 @@ wire [XL:0] reg_marchid         = MARCHID;
 wire [XL:0] reg_mimpid          = MIMPID;
 wire [XL:0] reg_mhartid         = MHARTID;
 
+// Number of implemented mhpmcounter/mhpmevent pairs, from 0 to 29.
+parameter   HPM_COUNTERS        = 4;
+
+localparam  HPM_LAST            = 3 + HPM_COUNTERS - 1;
+localparam  [31:0] HPM_MASK     = ((64'b1 << HPM_COUNTERS) - 1) << 3;
+
 wire [XL:0] reg_medeleg         = 64'b0;
 wire [XL:0] reg_mideleg         = 64'b0;
 
@@ -369,8 +381,8 @@ parameter  MTVEC_MODE_RESET     = 2'b00;
 // Alignment required when writing mtvec.base with mtvec.mode = vectored.
 parameter  MTVEC_VECT_BASE_MASK = 64'hFFFF_FFFF_FFFF_FF80;
 
-reg  [XL-2:0] reg_mtvec_base  ;
-reg  [   1:0] reg_mtvec_mode  ;
+reg  [XL-2:0] reg_mtvec_base  /*verilator public_flat_rd*/;
+reg  [   1:0] reg_mtvec_mode  /*verilator public_flat_rd*/;
 
 
 wire [XL:0] reg_mtvec       = {
@@ -441,7 +453,7 @@ end
 // CSR: MTVAL
 // -------------------------------------------------------------------------
 
-reg  [XL:0] reg_mtval   ;
+reg  [XL:0] reg_mtval   /*verilator public_flat_rd*/;
 wire [XL:0] n_reg_mtval =
     trap_cpu? trap_mtval            :
     csr_wr_set ? reg_mtval |  csr_wdata:
@@ -463,7 +475,7 @@ end
 // CSR: MEPC
 // -------------------------------------------------------------------------
 
-reg  [XL-1:0] reg_mepc_mepc;
+reg  [XL-1:0] reg_mepc_mepc /*verilator public_flat_rd*/;
 wire        reg_mepc_warl = 1'b0;
 
 wire [XL:0] reg_mepc = {
@@ -499,8 +511,8 @@ end
 // MCAUSE
 // -------------------------------------------------------------------------
 
-reg           reg_mcause_interrupt ;// Interrupts not implemented.
-reg  [XL-1:0] reg_mcause_cause     ;
+reg           reg_mcause_interrupt /*verilator public_flat_rd*/;
+reg  [XL-1:0] reg_mcause_cause     /*verilator public_flat_rd*/;
 
 wire [XL:0] reg_mcause = {
     reg_mcause_interrupt,
@@ -547,6 +559,7 @@ end
 reg mcountin_ir;
 reg mcountin_tm = 1'b0;
 reg mcountin_cy;
+reg [31:3] mcountin_hpm;
 
 assign inhibit_ir = mcountin_ir;
 assign inhibit_cy = mcountin_cy;
@@ -558,20 +571,106 @@ always @(posedge g_clk) begin
     if(!g_resetn) begin
         mcountin_ir <= 1'b0;
         mcountin_cy <= 1'b0;
+        mcountin_hpm<= 29'b0;
     end else if(wen_mcountin) begin
         mcountin_ir <= csr_wdata[2];
         mcountin_cy <= csr_wdata[0];
+        mcountin_hpm<= csr_wdata[31:3] & HPM_MASK[31:3];
     end
 end
 
 wire [XL:0] reg_mcountin = {
-    61'b0, 
+    32'b0, 
+    mcountin_hpm,
     mcountin_ir,
     mcountin_tm,
     mcountin_cy
 };
 
 
+//
+// CSR: MHPMCOUNTER3..31 / MHPMEVENT3..31
+//
+//  Only the first HPM_COUNTERS counters are implemented, the rest read
+//  as zero and ignore writes. Each mhpmevent register is a mask of
+//  HPM_EV_* event bits. Its counter increments on every cycle where any
+//  selected event is active, unless inhibited by mcountinhibit.
+// -------------------------------------------------------------------------
+
+wire [ 4:0] hpm_idx             = csr_addr[4:0];
+wire        hpm_idx_valid       = hpm_idx >= 5'd3;
+
+wire        addr_mhpmcounter    = csr_addr[11:5] == ADDR_MHPMCOUNTER3[11:5];
+wire        addr_mhpmevent      = csr_addr[11:5] == ADDR_MHPMEVENT3  [11:5];
+wire        addr_hpmcounter     = csr_addr[11:5] == ADDR_HPMCOUNTER3 [11:5];
+
+wire        wen_mhpmcounter     = mode_m && csr_wr && addr_mhpmcounter;
+wire        wen_mhpmevent       = mode_m && csr_wr && addr_mhpmevent  ;
+
+// All counter / event values, indexed by the low 5 bits of the address.
+wire [64*32-1:0]           hpm_ctr_all;
+wire [HPM_EVENTS_W*32-1:0] hpm_evt_all;
+
+genvar hpm_i;
+generate for(hpm_i = 0; hpm_i < 32; hpm_i = hpm_i + 1) begin : gen_hpm
+
+    if(hpm_i >= 3 && hpm_i <= HPM_LAST) begin : gen_impl
+
+        reg  [          XL:0] ctr;
+        reg  [HPM_EVENTS_R:0] evt;
+
+        wire wen_ctr = wen_mhpmcounter && hpm_idx == hpm_i;
+        wire wen_evt = wen_mhpmevent   && hpm_idx == hpm_i;
+
+        wire inc_ctr = |(evt & hpm_events) && !mcountin_hpm[hpm_i];
+
+        wire [XL:0] n_ctr =
+            !wen_ctr   ? ctr + 1            :
+            csr_wr_set ? ctr |  csr_wdata   :
+            csr_wr_clr ? ctr & ~csr_wdata   :
+                               csr_wdata    ;
+
+        wire [HPM_EVENTS_R:0] n_evt =
+            csr_wr_set ? evt |  csr_wdata[HPM_EVENTS_R:0] :
+            csr_wr_clr ? evt & ~csr_wdata[HPM_EVENTS_R:0] :
+                                csr_wdata[HPM_EVENTS_R:0] ;
+
+        always @(posedge g_clk) begin
+            if(!g_resetn) begin
+                ctr <= 0;
+            end else if(wen_ctr || inc_ctr) begin
+                ctr <= n_ctr;
+            end
+        end
+
+        always @(posedge g_clk) begin
+            if(!g_resetn) begin
+                evt <= 0;
+            end else if(wen_evt) begin
+                evt <= n_evt;
+            end
+        end
+
+        assign hpm_ctr_all[64*hpm_i+:64]                     = ctr;
+        assign hpm_evt_all[HPM_EVENTS_W*hpm_i+:HPM_EVENTS_W] = evt;
+
+    end else begin : gen_zero
+
+        assign hpm_ctr_all[64*hpm_i+:64]                     = 64'b0;
+        assign hpm_evt_all[HPM_EVENTS_W*hpm_i+:HPM_EVENTS_W] = 0;
+
+    end
+
+end endgenerate
+
+wire [XL:0] reg_hpmcounter = hpm_ctr_all[64*hpm_idx+:64];
+
+wire [XL:0] reg_mhpmevent  = {
+    {XLEN-HPM_EVENTS_W{1'b0}},
+    hpm_evt_all[HPM_EVENTS_W*hpm_idx+:HPM_EVENTS_W]
+};
+
+
 //
 // CSR read responses.
 // -------------------------------------------------------------------------
@@ -598,6 +697,10 @@ wire   read_mcycle    = mode_m && csr_en && csr_addr == ADDR_MCYCLE   ;
 wire   read_minstret  = mode_m && csr_en && csr_addr == ADDR_MINSTRET ;
 wire   read_mcountin  = mode_m && csr_en && csr_addr == ADDR_MCOUNTIN ;
 
+wire   read_hpmcntr   =           csr_en && addr_hpmcounter  && hpm_idx_valid;
+wire   read_mhpmcntr  = mode_m && csr_en && addr_mhpmcounter && hpm_idx_valid;
+wire   read_mhpmevent = mode_m && csr_en && addr_mhpmevent   && hpm_idx_valid;
+
 wire   valid_addr     = 
     read_mstatus   ||
     read_misa      ||
@@ -619,7 +722,10 @@ wire   valid_addr     =
     read_instret   ||
     read_mcycle    ||
     read_minstret  ||
-    read_mcountin   ;
+    read_mcountin  ||
+    read_hpmcntr   ||
+    read_mhpmcntr  ||
+    read_mhpmevent  ;
 
 wire invalid_addr = !valid_addr;
 
@@ -647,7 +753,10 @@ assign csr_rdata =
     {64{read_instret  }} & ctr_instret          |
     {64{read_mcycle   }} & ctr_cycle            |
     {64{read_minstret }} & ctr_instret          |
-    {64{read_mcountin }} & reg_mcountin         ;
+    {64{read_mcountin }} & reg_mcountin         |
+    {64{read_hpmcntr  }} & reg_hpmcounter       |
+    {64{read_mhpmcntr }} & reg_hpmcounter       |
+    {64{read_mhpmevent}} & reg_mhpmevent        ;
 
 `ifdef RVFI
 assign da_mstatus    = reg_mstatus   ;
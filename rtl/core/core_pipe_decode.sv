@@ -13,7 +13,11 @@ parameter F_ZKNE = 1, // Turn on NIST AES encrypt
 parameter F_ZKND = 1, // Turn on NIST AES decrypt
 parameter F_ZKNH = 1, // Turn on NIST SHA2 instructions
 parameter F_ZKSED= 1, // Turn on ShangMi SM4 instructions
-parameter F_ZKSH = 1  // Turn on ShangMi SM3 instructions
+parameter F_ZKSH = 1, // Turn on ShangMi SM3 instructions
+parameter F_ZBA  = 1, // Turn on Zba address generation instructions
+parameter F_ZBB  = 1, // Turn on Zbb basic bit-manipulation instructions
+parameter F_ZBS  = 1, // Turn on Zbs single-bit instructions
+parameter DUAL_ISSUE = 0 // Issue pairs of simple ALU instructions.
 )(
 
 input  wire                 g_clk           , // Global clock
@@ -77,6 +81,23 @@ output wire                 s2_alu_grev     , //
 output wire                 s2_alu_gorc     , //
 output wire                 s2_alu_xpermn   , //
 output wire                 s2_alu_xpermb   , //
+output wire                 s2_alu_uw       , //
+output wire                 s2_alu_sh1add   , //
+output wire                 s2_alu_sh2add   , //
+output wire                 s2_alu_sh3add   , //
+output wire                 s2_alu_clz      , //
+output wire                 s2_alu_ctz      , //
+output wire                 s2_alu_cpop     , //
+output wire                 s2_alu_min      , //
+output wire                 s2_alu_minu     , //
+output wire                 s2_alu_max      , //
+output wire                 s2_alu_maxu     , //
+output wire                 s2_alu_sextb    , //
+output wire                 s2_alu_sexth    , //
+output wire                 s2_alu_bclr     , //
+output wire                 s2_alu_bset     , //
+output wire                 s2_alu_binv     , //
+output wire                 s2_alu_bext     , //
 output wire                 s2_alu_word     , // Word result only.
 
 output wire                 s2_cfu_beq      , // Control flow operation.
@@ -149,7 +170,38 @@ output wire                 s2_wb_csr       , // Writeback CSR result
 output wire                 s2_wb_mdu       , // Writeback MDU result
 output wire                 s2_wb_lsu       , // Writeback LSU Loaded data
 output wire                 s2_wb_cry       , // Writeback Crypto result.
-output wire                 s2_wb_npc         // Writeback next PC value
+output wire                 s2_wb_npc       , // Writeback next PC value
+
+input  wire                 s1_b_i16bit     , // Second 16 bit instruction?
+input  wire                 s1_b_i32bit     , // Second 32 bit instruction?
+input  wire [  FD_IBUF_R:0] s1_b_instr      , // Second instr to be decoded
+input  wire [   FD_ERR_R:0] s1_b_ferr       , // Second instr fetch error?
+output wire                 s1_b_eat_2      , // Decode eats 2 more bytes
+output wire                 s1_b_eat_4      , // Decode eats 4 more bytes
+
+output wire [ REG_ADDR_R:0] s1_b_rs1_addr   , // Second lane RS1 Address
+input  wire [         XL:0] s1_b_rs1_data   , // Second lane RS1 Read Data
+output wire [ REG_ADDR_R:0] s1_b_rs2_addr   , // Second lane RS2 Address
+input  wire [         XL:0] s1_b_rs2_data   , // Second lane RS2 Read Data
+
+output wire                 s2_b_valid      , // Second lane instr valid.
+output wire [ REG_ADDR_R:0] s2_b_rd         , // Second lane rd address.
+output wire [         XL:0] s2_b_pc         , // Second lane PC.
+output wire [         31:0] s2_b_instr      , // Second lane instr word.
+output wire [         XL:0] s2_b_alu_lhs    , // Second lane ALU operands.
+output wire [         XL:0] s2_b_alu_rhs    , //
+output wire [          5:0] s2_b_alu_shamt  , //
+output wire                 s2_b_alu_add    , // Second lane ALU operation.
+output wire                 s2_b_alu_and    , //
+output wire                 s2_b_alu_or     , //
+output wire                 s2_b_alu_sll    , //
+output wire                 s2_b_alu_srl    , //
+output wire                 s2_b_alu_slt    , //
+output wire                 s2_b_alu_sltu   , //
+output wire                 s2_b_alu_sra    , //
+output wire                 s2_b_alu_sub    , //
+output wire                 s2_b_alu_xor    , //
+output wire                 s2_b_alu_word     //
 
 );
 
@@ -189,12 +241,17 @@ wire        e_cf_change = cf_valid && cf_ack;
 
 assign      s2_npc      = s2_pc + {61'b0, s1_i32bit, s1_i16bit, 1'b0};
 
+// Next program counter after the second issue lane instruction.
+wire [XL:0] s2_b_npc    = s2_npc + {61'b0, s1_b_i32bit, s1_b_i16bit, 1'b0};
+
 
 always @(posedge g_clk) begin
     if(!g_resetn) begin
         s2_pc_reg <= PC_RESET_ADDRESS;
     end else if(e_cf_change) begin
         s2_pc_reg <= cf_target[MEM_ADDR_R:0];
+    end else if(s1_b_eat_2 || s1_b_eat_4) begin
+        s2_pc_reg <= s2_b_npc[MEM_ADDR_R:0];
     end else if(s1_eat_2 || s1_eat_4) begin
         s2_pc_reg <= s2_npc[MEM_ADDR_R:0];
     end
@@ -251,7 +308,10 @@ wire    use_imm_shamt        = dec_slli     || dec_srli         ||
                                dec_c_slli   || dec_c_srli       ||
                                dec_c_srai   || dec_roriw        ||
                                dec_rori     || dec_grevi        ||
-                               dec_gorci    ;
+                               dec_gorci    || dec_rev8         ||
+                               dec_orc_b    || dec_slli_uw      ||
+                               dec_bclri    || dec_bexti        ||
+                               dec_binvi    || dec_bseti        ;
 
 wire    use_imm_c_addi      = dec_c_addi    || dec_c_addiw      ||
                               dec_c_li      || dec_c_andi       ;
@@ -409,7 +469,18 @@ assign  s2_alu_add  = dec_add           || dec_addi          ||
                       dec_auipc         || dec_c_add         ||
                       dec_c_addi        || dec_c_addi4spn    ||
                       dec_c_addiw       || dec_c_addw        ||
-                      dec_c_addi16sp    ;
+                      dec_c_addi16sp    || dec_add_uw        ||
+                      dec_sh1add        || dec_sh1add_uw     ||
+                      dec_sh2add        || dec_sh2add_uw     ||
+                      dec_sh3add        || dec_sh3add_uw     ;
+
+assign  s2_alu_uw   = dec_add_uw        || dec_sh1add_uw     ||
+                      dec_sh2add_uw     || dec_sh3add_uw     ||
+                      dec_slli_uw       ;
+
+assign  s2_alu_sh1add = dec_sh1add      || dec_sh1add_uw     ;
+assign  s2_alu_sh2add = dec_sh2add      || dec_sh2add_uw     ;
+assign  s2_alu_sh3add = dec_sh3add      || dec_sh3add_uw     ;
 
 assign  s2_alu_and  = dec_and           || dec_andi          ||
                       dec_c_and         || dec_c_andi        ;
@@ -421,7 +492,7 @@ assign  s2_alu_or   = dec_c_li          || dec_c_lui         ||
 
 assign  s2_alu_sll  = dec_c_slli        || dec_sll           ||
                       dec_slli          || dec_slliw         ||
-                      dec_sllw          ;
+                      dec_sllw          || dec_slli_uw       ;
 
 assign  s2_alu_ror  = dec_rorw          || dec_ror           ||
                       dec_roriw         || dec_rori          ;
@@ -444,19 +515,37 @@ assign  s2_alu_xorn = dec_xnor;
 assign  s2_alu_andn = dec_andn;
 assign  s2_alu_orn  = dec_orn ;
 
-assign  s2_alu_pack = dec_pack          || dec_packw         ;
+assign  s2_alu_pack = dec_pack          || dec_packw         ||
+                      dec_zext_h        ;
 
 assign  s2_alu_packh= dec_packh         ;
 
 assign  s2_alu_packu= dec_packu         || dec_packuw        ;
 
-assign  s2_alu_grev = dec_grevi         ;
+assign  s2_alu_grev = dec_grevi         || dec_rev8          ;
 
-assign  s2_alu_gorc = dec_gorci         ;
+assign  s2_alu_gorc = dec_gorci         || dec_orc_b         ;
 
 assign  s2_alu_xpermn= dec_xperm_n      ;
 assign  s2_alu_xpermb= dec_xperm_b      ;
 
+assign  s2_alu_clz  = dec_clz           || dec_clzw          ;
+assign  s2_alu_ctz  = dec_ctz           || dec_ctzw          ;
+assign  s2_alu_cpop = dec_cpop          || dec_cpopw         ;
+
+assign  s2_alu_min  = dec_min           ;
+assign  s2_alu_minu = dec_minu          ;
+assign  s2_alu_max  = dec_max           ;
+assign  s2_alu_maxu = dec_maxu          ;
+
+assign  s2_alu_sextb= dec_sext_b        ;
+assign  s2_alu_sexth= dec_sext_h        ;
+
+assign  s2_alu_bclr = dec_bclr          || dec_bclri         ;
+assign  s2_alu_bset = dec_bset          || dec_bseti         ;
+assign  s2_alu_binv = dec_binv          || dec_binvi         ;
+assign  s2_alu_bext = dec_bext          || dec_bexti         ;
+
 assign  s2_alu_sub  = dec_beq           || dec_c_beqz        ||
                       dec_bge           || dec_c_bnez        ||
                       dec_bgeu          || dec_c_sub         ||
@@ -475,7 +564,9 @@ assign  s2_alu_word = dec_addiw         || dec_addw         ||
                       dec_c_addiw       || dec_c_addw       ||
                       dec_rolw          || dec_rorw         ||
                       dec_roriw         || dec_packw        ||
-                      dec_packuw        ;
+                      dec_packuw        || dec_zext_h       ||
+                      dec_clzw          || dec_ctzw         ||
+                      dec_cpopw         ;
 
 //
 // CFU
@@ -582,7 +673,10 @@ assign  s2_wb_alu     = !s2_trap && !s2_wb_npc && !cfu_op_conditonal && (
     s2_alu_sub      || s2_alu_xor      || s2_alu_word     || s2_alu_pack||
     s2_alu_packh    || s2_alu_packu    || s2_alu_andn     || s2_alu_orn ||
     s2_alu_xorn     || s2_alu_ror      || s2_alu_rol      || s2_alu_grev||
-    s2_alu_gorc     || s2_alu_xpermn   || s2_alu_xpermb   );
+    s2_alu_gorc     || s2_alu_xpermn   || s2_alu_xpermb   || s2_alu_clz ||
+    s2_alu_ctz      || s2_alu_cpop     || s2_alu_min      || s2_alu_minu||
+    s2_alu_max      || s2_alu_maxu     || s2_alu_sextb    || s2_alu_sexth||
+    s2_alu_bclr     || s2_alu_bset     || s2_alu_binv     || s2_alu_bext);
 
 assign  s2_wb_csr     = !s2_trap && s2_csr_rd   ;
 
@@ -623,6 +717,89 @@ assign  s2_trap_cause       = s2_iaccess_trap_16    ? TRAP_IACCESS  :
                               dec_invalid_opcode    ? TRAP_IOPCODE  :
                                                       7'b0          ;
 
+//
+// Second issue lane
+// ------------------------------------------------------------
+//
+//  A second instruction may issue alongside the first only when both
+//  are simple ALU operations, and the second neither reads nor writes
+//  the destination register of the first.
+//
+
+wire        b_pairable      ; // Second instruction is a simple ALU op.
+wire [ 4:0] b_rd            ; // Second instruction destination.
+
+assign      s2_b_pc         = s2_npc;
+assign      s2_b_instr      = {s1_b_i32bit ? s1_b_instr[31:16] : 16'b0,
+                               s1_b_instr[15:0]};
+
+wire        a_pairable      = s2_valid && s2_wb_alu;
+
+wire        b_dep_rd        = |s2_rd && (
+    s1_b_rs1_addr == s2_rd  || s1_b_rs2_addr == s2_rd || b_rd == s2_rd
+);
+
+assign      s2_b_valid      = DUAL_ISSUE    && a_pairable   &&
+                              b_pairable    && !b_dep_rd    ;
+
+assign      s2_b_rd         = b_rd;
+
+assign      s1_b_eat_2      = s2_b_valid && s1_b_i16bit && s2_ready;
+assign      s1_b_eat_4      = s2_b_valid && s1_b_i32bit && s2_ready;
+
+generate if(DUAL_ISSUE) begin : gen_dual_issue
+
+    core_pipe_decode_pair i_core_pipe_decode_pair (
+    .s1_i16bit    (s1_b_i16bit    ), // 16 bit instruction?
+    .s1_i32bit    (s1_b_i32bit    ), // 32 bit instruction?
+    .s1_instr     (s1_b_instr     ), // Instruction to be decoded
+    .s1_ferr      (s1_b_ferr      ), // Fetch bus error?
+    .pc           (s2_b_pc        ), // PC of the instruction.
+    .pairable     (b_pairable     ), // Can issue in second lane.
+    .rs1_addr     (s1_b_rs1_addr  ), // RS1 Address
+    .rs1_data     (s1_b_rs1_data  ), // RS1 Read Data (Forwarded)
+    .rs2_addr     (s1_b_rs2_addr  ), // RS2 Address
+    .rs2_data     (s1_b_rs2_data  ), // RS2 Read Data (Forwarded)
+    .rd           (b_rd           ), // Destination reg address.
+    .alu_lhs      (s2_b_alu_lhs   ), // ALU left  operand
+    .alu_rhs      (s2_b_alu_rhs   ), // ALU right operand
+    .alu_shamt    (s2_b_alu_shamt ), // ALU Shift amount
+    .alu_add      (s2_b_alu_add   ), // ALU Operation to perform.
+    .alu_and      (s2_b_alu_and   ), //
+    .alu_or       (s2_b_alu_or    ), //
+    .alu_sll      (s2_b_alu_sll   ), //
+    .alu_srl      (s2_b_alu_srl   ), //
+    .alu_slt      (s2_b_alu_slt   ), //
+    .alu_sltu     (s2_b_alu_sltu  ), //
+    .alu_sra      (s2_b_alu_sra   ), //
+    .alu_sub      (s2_b_alu_sub   ), //
+    .alu_xor      (s2_b_alu_xor   ), //
+    .alu_word     (s2_b_alu_word  )  // Word result only.
+    );
+
+end else begin : gen_single_issue
+
+    assign b_pairable     = 1'b0;
+    assign b_rd           = {REG_ADDR_W{1'b0}};
+    assign s1_b_rs1_addr  = {REG_ADDR_W{1'b0}};
+    assign s1_b_rs2_addr  = {REG_ADDR_W{1'b0}};
+    assign s2_b_alu_lhs   = {XLEN{1'b0}};
+    assign s2_b_alu_rhs   = {XLEN{1'b0}};
+    assign s2_b_alu_shamt = 6'b0;
+    assign s2_b_alu_add   = 1'b0;
+    assign s2_b_alu_and   = 1'b0;
+    assign s2_b_alu_or    = 1'b0;
+    assign s2_b_alu_sll   = 1'b0;
+    assign s2_b_alu_srl   = 1'b0;
+    assign s2_b_alu_slt   = 1'b0;
+    assign s2_b_alu_sltu  = 1'b0;
+    assign s2_b_alu_sra   = 1'b0;
+    assign s2_b_alu_sub   = 1'b0;
+    assign s2_b_alu_xor   = 1'b0;
+    assign s2_b_alu_word  = 1'b0;
+
+end endgenerate
+
 //
 // Submodule instances
 // ------------------------------------------------------------
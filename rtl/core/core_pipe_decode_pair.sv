@@ -0,0 +1,268 @@
+
+//
+// Module: core_pipe_decode_pair
+//
+//  Restricted decoder for the second (paired) issue lane. Only simple
+//  integer ALU instructions are recognised. Anything else, including
+//  instructions tagged with a fetch error, is reported as not pairable
+//  and is left for the main decoder to issue on a later cycle.
+//
+module core_pipe_decode_pair (
+
+input  wire                 s1_i16bit       , // 16 bit instruction?
+input  wire                 s1_i32bit       , // 32 bit instruction?
+input  wire [  FD_IBUF_R:0] s1_instr        , // Instruction to be decoded
+input  wire [   FD_ERR_R:0] s1_ferr         , // Fetch bus error?
+input  wire [         XL:0] pc              , // PC of the instruction.
+
+output wire                 pairable        , // Can issue in second lane.
+
+output wire [ REG_ADDR_R:0] rs1_addr        , // RS1 Address
+input  wire [         XL:0] rs1_data        , // RS1 Read Data (Forwarded)
+output wire [ REG_ADDR_R:0] rs2_addr        , // RS2 Address
+input  wire [         XL:0] rs2_data        , // RS2 Read Data (Forwarded)
+output wire [ REG_ADDR_R:0] rd              , // Destination reg address.
+
+output wire [         XL:0] alu_lhs         , // ALU left  operand
+output wire [         XL:0] alu_rhs         , // ALU right operand
+output wire [          5:0] alu_shamt       , // ALU Shift amount
+output wire                 alu_add         , // ALU Operation to perform.
+output wire                 alu_and         , //
+output wire                 alu_or          , //
+output wire                 alu_sll         , //
+output wire                 alu_srl         , //
+output wire                 alu_slt         , //
+output wire                 alu_sltu        , //
+output wire                 alu_sra         , //
+output wire                 alu_sub         , //
+output wire                 alu_xor         , //
+output wire                 alu_word          // Word result only.
+
+);
+
+// Common parameters and width definitions.
+`include "core_common.svh"
+
+// None of the crypto / bitmanip instructions issue in the second lane.
+localparam F_ZKB  = 0;
+localparam F_ZKG  = 0;
+localparam F_ZKNE = 0;
+localparam F_ZKND = 0;
+localparam F_ZKNH = 0;
+localparam F_ZKSED= 0;
+localparam F_ZKSH = 0;
+localparam F_ZBA  = 0;
+localparam F_ZBB  = 0;
+localparam F_ZBS  = 0;
+
+// Generated decoder
+`include "core_pipe_decode.svh"
+
+//
+// Supported instructions
+// ------------------------------------------------------------
+
+wire    op_32_imm   = dec_addi   || dec_slti   || dec_sltiu  || dec_xori   ||
+                      dec_ori    || dec_andi   || dec_addiw  ;
+
+wire    op_32_shamt = dec_slli   || dec_srli   || dec_srai   || dec_slliw  ||
+                      dec_srliw  || dec_sraiw  ;
+
+wire    op_32_reg   = dec_add    || dec_sub    || dec_sll    || dec_slt    ||
+                      dec_sltu   || dec_xor    || dec_srl    || dec_sra    ||
+                      dec_or     || dec_and    || dec_addw   || dec_subw   ||
+                      dec_sllw   || dec_srlw   || dec_sraw   ;
+
+wire    op_32_upper = dec_lui    || dec_auipc  ;
+
+wire    op_16_imm   = dec_c_addi || dec_c_addiw|| dec_c_li   || dec_c_andi ||
+                      dec_c_lui  || dec_c_addi4spn || dec_c_addi16sp;
+
+wire    op_16_shamt = dec_c_slli || dec_c_srli || dec_c_srai ;
+
+wire    op_16_reg   = dec_c_sub  || dec_c_xor  || dec_c_or   || dec_c_and  ||
+                      dec_c_subw || dec_c_addw || dec_c_mv   || dec_c_add  ;
+
+wire    op_32_any   = op_32_imm  || op_32_shamt|| op_32_reg  || op_32_upper;
+wire    op_16_any   = op_16_imm  || op_16_shamt|| op_16_reg  ;
+
+// An all-zeros halfword is an illegal instruction, not c.addi4spn.
+wire    i16_legal   = |s1_instr[15:0];
+
+assign  pairable    =
+    s1_i16bit && op_16_any && i16_legal && !s1_ferr[0]      ||
+    s1_i32bit && op_32_any && !(|s1_ferr[1:0])              ;
+
+//
+// Register Address Decoding
+// ------------------------------------------------------------
+
+wire rs1_16_prime = dec_c_srli || dec_c_srai || dec_c_andi || dec_c_sub  ||
+                    dec_c_xor  || dec_c_or   || dec_c_and  || dec_c_subw ||
+                    dec_c_addw ;
+
+wire rs1_16_sp    = dec_c_addi16sp || dec_c_addi4spn;
+
+wire rs1_16_5bit  = dec_c_add  || dec_c_addi || dec_c_addiw|| dec_c_slli ;
+
+wire rs2_16_6_2   = dec_c_add  || dec_c_mv   ;
+
+wire rs2_16_4_2   = dec_c_and  || dec_c_or   || dec_c_sub  || dec_c_addw ||
+                    dec_c_subw || dec_c_xor  ;
+
+wire [4:0] dec_rs1_16 =
+    {5{rs1_16_5bit   }} & {s1_instr[11:7]      } |
+    {5{rs1_16_sp     }} & {REG_SP              } |
+    {5{rs1_16_prime  }} & {2'b01, s1_instr[9:7]} ;
+
+wire [4:0] dec_rs2_16 =
+    {5{rs2_16_6_2    }} & {       s1_instr[6:2]} |
+    {5{rs2_16_4_2    }} & {2'b01, s1_instr[4:2]} ;
+
+wire [4:0] dec_rd_16  =
+    {5{dec_c_addi16sp}} & {REG_SP} |
+    {5{dec_c_addi4spn}} & {2'b01, s1_instr[4:2]} |
+    {5{rs1_16_5bit   }} & {s1_instr[11:7]} |
+    {5{dec_c_li      }} & {s1_instr[11:7]} |
+    {5{dec_c_lui     }} & {s1_instr[11:7]} |
+    {5{dec_c_mv      }} & {s1_instr[11:7]} |
+    {5{rs1_16_prime  }} & {2'b01, s1_instr[9:7]} ;
+
+// Unused source registers are forced to x0 so that they never create
+// false dependencies on the first lane.
+wire [4:0] dec_rs1_32 = op_32_upper ? REG_ZERO : dec_rs1;
+wire [4:0] dec_rs2_32 = op_32_reg   ? dec_rs2  : REG_ZERO;
+
+assign rs1_addr     = s1_i16bit ? dec_rs1_16 : dec_rs1_32 ;
+assign rs2_addr     = s1_i16bit ? dec_rs2_16 : dec_rs2_32 ;
+assign rd           = s1_i16bit ? dec_rd_16  : dec_rd     ;
+
+//
+// Immediate Decoding
+// ------------------------------------------------------------
+
+wire [         31:0] imm32_i        ;
+wire [         11:0] imm_csr_addr   ;
+wire [          4:0] imm_csr_mask   ;
+wire [         31:0] imm32_s        ;
+wire [         31:0] imm32_b        ;
+wire [         31:0] imm32_u        ;
+wire [         31:0] imm32_j        ;
+wire [         31:0] imm_addi16sp   ;
+wire [         31:0] imm_addi4spn   ;
+wire [         31:0] imm_c_addi     ;
+wire [         31:0] imm_c_lui      ;
+wire [         31:0] imm_c_lsw      ;
+wire [         31:0] imm_c_lwsp     ;
+wire [         31:0] imm_c_swsp     ;
+wire [         31:0] imm_c_lsd      ;
+wire [         31:0] imm_c_ldsp     ;
+wire [         31:0] imm_c_sdsp     ;
+wire [         31:0] imm_c_j        ;
+wire [         31:0] imm_c_bz       ;
+
+wire    use_imm_c_addi  = dec_c_addi || dec_c_addiw || dec_c_li || dec_c_andi;
+
+wire    [31:0] imm32    =
+    op_32_upper     ? imm32_u       :
+    op_32_imm       ? imm32_i       :
+    dec_c_lui       ? imm_c_lui     :
+    dec_c_addi4spn  ? imm_addi4spn  :
+    dec_c_addi16sp  ? imm_addi16sp  :
+    use_imm_c_addi  ? imm_c_addi    :
+                      32'b0         ;
+
+wire    [XL:0] imm      = {{32{imm32[31]}}, imm32};
+
+wire    [ 5:0] imm_c_shamt  = {s1_instr[12],s1_instr[6:2]};
+
+wire    use_imm_shamt   = op_32_shamt || op_16_shamt;
+
+wire    [ 5:0] imm_shamt    = s1_i16bit ? imm_c_shamt : dec_shamt;
+
+//
+// Uop decoding.
+// ------------------------------------------------------------
+
+wire    alu_rhs_imm = op_32_imm || op_32_upper || op_16_imm;
+
+assign  alu_lhs     = dec_auipc     ? pc            :
+                      dec_lui       ? {XLEN{1'b0}}  :
+                                      rs1_data      ;
+
+assign  alu_rhs     = alu_rhs_imm   ? imm       : rs2_data      ;
+
+assign  alu_shamt   = use_imm_shamt ? imm_shamt : rs2_data[5:0] ;
+
+assign  alu_add     = dec_add           || dec_addi          ||
+                      dec_addiw         || dec_addw          ||
+                      dec_auipc         || dec_c_add         ||
+                      dec_c_addi        || dec_c_addi4spn    ||
+                      dec_c_addiw       || dec_c_addw        ||
+                      dec_c_addi16sp    ;
+
+assign  alu_and     = dec_and           || dec_andi          ||
+                      dec_c_and         || dec_c_andi        ;
+
+assign  alu_or      = dec_c_li          || dec_c_lui         ||
+                      dec_c_mv          || dec_c_or          ||
+                      dec_lui           || dec_or            ||
+                      dec_ori           ;
+
+assign  alu_sll     = dec_c_slli        || dec_sll           ||
+                      dec_slli          || dec_slliw         ||
+                      dec_sllw          ;
+
+assign  alu_slt     = dec_slti          || dec_slt           ;
+
+assign  alu_sltu    = dec_sltiu         || dec_sltu          ;
+
+assign  alu_sra     = dec_c_srai        || dec_sra           ||
+                      dec_srai          || dec_sraiw         ||
+                      dec_sraw          ;
+
+assign  alu_srl     = dec_c_srli        || dec_srl           ||
+                      dec_srli          || dec_srliw         ||
+                      dec_srlw          ;
+
+assign  alu_sub     = dec_c_sub         || dec_c_subw        ||
+                      dec_sub           || dec_subw          ;
+
+assign  alu_xor     = dec_c_xor         || dec_xor           ||
+                      dec_xori          ;
+
+assign  alu_word    = dec_addiw         || dec_addw         ||
+                      dec_slliw         || dec_sllw         ||
+                      dec_srliw         || dec_srlw         ||
+                      dec_sraiw         || dec_sraw         ||
+                      dec_subw          || dec_c_subw       ||
+                      dec_c_addiw       || dec_c_addw       ;
+
+//
+// Submodule instances
+// ------------------------------------------------------------
+
+core_pipe_decode_immediates i_core_pipe_decode_immediates (
+.instr        (s1_instr     ),   // Input encoded instruction.
+.imm32_i      (imm32_i      ),
+.imm_csr_addr (imm_csr_addr ),
+.imm_csr_mask (imm_csr_mask ),
+.imm32_s      (imm32_s      ),
+.imm32_b      (imm32_b      ),
+.imm32_u      (imm32_u      ),
+.imm32_j      (imm32_j      ),
+.imm_addi16sp (imm_addi16sp ),
+.imm_addi4spn (imm_addi4spn ),
+.imm_c_lsw    (imm_c_lsw    ),
+.imm_c_addi   (imm_c_addi   ),
+.imm_c_lui    (imm_c_lui    ),
+.imm_c_lwsp   (imm_c_lwsp   ),
+.imm_c_swsp   (imm_c_swsp   ),
+.imm_c_lsd    (imm_c_lsd    ),
+.imm_c_ldsp   (imm_c_ldsp   ),
+.imm_c_sdsp   (imm_c_sdsp   ),
+.imm_c_j      (imm_c_j      ),
+.imm_c_bz     (imm_c_bz     )
+);
+
+endmodule
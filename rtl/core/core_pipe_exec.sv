@@ -11,7 +11,15 @@ parameter F_ZKNE = 1, // Turn on NIST AES encrypt
 parameter F_ZKND = 1, // Turn on NIST AES decrypt
 parameter F_ZKNH = 1, // Turn on NIST SHA2 instructions
 parameter F_ZKSED= 1, // Turn on ShangMi SM4 instructions
-parameter F_ZKSH = 1  // Turn on ShangMi SM3 instructions
+parameter F_ZKSH = 1, // Turn on ShangMi SM3 instructions
+parameter DUAL_ISSUE = 0, // Issue pairs of simple ALU instructions.
+parameter MUL_IMPL   = 0, // Multiplier implementation. See MDU.
+parameter MUL_UNROLL = 4, // Iterative multiplier bits per cycle.
+parameter CLMUL_UNROLL=8, // Carry-less multiplier bits per cycle.
+parameter DIV_UNROLL = 1, // Divider quotient bits per cycle. 1 or 2.
+parameter DIV_NORMALISE=1,// Divider skips iterations using operand MSBs.
+parameter CRYPTO_IMPL= 0, // Crypto datapath. 0=area, 1=fast, 2=fast+shared.
+parameter MISALIGNED_HW = 0 // Split misaligned accesses rather than trap.
 )(
 
 input  wire                 g_clk           , // Global clock
@@ -72,6 +80,23 @@ input  wire                 s2_alu_grev     , //
 input  wire                 s2_alu_gorc     , //
 input  wire                 s2_alu_xpermn   , //
 input  wire                 s2_alu_xpermb   , //
+input  wire                 s2_alu_uw       , //
+input  wire                 s2_alu_sh1add   , //
+input  wire                 s2_alu_sh2add   , //
+input  wire                 s2_alu_sh3add   , //
+input  wire                 s2_alu_clz      , //
+input  wire                 s2_alu_ctz      , //
+input  wire                 s2_alu_cpop     , //
+input  wire                 s2_alu_min      , //
+input  wire                 s2_alu_minu     , //
+input  wire                 s2_alu_max      , //
+input  wire                 s2_alu_maxu     , //
+input  wire                 s2_alu_sextb    , //
+input  wire                 s2_alu_sexth    , //
+input  wire                 s2_alu_bclr     , //
+input  wire                 s2_alu_bset     , //
+input  wire                 s2_alu_binv     , //
+input  wire                 s2_alu_bext     , //
 input  wire                 s2_alu_word     , // Word result only.
 
 input  wire                 s2_cfu_beq      , // Control flow operation.
@@ -146,6 +171,25 @@ input  wire                 s2_wb_lsu       , // Writeback LSU Loaded data
 input  wire                 s2_wb_cry       , // Writeback crypto result.
 input  wire                 s2_wb_npc       , // Writeback next PC value
 
+input  wire                 s2_b_valid      , // Second lane instr valid.
+input  wire [ REG_ADDR_R:0] s2_b_rd         , // Second lane rd address.
+input  wire [         XL:0] s2_b_pc         , // Second lane PC.
+input  wire [         31:0] s2_b_instr      , // Second lane instr word.
+input  wire [         XL:0] s2_b_alu_lhs    , // Second lane ALU operands.
+input  wire [         XL:0] s2_b_alu_rhs    , //
+input  wire [          5:0] s2_b_alu_shamt  , //
+input  wire                 s2_b_alu_add    , // Second lane ALU operation.
+input  wire                 s2_b_alu_and    , //
+input  wire                 s2_b_alu_or     , //
+input  wire                 s2_b_alu_sll    , //
+input  wire                 s2_b_alu_srl    , //
+input  wire                 s2_b_alu_slt    , //
+input  wire                 s2_b_alu_sltu   , //
+input  wire                 s2_b_alu_sra    , //
+input  wire                 s2_b_alu_sub    , //
+input  wire                 s2_b_alu_xor    , //
+input  wire                 s2_b_alu_word   , //
+
 output wire                 s3_valid        , // New instruction ready
 input  wire                 s3_ready        , // WB ready for new instruciton.
 output reg                  s3_full         , // WB has an instr in it.
@@ -154,12 +198,22 @@ output reg  [         31:0] s3_instr        , // Writeback stage instr word
 output reg  [         XL:0] s3_wdata        , // Writeback stage instr word
 output reg  [ REG_ADDR_R:0] s3_rd           , // Writeback stage instr word
 output reg  [   LSU_OP_R:0] s3_lsu_op       , // Writeback LSU op
+output wire                 s3_lsu_split    , // Writeback LSU access was split
+output wire [         XL:0] s3_lsu_rdata_lo , // First beat of split load
+output wire                 s3_lsu_err_lo   , // First beat of split access err
+output wire                 dmem_split_first, // First beat of split access
 output reg  [   CSR_OP_R:0] s3_csr_op       , // Writeback CSR op
 output reg  [         11:0] s3_csr_addr     , // CSR Address
 output reg  [   CFU_OP_R:0] s3_cfu_op       , // Writeback CFU op
 output reg  [    WB_OP_R:0] s3_wb_op        , // Writeback Data source.
 output reg                  s3_trap         , // Raise a trap
 
+output wire                 s3_b_full       , // WB has a second lane instr.
+output wire [         XL:0] s3_b_pc         , // Second lane WB PC
+output wire [         31:0] s3_b_instr      , // Second lane WB instr word
+output wire [         XL:0] s3_b_wdata      , // Second lane WB write data
+output wire [ REG_ADDR_R:0] s3_b_rd         , // Second lane WB rd address
+
 `ifdef RVFI
 output reg  [ REG_ADDR_R:0] s3_rs1_addr     ,
 output reg  [ REG_ADDR_R:0] s3_rs2_addr     ,
@@ -399,6 +453,104 @@ always @(posedge g_clk) begin
     end
 end
 
+//
+// Second issue lane
+// ------------------------------------------------------------
+//
+//  Only simple ALU instructions issue in the second lane, so it never
+//  stalls, traps or changes control flow. It progresses into writeback
+//  alongside the first lane instruction.
+//
+
+generate if(DUAL_ISSUE) begin : gen_dual_issue
+
+    wire [XL:0] alu_b_result    ;
+
+    reg         r_s3_b_full     ;
+    reg  [XL:0] r_s3_b_pc       ;
+    reg  [31:0] r_s3_b_instr    ;
+    reg  [XL:0] r_s3_b_wdata    ;
+    reg  [ 4:0] r_s3_b_rd       ;
+
+    assign      s3_b_full       = r_s3_b_full   ;
+    assign      s3_b_pc         = r_s3_b_pc     ;
+    assign      s3_b_instr      = r_s3_b_instr  ;
+    assign      s3_b_wdata      = r_s3_b_wdata  ;
+    assign      s3_b_rd         = r_s3_b_rd     ;
+
+    always @(posedge g_clk) begin
+        if(!g_resetn || s2_flush) begin
+            r_s3_b_full     <= 1'b0;
+        end else if(s3_valid && s3_ready) begin
+            r_s3_b_full     <= n_s3_full && s2_b_valid;
+            r_s3_b_pc       <= s2_b_pc      ;
+            r_s3_b_instr    <= s2_b_instr   ;
+            r_s3_b_wdata    <= alu_b_result ;
+            r_s3_b_rd       <= s2_b_rd      ;
+        end
+    end
+
+    core_pipe_exec_alu i_core_pipe_exec_alu_b (
+    .opr_a      (s2_b_alu_lhs   ), // Input operand A
+    .opr_b      (s2_b_alu_rhs   ), // Input operand B
+    .shamt      (s2_b_alu_shamt ), // Shift amount.
+    .word       (s2_b_alu_word  ), // Operate on low 32-bits of XL.
+    .op_add     (s2_b_alu_add   ), // Select output of adder
+    .op_sub     (s2_b_alu_sub   ), // Subtract opr_a from opr_b else add
+    .op_xor     (s2_b_alu_xor   ), // Select XOR operation result
+    .op_or      (s2_b_alu_or    ), // Select OR
+    .op_and     (s2_b_alu_and   ), //        AND
+    .op_slt     (s2_b_alu_slt   ), // Set less than
+    .op_sltu    (s2_b_alu_sltu  ), //                Unsigned
+    .op_srl     (s2_b_alu_srl   ), // Shift right logical
+    .op_sll     (s2_b_alu_sll   ), // Shift left logical
+    .op_sra     (s2_b_alu_sra   ), // Shift right arithmetic
+    .op_xorn    (1'b0           ), // 
+    .op_andn    (1'b0           ), // 
+    .op_orn     (1'b0           ), // 
+    .op_ror     (1'b0           ), //
+    .op_rol     (1'b0           ), //
+    .op_pack    (1'b0           ), //
+    .op_packh   (1'b0           ), //
+    .op_packu   (1'b0           ), //
+    .op_grev    (1'b0           ), //
+    .op_gorc    (1'b0           ), //
+    .op_xpermn  (1'b0           ), //
+    .op_xpermb  (1'b0           ), //
+    .op_uw      (1'b0           ), //
+    .op_sh1add  (1'b0           ), //
+    .op_sh2add  (1'b0           ), //
+    .op_sh3add  (1'b0           ), //
+    .op_clz     (1'b0           ), //
+    .op_ctz     (1'b0           ), //
+    .op_cpop    (1'b0           ), //
+    .op_min     (1'b0           ), //
+    .op_minu    (1'b0           ), //
+    .op_max     (1'b0           ), //
+    .op_maxu    (1'b0           ), //
+    .op_sextb   (1'b0           ), //
+    .op_sexth   (1'b0           ), //
+    .op_bclr    (1'b0           ), //
+    .op_bset    (1'b0           ), //
+    .op_binv    (1'b0           ), //
+    .op_bext    (1'b0           ), //
+    .add_out    (               ), // Result of adding opr_a and opr_b
+    .cmp_eq     (               ), // Result of opr_a == opr_b
+    .cmp_lt     (               ), // Result of opr_a <  opr_b
+    .cmp_ltu    (               ), // Result of opr_a <  opr_b
+    .result     (alu_b_result   )  // Operation result
+    );
+
+end else begin : gen_single_issue
+
+    assign      s3_b_full       = 1'b0;
+    assign      s3_b_pc         = {XLEN{1'b0}};
+    assign      s3_b_instr      = 32'b0;
+    assign      s3_b_wdata      = {XLEN{1'b0}};
+    assign      s3_b_rd         = {REG_ADDR_W{1'b0}};
+
+end endgenerate
+
 //
 // RVFI
 // ------------------------------------------------------------
@@ -456,6 +608,23 @@ core_pipe_exec_alu i_core_pipe_exec_alu (
 .op_gorc    (s2_alu_gorc    ), //
 .op_xpermn  (s2_alu_xpermn  ), //
 .op_xpermb  (s2_alu_xpermb  ), //
+.op_uw      (s2_alu_uw      ), //
+.op_sh1add  (s2_alu_sh1add  ), //
+.op_sh2add  (s2_alu_sh2add  ), //
+.op_sh3add  (s2_alu_sh3add  ), //
+.op_clz     (s2_alu_clz     ), //
+.op_ctz     (s2_alu_ctz     ), //
+.op_cpop    (s2_alu_cpop    ), //
+.op_min     (s2_alu_min     ), //
+.op_minu    (s2_alu_minu    ), //
+.op_max     (s2_alu_max     ), //
+.op_maxu    (s2_alu_maxu    ), //
+.op_sextb   (s2_alu_sextb   ), //
+.op_sexth   (s2_alu_sexth   ), //
+.op_bclr    (s2_alu_bclr    ), //
+.op_bset    (s2_alu_bset    ), //
+.op_binv    (s2_alu_binv    ), //
+.op_bext    (s2_alu_bext    ), //
 .add_out    (alu_add_out    ), // Result of adding opr_a and opr_b
 .cmp_eq     (alu_cmp_eq     ), // Result of opr_a == opr_b
 .cmp_lt     (alu_cmp_lt     ), // Result of opr_a <  opr_b
@@ -468,7 +637,8 @@ riscv_crypto_fu #(
 .XLEN          (        64), // Must be one of: 32, 64.
 .SAES_ENC_EN   (F_ZKNE    ), // Enable AES encrypt instructions
 .SAES_DEC_EN   (F_ZKND    ), // Enable AES decrypt instructions
-.SAES64_SBOXES (        4 ), // saes64 sbox instances. Valid values: 8,4
+.SAES64_SBOXES (CRYPTO_IMPL ? 8 : 4), // saes64 sbox instances: 8,4
+.SBOX_SHARE_SM4(CRYPTO_IMPL == 2  ), // ssm4 shares an saes64 sbox.
 .SSHA256_EN    (F_ZKNH    ), // Enable the ssha256.* instructions.
 .SSHA512_EN    (F_ZKNH    ), // Enable the ssha256.* instructions.
 .SSM3_EN       (F_ZKSH    ), // Enable the ssm3.* instructions.
@@ -507,7 +677,13 @@ riscv_crypto_fu #(
 //
 // MDU
 
-core_pipe_exec_mdu i_core_pipe_exec_mdu(
+core_pipe_exec_mdu #(
+.MUL_IMPL   (MUL_IMPL       ),
+.MUL_UNROLL (MUL_UNROLL     ),
+.CLMUL_UNROLL(CLMUL_UNROLL  ),
+.DIV_UNROLL (DIV_UNROLL     ),
+.DIV_NORMALISE(DIV_NORMALISE)
+) i_core_pipe_exec_mdu(
 .g_clk      (g_clk_mul      ) , // Clock
 .g_clk_req  (g_clk_mul_req  ) , // Clock request
 .g_resetn   (g_resetn       ) , // Active low synchronous reset.
@@ -534,7 +710,8 @@ core_pipe_exec_mdu i_core_pipe_exec_mdu(
 // LSU
 
 core_pipe_exec_lsu #(
-.MEM_ADDR_W     (MEM_ADDR_W     )
+.MEM_ADDR_W     (MEM_ADDR_W     ),
+.MISALIGNED_HW  (MISALIGNED_HW  )
 ) i_core_pipe_exec_lsu (
 .g_clk      (g_clk          ), // Global clock enable.
 .g_resetn   (g_resetn       ), // Global synchronous reset
@@ -553,6 +730,10 @@ core_pipe_exec_lsu #(
 .mprv_u     (mprv_u         ), // Access memory as if in User    mode.
 .ready      (lsu_ready      ), // Read data ready
 .trap_addr  (lsu_trap_addr  ), // Address alignment error
+.split_first(dmem_split_first), // First beat of a split access.
+.s3_split   (s3_lsu_split   ), // Instr in writeback was split.
+.split_rdata(s3_lsu_rdata_lo), // First beat read data.
+.split_err  (s3_lsu_err_lo  ), // First beat error.
 .dmem_req   (dmem_req       ), // Memory request
 .dmem_rtype (dmem_rtype     ), // Memory request type.
 .dmem_addr  (dmem_addr      ), // Memory request address
@@ -33,6 +33,23 @@ input  wire             op_grev , //
 input  wire             op_gorc , //
 input  wire             op_xpermn,//
 input  wire             op_xpermb,//
+input  wire             op_uw   , // Zero-extend low word of opr_a
+input  wire             op_sh1add, // Add opr_a << 1
+input  wire             op_sh2add, // Add opr_a << 2
+input  wire             op_sh3add, // Add opr_a << 3
+input  wire             op_clz  , // Count leading zeros
+input  wire             op_ctz  , // Count trailing zeros
+input  wire             op_cpop , // Count set bits
+input  wire             op_min  , // Signed minimum
+input  wire             op_minu , // Unsigned minimum
+input  wire             op_max  , // Signed maximum
+input  wire             op_maxu , // Unsigned maximum
+input  wire             op_sextb, // Sign extend byte
+input  wire             op_sexth, // Sign extend halfword
+input  wire             op_bclr , // Clear bit
+input  wire             op_bset , // Set bit
+input  wire             op_binv , // Invert bit
+input  wire             op_bext , // Extract bit
 
 output wire [   XL:0]   add_out , // Result of adding opr_a and opr_b
 output wire             cmp_eq  , // Result of opr_a == opr_b
@@ -60,7 +77,16 @@ wire [XL:0] opr_b_n         = neg_opr_b ? ~opr_b : opr_b;
 // Add / Sub
 // ------------------------------------------------------------
 
-wire [XL:0] addsub_output   = opr_a + opr_b_n + {{XL{1'b0}},op_sub} ;
+// Zba: optionally zero-extend the low word of opr_a, then shift it.
+wire [XL:0] opr_a_uw        = op_uw ? {32'b0, opr_a[31:0]} : opr_a  ;
+
+wire [XL:0] opr_a_add       =
+    op_sh1add   ? {opr_a_uw[XL-1:0], 1'b0}  :
+    op_sh2add   ? {opr_a_uw[XL-2:0], 2'b0}  :
+    op_sh3add   ? {opr_a_uw[XL-3:0], 3'b0}  :
+                   opr_a_uw                 ;
+
+wire [XL:0] addsub_output   = opr_a_add + opr_b_n + {{XL{1'b0}},op_sub};
 assign      add_out         = addsub_output                         ;
 
 wire [31:0] addsub_upper    = word  ? {32{addsub_output[   31]}}    :
@@ -93,6 +119,16 @@ assign      cmp_lt          = slt_lsb;
 
 wire [XL:0] slt_result      = {{XL{1'b0}}, op_slt ? slt_lsb : slt_lsbu};
 
+//
+// Min / Max
+// ------------------------------------------------------------
+
+wire        minmax_lt       = op_min || op_max ? slt_signed : slt_unsigned;
+
+wire        minmax_sel_a    = op_min || op_minu ? minmax_lt : !minmax_lt;
+
+wire [XL:0] minmax_result   = minmax_sel_a ? opr_a : opr_b;
+
 //
 // Bitwise Operations
 // ------------------------------------------------------------
@@ -119,7 +155,7 @@ wire sh_right  = op_ror || op_srl || op_sra;
 
 wire [2*XLEN-1:0] shift_in_r  = 
     !sh_rotate &&  word ? {64'b0       , {32{sbit}} , opr_a[31:0]} :
-    !sh_rotate && !word ? {{64{sbit}}  , opr_a                   } :
+    !sh_rotate && !word ? {{64{sbit}}  , opr_a_uw                } :
      sh_rotate && !word ? {opr_a       , opr_a                   } :
      sh_rotate &&  word ? {{XLEN{1'b0}}, opr_a[31:0], opr_a[31:0]} :
                         0                                       ;
@@ -226,7 +262,22 @@ wire [XL:0] gorc_3 = 0;
 
 wire [XL:0] gorc_4 = 0;
 
-wire [XL:0] gorc_7 = 0;
+function [7:0] or_combine_byte;
+    input [7:0] i;
+    or_combine_byte = {8{|i}};
+endfunction
+
+// OR-combine bits in bytes (orc.b)
+wire [XL:0] gorc_7 = {
+    or_combine_byte(opr_a[7*8+:8]),
+    or_combine_byte(opr_a[6*8+:8]),
+    or_combine_byte(opr_a[5*8+:8]),
+    or_combine_byte(opr_a[4*8+:8]),
+    or_combine_byte(opr_a[3*8+:8]),
+    or_combine_byte(opr_a[2*8+:8]),
+    or_combine_byte(opr_a[1*8+:8]),
+    or_combine_byte(opr_a[0*8+:8])
+};
 
 wire [XL:0] gorc_result =
     shamt == 6'd3  ? gorc_3 :
@@ -263,6 +314,76 @@ generate for(b=0; b < 8; b=b+1) begin
     assign xperm_b_result[b*8+:8] = |idx_hi ? 8'b0 : xperm_b_lut[idx_n];
 end endgenerate
 
+//
+// Count leading / trailing zeros and set bits
+// ------------------------------------------------------------
+
+function [6:0] count_lead_zeros;
+    input [XL:0] i;
+    integer      k;
+    reg          found;
+    begin
+        count_lead_zeros = 0;
+        found            = 0;
+        for(k = XL; k >= 0; k = k - 1) begin
+            found            = found || i[k];
+            count_lead_zeros = count_lead_zeros + {6'b0, !found};
+        end
+    end
+endfunction
+
+function [6:0] count_ones;
+    input [XL:0] i;
+    integer      k;
+    begin
+        count_ones = 0;
+        for(k = 0; k <= XL; k = k + 1) begin
+            count_ones = count_ones + {6'b0, i[k]};
+        end
+    end
+endfunction
+
+// ctz is a clz of the bit-reversed operand.
+wire [XL:0] opr_a_rev;
+
+genvar r;
+generate for(r = 0; r < XLEN; r = r + 1) begin
+    assign opr_a_rev[r] = opr_a[XL-r];
+end endgenerate
+
+// Word versions count into the upper half, padded so they stop at 32.
+wire [XL:0] clz_in          =
+    op_ctz &&  word ? {opr_a_rev[XL:32], 32'hFFFF_FFFF} :
+    op_ctz && !word ?  opr_a_rev                        :
+              word  ? {opr_a    [31: 0], 32'hFFFF_FFFF} :
+                       opr_a                            ;
+
+wire [XL:0] cpop_in         = word ? {32'b0, opr_a[31:0]} : opr_a;
+
+wire [XL:0] count_result    = {57'b0,
+    op_cpop ? count_ones(cpop_in) : count_lead_zeros(clz_in)
+};
+
+//
+// Sign extension
+// ------------------------------------------------------------
+
+wire [XL:0] sext_result     =
+    {XLEN{op_sextb}} & {{56{opr_a[ 7]}}, opr_a[ 7:0]} |
+    {XLEN{op_sexth}} & {{48{opr_a[15]}}, opr_a[15:0]} ;
+
+//
+// Single bit operations
+// ------------------------------------------------------------
+
+wire [XL:0] bit_mask        = {{XL{1'b0}}, 1'b1} << shamt;
+
+wire [XL:0] bit_result      =
+    {XLEN{op_bclr}} & (opr_a & ~bit_mask)          |
+    {XLEN{op_bset}} & (opr_a |  bit_mask)          |
+    {XLEN{op_binv}} & (opr_a ^  bit_mask)          |
+    {XLEN{op_bext}} & {{XL{1'b0}}, |(opr_a & bit_mask)};
+
 
 //
 // Result multiplexing
@@ -272,6 +393,8 @@ wire sel_addsub = op_add || op_sub  ;
 wire sel_slt    = op_slt || op_sltu ;
 wire sel_shift  = op_sll || op_sra  || op_srl || op_ror || op_rol;
 wire sel_pack   = op_pack|| op_packh|| op_packu;
+wire sel_count  = op_clz || op_ctz  || op_cpop;
+wire sel_minmax = op_min || op_minu || op_max || op_maxu;
 
 assign result =
                          bitwise_result             |
@@ -282,6 +405,10 @@ assign result =
     {XLEN{sel_pack  }} & pack_result                |
     {XLEN{sel_addsub}} & addsub_result              |
     {XLEN{sel_slt   }} & slt_result                 |
-    {XLEN{sel_shift }} & shift_result               ;
+    {XLEN{sel_shift }} & shift_result               |
+    {XLEN{sel_count }} & count_result               |
+    {XLEN{sel_minmax}} & minmax_result              |
+                         sext_result                |
+                         bit_result                 ;
 
 endmodule
@@ -74,6 +74,7 @@ parameter XLEN              = 64, // Must be one of: 32, 64.
 parameter SAES_ENC_EN       = 1 , // Enable AES encrypt instructions
 parameter SAES_DEC_EN       = 1 , // Enable AES decrypt instructions
 parameter SAES64_SBOXES     = 8 , // saes64 sbox instances. Valid values: 8,4
+parameter SBOX_SHARE_SM4    = 0 , // ssm4 shares an saes64 sbox. 8 sboxes only.
 parameter SSHA256_EN        = 1 , // Enable the ssha256.* instructions.
 parameter SSHA512_EN        = 1 , // Enable the ssha256.* instructions.
 parameter SSM3_EN           = 1 , // Enable the ssm3.* instructions.
@@ -121,6 +122,15 @@ output wire [ XLEN-1:0] rd
 localparam XL   = XLEN -  1  ;
 localparam RV64 = XLEN == 64 ;
 
+// Only share an sbox when both units exist and all 8 AES sboxes do.
+localparam SBOX_SHARE = SBOX_SHARE_SM4 && SAES64_SBOXES == 8 &&
+                        SSM4_EN && (SAES_ENC_EN || SAES_DEC_EN);
+
+// Shared SM4 sbox input/output.
+wire        ssm4_valid      ;
+wire [ 7:0] ssm4_sbox_in    ;
+wire [ 7:0] ssm4_sbox_out   ;
+
 `define GATE_INPUTS(LEN,SEL,SIG) \
     (LOGIC_GATING ? ({LEN{SEL}} & SIG[LEN-1:0]) : \
                                   SIG[LEN-1:0]  )
@@ -268,7 +278,8 @@ generate if(SAES_DEC_EN || SAES_ENC_EN ) begin  : saes64_implemented
 
     riscv_crypto_fu_saes64 #(
         .SAES_DEC_EN  (SAES_DEC_EN  ), // Enable saes64 decrypt instructions.
-        .SAES64_SBOXES(SAES64_SBOXES)  // sbox instances. Valid values: 8
+        .SAES64_SBOXES(SAES64_SBOXES), // sbox instances. Valid values: 8
+        .SM4_SBOX     (SBOX_SHARE   )  // Share sbox 0 with ssm4.
     ) i_riscv_crypto_fu_saes64 (
         .g_clk          (g_clk          ), // Global clock
         .g_resetn       (g_resetn       ), // Synchronous active low reset.
@@ -284,7 +295,10 @@ generate if(SAES_DEC_EN || SAES_ENC_EN ) begin  : saes64_implemented
         .op_saes64_decs (op_saes64_decs ), // RV64 AES Decrypt SBox
         .op_saes64_decsm(op_saes64_decsm), // RV64 AES Decrypt SBox + MixCols
         .rd             (saes64_result  ), // output register value.
-        .ready          (saes64_ready   )  // Compute finished?
+        .ready          (saes64_ready   ), // Compute finished?
+        .sm4_valid      (ssm4_valid     ), // ssm4.* using the shared sbox.
+        .sm4_sbox_in    (ssm4_sbox_in   ), // Shared sbox input
+        .sm4_sbox_out   (ssm4_sbox_out  )  // Shared sbox output
     );
 
 end else begin : saes64_not_implemented
@@ -292,6 +306,7 @@ end else begin : saes64_not_implemented
     assign saes64_ready     = 1'b0;
     assign saes64_result    = {XLEN{1'b0}};
     assign saes64_valid     = 1'b0;
+    assign ssm4_sbox_out    = 8'b0;
 
 end endgenerate
 
@@ -300,7 +315,6 @@ end endgenerate
 // SSM4 Instructions
 // ------------------------------------------------------------
 
-wire        ssm4_valid    ;
 wire [31:0] ssm4_rs1      = `GATE_INPUTS(32, ssm4_valid, rs1);
 wire [31:0] ssm4_rs2      = `GATE_INPUTS(32, ssm4_valid, rs2);
 wire [ 1:0] ssm4_bs       = imm[ 1:0];
@@ -313,7 +327,9 @@ generate if(SSM4_EN) begin: ssm4_implemented
 
     assign      ssm4_valid = op_ssm4_ks || op_ssm4_ed;
 
-    riscv_crypto_fu_ssm4 i_riscv_crypto_fu_ssm4 (
+    riscv_crypto_fu_ssm4 #(
+        .EXT_SBOX  (SBOX_SHARE  )  // Use the shared saes64 sbox.
+    ) i_riscv_crypto_fu_ssm4 (
         .valid     (ssm4_valid  ), // Inputs valid?
         .rs1       (ssm4_rs1    ), // Source register 1
         .rs2       (ssm4_rs2    ), // Source register 2
@@ -321,7 +337,9 @@ generate if(SSM4_EN) begin: ssm4_implemented
         .op_ssm4_ks(op_ssm4_ks  ), // Do ssm4.ks instruction
         .op_ssm4_ed(op_ssm4_ed  ), // Do ssm4.ed instruction
         .result    (ssm4_rd32   ), // Writeback result
-        .ready     (ssm4_ready  )  //
+        .ready     (ssm4_ready  ), //
+        .ext_sbox_in (ssm4_sbox_in ), // Shared sbox input
+        .ext_sbox_out(ssm4_sbox_out)  // Shared sbox output
     );
 
     if(RV64) begin
@@ -339,6 +357,7 @@ end else begin : ssm4_not_implemented
     assign ssm4_ready   = 1'b0;
     assign ssm4_result  = {XLEN{1'b0}};
     assign ssm4_valid   = 1'b0;
+    assign ssm4_sbox_in = 8'b0;
 
 end endgenerate
 
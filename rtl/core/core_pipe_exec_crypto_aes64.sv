@@ -39,7 +39,8 @@
 //
 module riscv_crypto_fu_saes64 #(
 parameter SAES_DEC_EN = 1 , // Enable the saes64 decrypt instructions.
-parameter SAES64_SBOXES = 8   // saes64 sbox instances. Valid values: 8,4
+parameter SAES64_SBOXES = 8 , // saes64 sbox instances. Valid values: 8,4
+parameter SM4_SBOX    = 0   // Share sbox 0 with ssm4. Needs 8 sboxes.
 )(
 
 input  wire         g_clk           , // Global clock
@@ -59,7 +60,11 @@ input  wire         op_saes64_decs  , // RV64 AES Decrypt SBox
 input  wire         op_saes64_decsm , // RV64 AES Decrypt SBox + MixCols
 
 output wire [ 63:0] rd              , // output destination register value.
-output wire         ready             // Compute finished?
+output wire         ready           , // Compute finished?
+
+input  wire         sm4_valid       , // ssm4.* is using the shared sbox.
+input  wire [  7:0] sm4_sbox_in     , // Shared sbox input  for ssm4.*
+output wire [  7:0] sm4_sbox_out      // Shared sbox output for ssm4.*
 
 );
 
@@ -228,10 +233,44 @@ assign rd =
 
 genvar i;
 
-generate if(SAES64_SBOXES == 8) begin : saes64_8_sboxes
+generate if(SAES64_SBOXES == 8 && SM4_SBOX) begin : saes64_8_shared_sboxes
+
+    // All sboxes complete in a single cycle. Each lane shares one
+    // non-linear layer between the AES, AES^-1 and SM4 sboxes.
+    assign sbox_ready   = 1'b1;
+
+    wire   sbox_dec     = SAES_DEC_EN && op_dec;
+
+    for(i = 0; i < 8; i = i + 1) begin
+
+        wire       lane_sm4 = i == 0 && sm4_valid;
+
+        wire [7:0] lane_in  = lane_sm4 ? sm4_sbox_in    :
+                              sbox_dec ? sb_inv_in [i]  :
+                                         sb_fwd_in [i]  ;
+
+        wire [7:0] lane_out ;
+
+        riscv_crypto_aes_sm4_sbox i_sbox (
+            .aes(!lane_sm4 ),
+            .sm4( lane_sm4 ),
+            .dec( sbox_dec ),
+            .in ( lane_in  ),
+            .out( lane_out )
+        );
+
+        assign sb_fwd_out[i] = lane_out;
+        assign sb_inv_out[i] = lane_out;
+
+    end
+
+    assign sm4_sbox_out = sb_fwd_out[0];
+
+end else if(SAES64_SBOXES == 8) begin : saes64_8_sboxes
     
     // All sboxes complete in a single cycle.
-    assign sbox_ready = 1'b1;
+    assign sbox_ready   = 1'b1;
+    assign sm4_sbox_out = 8'b0;
 
     for(i = 0; i < 8; i = i + 1) begin
 
@@ -272,6 +311,8 @@ end else if(SAES64_SBOXES == 4) begin : saes64_4_sboxes
 
     assign sbox_ready = sbox_hi && sbox_instr || !sbox_instr;
 
+    assign sm4_sbox_out = 8'b0;
+
     for(i = 0; i < 4; i = i + 1) begin
 
         always @(posedge g_clk) begin
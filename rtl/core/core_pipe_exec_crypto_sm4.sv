@@ -32,7 +32,9 @@
 //   ssm4.ks        |   x     |    x
 //   ssm4.ed        |   x     |    x
 //
-module riscv_crypto_fu_ssm4 (
+module riscv_crypto_fu_ssm4 #(
+parameter EXT_SBOX = 0 // Use an SBox outside this module. See ext_sbox_*
+)(
 
 input  wire         valid       , // Inputs valid?
 input  wire [31:0]  rs1         , // Source register 1
@@ -43,7 +45,10 @@ input  wire         op_ssm4_ks  , // Do ssm4.ks instruction
 input  wire         op_ssm4_ed  , // Do ssm4.ed instruction
 
 output wire [31:0]  result      , // Writeback result
-output wire         ready         //
+output wire         ready       , //
+
+output wire [ 7:0]  ext_sbox_in , // Shared SBox input.
+input  wire [ 7:0]  ext_sbox_out  // Shared SBox output, if EXT_SBOX.
 
 );
 
@@ -99,9 +104,19 @@ assign      result      = rot_out ^ rs1 ;
 
 //
 // Submodule - SBox
-riscv_crypto_sm4_sbox i_sm4_sbox (
-    .in (sbox_in ),
-    .out(sbox_out)
-);
+assign ext_sbox_in = sbox_in;
+
+generate if(EXT_SBOX) begin : ext_sbox
+
+    assign sbox_out = ext_sbox_out;
+
+end else begin : int_sbox
+
+    riscv_crypto_sm4_sbox i_sm4_sbox (
+        .in (sbox_in ),
+        .out(sbox_out)
+    );
+
+end endgenerate
 
 endmodule
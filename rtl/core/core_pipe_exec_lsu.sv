@@ -4,7 +4,15 @@
 //
 //  Responsible for all data memory accesses
 //
-module core_pipe_exec_lsu (
+//  With MISALIGNED_HW set, misaligned accesses do not trap. Accesses
+//  which fit inside one aligned double-word are done in one beat.
+//  Accesses which cross a double-word boundary are split into two
+//  aligned beats. The first beat's read data and error are held in
+//  split_rdata / split_err for the writeback stage to merge.
+//
+module core_pipe_exec_lsu #(
+parameter MISALIGNED_HW = 0 // Split misaligned accesses rather than trap.
+)(
 
 input   wire                g_clk       , // Global clock enable.
 input   wire                g_resetn    , // Global synchronous reset
@@ -26,6 +34,11 @@ input  wire                 mprv_u      , // Currently in User    mode.
 output  wire                ready       , // Request processed
 output  wire                trap_addr   , // Address alignment error
 
+output  wire                split_first , // First beat of a split access.
+output  wire                s3_split    , // Instr in writeback was split.
+output  wire [        XL:0] split_rdata , // First beat read data.
+output  wire                split_err   , // First beat error.
+
 output wire                 dmem_req    , // Memory request
 output wire                 dmem_rtype  , // Request type. 0=instr,1=data.
 output wire [ MEM_ADDR_R:0] dmem_addr   , // Memory request address
@@ -49,14 +62,14 @@ always @(posedge g_clk) begin
         finished <= 1'b0;
     end else if(new_instr) begin
         finished <= 1'b0;
-    end else if(req_sent) begin
+    end else if(req_sent && !split_first) begin
         finished <= 1'b1;
     end
 end
 
 wire    req_sent    = dmem_req && dmem_gnt;
 
-assign  ready       = req_sent || valid && trap_addr;
+assign  ready       = req_sent && !split_first || valid && trap_addr;
 
 
 //
@@ -67,7 +80,7 @@ wire    addr_err =
     d_word      &&  |addr[1:0]      ||
     d_half      &&   addr[  0]      ;
 
-wire    txn_okay = !addr_err        ;
+wire    txn_okay = !trap_addr       ;
 
 //
 // Write data positioning.
@@ -78,19 +91,100 @@ wire [ 5:0] data_shift     = {addr[2:0], 3'b000};
 //
 // Simple bus assignments.
 
-assign  trap_addr    = addr_err && valid    ;
-
 assign  dmem_wen     = store;
 
 assign  dmem_req     = valid && txn_okay && !finished;
 
 assign  dmem_rtype   = 1'b0; // Only request data from here.
 
-assign  dmem_addr    = {addr[MEM_ADDR_R:3], 3'b000};
+generate if(MISALIGNED_HW) begin : gen_misaligned_hw
+
+    // Byte lanes touched by the access, across two double-words.
+    wire [ 7:0] size_mask   = {{4{d_double}}, {2{d_double || d_word}},
+                               d_double || d_word || d_half, 1'b1};
+
+    wire [15:0] strb_wide   = {8'b0, size_mask} << addr[2:0];
+
+    wire [127:0] wdata_wide = {64'b0, wdata} << data_shift;
+
+    wire        split       = |strb_wide[15:8];
+
+    reg         beat_1      ; // Second beat of a split access.
+
+    always @(posedge g_clk) begin
+        if(!g_resetn || new_instr || !valid) begin
+            beat_1 <= 1'b0;
+        end else if(req_sent && split_first) begin
+            beat_1 <= 1'b1;
+        end
+    end
+
+    assign  split_first  = split && !beat_1;
+
+    assign  trap_addr    = 1'b0;
+
+    assign  dmem_addr    = {addr[MEM_ADDR_R:3] + {{MEM_ADDR_W-4{1'b0}},beat_1},
+                            3'b000};
+
+    assign  dmem_wdata   = beat_1 ? wdata_wide[127:64] : wdata_wide[63:0];
+
+    assign  dmem_strb    = !valid ? 8'b0                :
+                           beat_1 ? strb_wide[15: 8]    :
+                                    strb_wide[ 7: 0]    ;
+
+    // Capture the first beat response, the cycle after it is granted.
+    reg         p_first     ;
+
+    always @(posedge g_clk) begin
+        if(!g_resetn) begin
+            p_first <= 1'b0;
+        end else begin
+            p_first <= req_sent && split_first;
+        end
+    end
+
+    reg  [XL:0] r_split_rdata;
+    reg         r_split_err ;
+    reg         r_s3_split  ;
+
+    assign      split_rdata = r_split_rdata;
+    assign      split_err   = r_split_err  ;
+    assign      s3_split    = r_s3_split   ;
+
+    always @(posedge g_clk) begin
+        if(!g_resetn) begin
+            r_split_err     <= 1'b0;
+        end else if(p_first) begin
+            r_split_rdata   <= dmem_rdata;
+            r_split_err     <= dmem_err;
+        end
+    end
+
+    always @(posedge g_clk) begin
+        if(!g_resetn) begin
+            r_s3_split      <= 1'b0;
+        end else if(new_instr) begin
+            r_s3_split      <= valid && split;
+        end
+    end
+
+end else begin : gen_misaligned_trap
+
+    assign  split_first  = 1'b0;
+
+    assign  trap_addr    = addr_err && valid;
+
+    assign  dmem_addr    = {addr[MEM_ADDR_R:3], 3'b000};
+
+    assign  dmem_wdata   = wdata    << data_shift;
+
+    assign  dmem_strb    = valid ? strb : 8'b0;
 
-assign  dmem_wdata   = wdata    << data_shift           ;
+    assign  s3_split     = 1'b0;
+    assign  split_rdata  = {XLEN{1'b0}};
+    assign  split_err    = 1'b0;
 
-assign  dmem_strb    = valid ? strb : 8'b0              ;
+end endgenerate
 
 always @(posedge g_clk) if(!g_resetn) begin
     dmem_prv  <= {1'b1  , 1'b0  }  ;
@@ -56,7 +56,9 @@ assign      rd          = any_mul   ? result_mul  :
                           any_clmul ? result_clmul:
                                       result_div  ;
 
-assign      ready       = any_mul   ? mul_done    :
+wire        mul_ready   = MUL_IMPL == MUL_IMPL_ITER ? mul_done : fmul_done;
+
+assign      ready       = any_mul   ? mul_ready   :
                           any_div   ? div_done    : 
                           any_clmul ? clmul_done  : 
                                       1'b0        ;
@@ -94,7 +96,9 @@ always @(posedge g_clk) begin
     end else if(mul_run) begin
         s_rs1       <= n_rs1_mul;
         s_rs2       <= n_rs2_mul;
-        if(!n_mul_done || MUL_UNROLL == 1) begin
+        if(n_mul_done && mul_narrow) begin
+            mdu_state   <= mul_narrow_state;
+        end else if(!n_mul_done || MUL_UNROLL == 1) begin
             mdu_state   <= n_mul_state;
         end
     end else if(clmul_run) begin
@@ -125,16 +129,18 @@ always @(posedge g_clk) begin
     end else if (mdu_start) begin
         mdu_run     <= 1'b1;
         mdu_done    <= 1'b0;
-        mdu_ctr     <= op_word ? 'd32 : 'd64;
+        mdu_ctr     <= op_word || n_mul_narrow ? 'd32 : 'd64;
     end else if(mdu_run) begin
         if(any_mul   && mdu_ctr == MUL_END    ||
            any_clmul && mdu_ctr == CLMUL_END  ||
            any_div   && mdu_ctr ==       0    ) begin
             mdu_done    <= n_mdu_done;
             mdu_run     <= 1'b0;
+        end else if(any_div) begin
+            mdu_ctr     <= n_div_ctr;
         end else begin
             mdu_ctr     <= mdu_ctr - (any_mul   ? MUL_UNROLL   : 
-                                      any_clmul ? CLMUL_UNROLL : 7'd1);
+                                      CLMUL_UNROLL             );
         end
     end
 end
@@ -192,16 +198,44 @@ end
 // Multiplier
 // ------------------------------------------------------------
 
+// Multiplier implementation:
+//  0 - Iterative shift/add, MUL_UNROLL bits per cycle.
+//  1 - Pipelined. Two partial products, then a final sum. 3 cycles.
+//  2 - Single "*" between registers, for FPGA DSP block inference.
+parameter  MUL_IMPL       = 0;
+localparam MUL_IMPL_ITER  = 0;
+localparam MUL_IMPL_PIPE  = 1;
+localparam MUL_IMPL_DSP   = 2;
+
 parameter MUL_UNROLL = 4;
 localparam MUL_END   = (MUL_UNROLL & 'd1) ==0 ? 0 : 1;
 
-wire        mul_start = valid && any_mul && !mul_run && !mul_done;
+wire        mul_start = valid && any_mul && !mul_run && !mul_done &&
+                        MUL_IMPL == MUL_IMPL_ITER;
 wire        mul_hi    = op_mulh || op_mulhu || op_mulhsu;
 
 assign      result_mul= 
-    op_word ? {{32{mdu_state[XL]}}, mdu_state[XL:32]} :
-    mul_hi  ?                       mdu_state[MW:64]  :
-                                    mdu_state[XL: 0]  ;
+    MUL_IMPL != MUL_IMPL_ITER   ? fmul_result                       :
+    op_word                     ? {{32{mdu_state[XL]}}, mdu_state[XL:32]} :
+    mul_hi                      ?                       mdu_state[MW:64]  :
+                                                        mdu_state[XL: 0]  ;
+
+//
+// Narrow operand early-out. If the upper half of rs2 is zero, only 32
+// iterations are needed. The partial product is then shifted down into
+// place on the final cycle. Only possible when MUL_UNROLL divides 32.
+localparam  MUL_NARROW_EN   = (32 % MUL_UNROLL) == 0;
+
+wire        n_mul_narrow    = MUL_NARROW_EN && mul_start && !op_word &&
+                              ~|rs2[XL:32];
+
+reg         mul_narrow      ;
+
+wire [MW:0] mul_fin_state   = MUL_UNROLL == 1 ? n_mul_state : mdu_state;
+
+wire        mul_narrow_sign = lhs_signed && mul_fin_state[MW];
+
+wire [MW:0] mul_narrow_state= {{32{mul_narrow_sign}}, mul_fin_state[MW:32]};
 
 wire      n_mul_done= mdu_ctr == MUL_END && mul_run;
 
@@ -232,7 +266,7 @@ always @(*) begin
     for(i = 0; i < MUL_UNROLL; i = i + 1) begin
         sub_last    = i == (MUL_UNROLL - 1) &&
                       mdu_ctr == MUL_UNROLL &&
-                      rhs_signed && s_rs2[MUL_UNROLL-1];
+                      rhs_signed && s_rs2[MUL_UNROLL-1] && !mul_narrow;
         to_add      = s_rs2[i]   ? s_rs1      : 64'b0       ;
         to_add_sign = op_word    ? to_add[31] : to_add[XL]  ;
         mul_l_sign  = lhs_signed && n_mul_state[MW]         ;
@@ -253,9 +287,11 @@ always @(posedge g_clk) begin
     if (!g_resetn || flush) begin
         mul_run     <= 1'b0;
         mul_done    <= 1'b0;
+        mul_narrow  <= 1'b0;
     end else if (mul_start) begin
         mul_run     <= 1'b1;
         mul_done    <= 1'b0;
+        mul_narrow  <= n_mul_narrow;
     end else if(mul_run) begin
         if(mdu_ctr == MUL_END) begin
             mul_done    <= n_mul_done;
@@ -264,6 +300,91 @@ always @(posedge g_clk) begin
     end
 end
 
+//
+// Fast multiplier
+// ------------------------------------------------------------
+//
+//  Used when MUL_IMPL is not MUL_IMPL_ITER. Operands are registered on
+//  the first cycle, so the multiplier never sees the decode path.
+//  The pipelined variant returns mulw results one cycle early, straight
+//  from the low partial product.
+//
+
+wire        fmul_start  = valid && any_mul && !fmul_run && !fmul_done &&
+                          MUL_IMPL != MUL_IMPL_ITER;
+
+reg         fmul_run    ; // Is the fast multiplier currently running?
+reg         fmul_done   ; // Is the fast multiplier complete.
+reg         fmul_ctr    ; // Which pipeline stage are we in.
+reg         fmul_word   ; // Operating on words.
+reg         fmul_hi     ; // Return the high half of the result.
+
+reg  signed [XLEN  :0] fmul_a   ; // Sign extended operands.
+reg  signed [XLEN  :0] fmul_b   ;
+
+reg  signed [XLEN+33:0] fmul_pp_lo; // fmul_a * fmul_b[31:0]
+reg  signed [XLEN+33:0] fmul_pp_hi; // fmul_a * fmul_b[64:32]
+reg  signed [2*XLEN+1:0] fmul_prod; // Full product.
+
+// Final value of fmul_ctr before the result is ready.
+wire        fmul_last   = MUL_IMPL == MUL_IMPL_PIPE && !fmul_word;
+
+wire [31:0] fmul_lo32   = MUL_IMPL == MUL_IMPL_PIPE ? fmul_pp_lo[31:0] :
+                                                      fmul_prod [31:0] ;
+
+wire [XL:0] fmul_result =
+    fmul_word   ? {{32{fmul_lo32[31]}}, fmul_lo32[31:0]} :
+    fmul_hi     ? fmul_prod[MW:XLEN]                     :
+                  fmul_prod[XL:   0]                     ;
+
+always @(posedge g_clk) begin
+    if (!g_resetn || flush) begin
+        fmul_run    <= 1'b0;
+        fmul_done   <= 1'b0;
+        fmul_ctr    <= 1'b0;
+    end else if (fmul_start) begin
+        fmul_run    <= 1'b1;
+        fmul_done   <= 1'b0;
+        fmul_ctr    <= 1'b0;
+        fmul_word   <= op_word;
+        fmul_hi     <= mul_hi;
+        fmul_a      <= {lhs_signed && rs1[XL], rs1};
+        fmul_b      <= {rhs_signed && rs2[XL], rs2};
+    end else if(fmul_run) begin
+        fmul_ctr    <= 1'b1;
+        if(fmul_ctr == fmul_last) begin
+            fmul_done   <= 1'b1;
+            fmul_run    <= 1'b0;
+        end
+    end
+end
+
+generate if(MUL_IMPL == MUL_IMPL_PIPE) begin : gen_mul_pipe
+
+    wire signed [32:0] fmul_b_lo = {1'b0, fmul_b[31:0]};
+    wire signed [32:0] fmul_b_hi = fmul_b[XLEN:32];
+
+    always @(posedge g_clk) begin
+        if(fmul_run && fmul_ctr == 1'b0) begin
+            fmul_pp_lo <= fmul_a * fmul_b_lo;
+            fmul_pp_hi <= fmul_a * fmul_b_hi;
+        end
+        if(fmul_run && fmul_ctr == 1'b1) begin
+            fmul_prod  <= {{32{fmul_pp_lo[XLEN+33]}}, fmul_pp_lo} +
+                          {fmul_pp_hi, 32'b0};
+        end
+    end
+
+end else if(MUL_IMPL == MUL_IMPL_DSP) begin : gen_mul_dsp
+
+    always @(posedge g_clk) begin
+        if(fmul_run) begin
+            fmul_prod  <= fmul_a * fmul_b;
+        end
+    end
+
+end endgenerate
+
 
 //
 // Divider
@@ -272,6 +393,14 @@ end
 // rs1 = dividend
 // rs2 = divisor
 
+// Number of quotient bits computed per cycle. 1 or 2.
+parameter DIV_UNROLL    = 1;
+
+// Skip iterations which cannot produce a quotient bit, by comparing the
+// positions of the most significant set bits of the divisor and
+// dividend. Also finishes divide by zero immediately.
+parameter DIV_NORMALISE = 1;
+
 wire    [MW: 0]  divisor = mdu_state ;
 reg     [MW: 0]n_divisor ;
 
@@ -304,10 +433,44 @@ wire            div_sign_rhs= div_signed && (op_word ? rs2[31] : rs2[XL]);
 wire            div_div     = op_div || op_divu;
 wire            div_rem     = op_rem || op_remu;
 
-wire            div_less    = divisor <= {{XLEN{1'b0}},dividend};
+//
+// Normalisation. The first cycle of div_run skips iterations.
+// ------------------------------------------------------------
+
+reg             div_norm    ; // First cycle of div_run, normalise.
 
-// Used to set bits of the quotient.
-wire    [XL: 0] qmask       = 64'b1 << (mdu_ctr-1);
+reg     [ 6: 0] div_msb_dvs ; // Index of MSB set in divisor register.
+reg     [ 6: 0] div_msb_dvd ; // Index of MSB set in dividend.
+
+integer k;
+always @(*) begin
+    div_msb_dvs = 7'd0;
+    div_msb_dvd = 7'd0;
+    for(k = 0; k < MLEN; k = k + 1) begin
+        if(divisor[k]) div_msb_dvs = k;
+    end
+    for(k = 0; k < XLEN; k = k + 1) begin
+        if(dividend[k]) div_msb_dvd = k;
+    end
+end
+
+wire            div_by_zero = ~|divisor;
+wire            div_dvd_zero= ~|dividend;
+
+// Number of iterations which can only produce zero quotient bits.
+wire    [ 6: 0] div_skip    = div_msb_dvs > div_msb_dvd ?
+                              div_msb_dvs - div_msb_dvd : 7'd0;
+
+// Quotient is known without iterating: zero, or all ones for x/0.
+wire            div_trivial = div_by_zero || div_dvd_zero ||
+                              div_skip >= mdu_ctr;
+
+wire    [ 6: 0] div_step    = mdu_ctr < DIV_UNROLL ? mdu_ctr : DIV_UNROLL;
+
+wire    [ 6: 0] n_div_ctr   =
+    !div_norm   ? mdu_ctr - div_step    :
+    div_trivial ? 7'd0                  :
+                  mdu_ctr - div_skip    ;
 
 // Is rs2 *not* zero? Used to determine sign of output.
 wire            div_rs2_nzw = |rs2[31:0];
@@ -331,10 +494,14 @@ assign         result_div   =
 
 //
 // Next divider state values.
+integer         u       ;
+reg     [ 6: 0] div_ctr ; // Iteration counter within an unrolled step.
+
 always @(*) begin
     n_dividend = dividend;
     n_quotient = quotient;
     n_divisor  = divisor >> 1;
+    div_ctr    = mdu_ctr;
 
     if(n_div_start) begin
         n_dividend = rs1;
@@ -352,11 +519,26 @@ always @(*) begin
       end
       n_quotient  = 'b0;
 
+    end else if(div_norm) begin
+
+        if(div_by_zero) begin
+            n_quotient = {XLEN{1'b1}};
+        end
+        n_divisor  = divisor >> div_skip;
+
     end else if(div_run) begin
 
-        if(div_less && !n_div_done) begin
-            n_dividend = dividend - divisor[XL:0];
-            n_quotient = quotient | qmask;
+        n_divisor  = divisor;
+
+        for(u = 0; u < DIV_UNROLL; u = u + 1) begin
+            if(div_ctr != 0) begin
+                if(n_divisor <= {{XLEN{1'b0}},n_dividend}) begin
+                    n_dividend = n_dividend - n_divisor[XL:0];
+                    n_quotient = n_quotient | (64'b1 << (div_ctr-1));
+                end
+                n_divisor  = n_divisor >> 1;
+                div_ctr    = div_ctr   -  1;
+            end
         end
 
     end
@@ -376,9 +558,12 @@ always @(posedge g_clk) begin
     if(!g_resetn || flush) begin
         div_run     <= 1'b0;
         div_done    <= 1'b0;
+        div_norm    <= 1'b0;
     end else if(div_start) begin
         div_run     <= 1'b1;
+        div_norm    <= DIV_NORMALISE;
     end else if(div_run) begin
+        div_norm    <= 1'b0;
         if(mdu_ctr == 0) begin
             div_done<= n_div_done;
             div_run <= 1'b0;
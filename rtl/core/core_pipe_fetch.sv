@@ -32,7 +32,14 @@ output wire                 s1_i32bit   , // 32 bit instruction?
 output wire [  FD_IBUF_R:0] s1_instr    , // Instruction to be decoded
 output wire [   FD_ERR_R:0] s1_ferr     , // Fetch bus error?
 input  wire                 s1_eat_2    , // Decode eats 2 bytes
-input  wire                 s1_eat_4      // Decode eats 4 bytes
+input  wire                 s1_eat_4    , // Decode eats 4 bytes
+
+output wire                 s1_b_i16bit , // Second 16 bit instruction?
+output wire                 s1_b_i32bit , // Second 32 bit instruction?
+output wire [  FD_IBUF_R:0] s1_b_instr  , // Second instruction to decode
+output wire [   FD_ERR_R:0] s1_b_ferr   , // Second instr fetch bus error?
+input  wire                 s1_b_eat_2  , // Decode eats 2 more bytes
+input  wire                 s1_b_eat_4    // Decode eats 4 more bytes
 
 );
 
@@ -43,6 +50,18 @@ input  wire                 s1_eat_4      // Decode eats 4 bytes
 // Inital address of the program counter post reset.
 parameter   PC_RESET_ADDRESS      = 'h10000000;
 
+// Present a second instruction to the decoder for dual issue.
+parameter   DUAL_ISSUE            = 0;
+
+// Size of the fetch buffer in bits. One of 128, 256 or 512.
+parameter   FETCH_BUFFER_DEPTH    = 128;
+
+// Issue the next sequential fetch while the previous one is still in
+// flight, so long as the buffer has room for both responses.
+parameter   FETCH_PREFETCH        = 0;
+
+localparam  FB_MAX_DEPTH          = FETCH_BUFFER_DEPTH / 8;
+
 //
 // Constant assignments.
 // ------------------------------------------------------------
@@ -150,8 +169,8 @@ end
 // When to flush the instruction fetch buffer?
 wire        buf_flush       = e_cf_change   ;
 
-wire [ 4:0]   buf_depth     ; // How many bytes are in the buffer?
-wire [ 4:0] n_buf_depth     ; //
+wire [ 6:0]   buf_depth     ; // How many bytes are in the buffer?
+wire [ 6:0] n_buf_depth     ; //
 
 wire [63:0] buf_data_in     = imem_rdata    ;
 wire        buf_error_in    = imem_err      ;
@@ -165,12 +184,27 @@ reg         buf_fill_8      ; // Load top 8 bytes of input data.
 
 wire [31:0] buf_data_out    ; // Data out of the buffer.
 wire [ 1:0] buf_error_out   ; // Is data tagged with fetch error?
+wire [31:0] buf_data_out_2  ; // Data out of the buffer, 2 byte offset.
+wire [ 1:0] buf_error_out_2 ; // Error bits, 2 byte offset.
+wire [31:0] buf_data_out_4  ; // Data out of the buffer, 4 byte offset.
+wire [ 1:0] buf_error_out_4 ; // Error bits, 4 byte offset.
 
-wire        buf_drain_2     = s1_eat_2;
-wire        buf_drain_4     = s1_eat_4;
+wire        s1_b_eat        = s1_b_eat_2 || s1_b_eat_4;
+
+wire        buf_drain_2     = s1_eat_2 && !s1_b_eat ;
+wire        buf_drain_4     = s1_eat_4 && !s1_b_eat || s1_eat_2 && s1_b_eat_2;
+wire        buf_drain_6     = s1_eat_2 && s1_b_eat_4|| s1_eat_4 && s1_b_eat_2;
+wire        buf_drain_8     = s1_eat_4 && s1_b_eat_4;
+
+// Bytes of buffer space to reserve before making another request: 8
+// for the new request, and 8 more for one granted this cycle.
+wire [ 7:0] buf_reserve     = {1'b0, n_buf_depth} + (e_imem_req ? 16 : 8);
 
 // Is the buffer ready to accept more data?
-wire        buf_ready       = n_buf_depth  <= 8 && !e_imem_req;
+wire        buf_ready       = FETCH_PREFETCH                        ?
+                              buf_reserve  <= FB_MAX_DEPTH          :
+                              n_buf_depth  <= FB_MAX_DEPTH - 8 &&
+                                              !e_imem_req           ;
 
 // Is there currently a 16 or 32 bit instruction in the buffer?
 assign      s1_i16bit       = buf_depth >= 2 && buf_data_out[1:0] != 2'b11;
@@ -180,6 +214,43 @@ assign      s1_i32bit       = buf_depth >= 4 && buf_data_out[1:0] == 2'b11;
 assign      s1_instr        = buf_data_out[31:0];
 assign      s1_ferr         = buf_error_out[1:0];
 
+// Halfwords written into the buffer this cycle. Only read by the
+// simulation testbench pipeline view.
+wire [ 2:0] pv_fill /*verilator public_flat_rd*/ =
+    !buf_fill_en ? 3'd0 :
+    buf_fill_8   ? 3'd4 :
+    buf_fill_6   ? 3'd3 :
+    buf_fill_4   ? 3'd2 :
+    buf_fill_2   ? 3'd1 :
+                   3'd0 ;
+
+//
+// Second instruction for the dual issue lane. It starts immediately
+// after the first instruction, and is only valid if the first one is.
+generate if(DUAL_ISSUE) begin : gen_dual_issue
+
+    wire [6:0] b_offset     = s1_i16bit ? 7'd2 : 7'd4;
+
+    assign s1_b_instr       = s1_i16bit ? buf_data_out_2  : buf_data_out_4 ;
+    assign s1_b_ferr        = s1_i16bit ? buf_error_out_2 : buf_error_out_4;
+
+    assign s1_b_i16bit      = (s1_i16bit || s1_i32bit)      &&
+                              buf_depth >= b_offset + 7'd2  &&
+                              s1_b_instr[1:0] != 2'b11      ;
+
+    assign s1_b_i32bit      = (s1_i16bit || s1_i32bit)      &&
+                              buf_depth >= b_offset + 7'd4  &&
+                              s1_b_instr[1:0] == 2'b11      ;
+
+end else begin : gen_single_issue
+
+    assign s1_b_instr       = {FD_IBUF_W{1'b0}};
+    assign s1_b_ferr        = {FD_ERR_W {1'b0}};
+    assign s1_b_i16bit      = 1'b0;
+    assign s1_b_i32bit      = 1'b0;
+
+end endgenerate
+
 reg         first_req_post_cf; // First request after a CF change.
 wire      n_first_req_post_cf =
     first_req_post_cf ? !e_imem_req :
@@ -224,7 +295,9 @@ end
 // Submodule instances
 // ------------------------------------------------------------
 
-core_pipe_fetch_buffer i_core_pipe_fetch_buffer (
+core_pipe_fetch_buffer #(
+.BUFFER_DEPTH_BITS(FETCH_BUFFER_DEPTH)
+) i_core_pipe_fetch_buffer (
 .g_clk       (g_clk           ), // Global clock
 .g_resetn    (g_resetn        ), // Global active low sync reset.
 .flush       (buf_flush       ), // Flush data from the buffer.
@@ -239,8 +312,14 @@ core_pipe_fetch_buffer i_core_pipe_fetch_buffer (
 .fill_8      (buf_fill_8      ), // Load top 8 bytes of input data.
 .data_out    (buf_data_out    ), // Data out of the buffer.
 .error_out   (buf_error_out   ), // Is data tagged with fetch error?
+.data_out_2  (buf_data_out_2  ), // Data out, offset by 2 bytes.
+.error_out_2 (buf_error_out_2 ), // Error bits, offset by 2 bytes.
+.data_out_4  (buf_data_out_4  ), // Data out, offset by 4 bytes.
+.error_out_4 (buf_error_out_4 ), // Error bits, offset by 4 bytes.
 .drain_2     (buf_drain_2     ), // Drain 2 bytes of data.
-.drain_4     (buf_drain_4     )  // Drain 4 bytes of data.
+.drain_4     (buf_drain_4     ), // Drain 4 bytes of data.
+.drain_6     (buf_drain_6     ), // Drain 6 bytes of data.
+.drain_8     (buf_drain_8     )  // Drain 8 bytes of data.
 );
 
 endmodule
@@ -3,16 +3,21 @@
 // Module: core_pipe_fetch_buffer
 //
 //  Fetch data buffer. Accepts between 0, 2, 4, 6 or 8 bytes per cycle, drains
-//  0, 2 or 4 bytes per cycle.
+//  0, 2, 4, 6 or 8 bytes per cycle. Draining 6 or 8 bytes is only used
+//  when two instructions are issued in the same cycle.
 //
-module core_pipe_fetch_buffer (
+//  The buffer holds BUFFER_DEPTH_BITS bits: one of 128, 256 or 512.
+//
+module core_pipe_fetch_buffer #(
+parameter BUFFER_DEPTH_BITS = 128 // Size of the buffer in bits.
+)(
 
 input  wire         g_clk       , // Global clock
 input  wire         g_resetn    , // Global active low sync reset.
 
 input  wire         flush       , // Flush data from the buffer.
-output reg  [ 4:0]  depth       , // How many bytes are in the buffer?
-output wire [ 4:0]  n_depth     , // Buffer depth for next cycle.
+output reg  [ 6:0]  depth       , // How many bytes are in the buffer?
+output wire [ 6:0]  n_depth     , // Buffer depth for next cycle.
 
 input  wire         fill_en     , // Buffer fill enable.
 input  wire [63:0]  data_in     , // Data in
@@ -24,14 +29,19 @@ input  wire         fill_8      , // Load top 8 bytes of input data.
 
 output wire [FD_IBUF_R:0]  data_out    , // Data out of the buffer.
 output wire [ FD_ERR_R:0]  error_out   , // Is data tagged with fetch error?
+output wire [FD_IBUF_R:0]  data_out_2  , // Data out, offset by 2 bytes.
+output wire [ FD_ERR_R:0]  error_out_2 , // Error bits, offset by 2 bytes.
+output wire [FD_IBUF_R:0]  data_out_4  , // Data out, offset by 4 bytes.
+output wire [ FD_ERR_R:0]  error_out_4 , // Error bits, offset by 4 bytes.
 input  wire         drain_2     , // Drain 2 bytes of data.
-input  wire         drain_4       // Drain 4 bytes of data.
+input  wire         drain_4     , // Drain 4 bytes of data.
+input  wire         drain_6     , // Drain 6 bytes of data.
+input  wire         drain_8       // Drain 8 bytes of data.
 
 );
 
 `include "core_common.svh"
 
-localparam BUFFER_DEPTH_BITS    = 128;
 localparam BR                   = BUFFER_DEPTH_BITS - 1;
 localparam ER                   = (BUFFER_DEPTH_BITS / 16) - 1;
 localparam MAX_DEPTH            = BUFFER_DEPTH_BITS / 8;
@@ -42,6 +52,13 @@ reg [ER:0]  e_buffer;   // Error buts storage.
 assign      data_out = d_buffer[FD_IBUF_R:0];
 assign      error_out= e_buffer[ FD_ERR_R:0];
 
+// Used to present a second instruction to the decoder, which starts
+// immediately after a 16 or 32-bit first instruction.
+assign      data_out_2  = d_buffer[FD_IBUF_R+16:16];
+assign      error_out_2 = e_buffer[ FD_ERR_R+ 1: 1];
+assign      data_out_4  = d_buffer[FD_IBUF_R+32:32];
+assign      error_out_4 = e_buffer[ FD_ERR_R+ 2: 2];
+
 //
 // Buffer Depth Tracking
 // ------------------------------------------------------------------
@@ -54,15 +71,15 @@ wire [3:0] bd_add = {
 };
 
 wire [3:0] bd_sub = {
-    1'b0                ,
-    drain_4             ,
-    drain_2             ,
+    drain_8             ,
+    drain_4 || drain_6  ,
+    drain_2 || drain_6  ,
     1'b0
 };
 
 assign n_depth = flush ? 0 : depth + bd_add - bd_sub;
 
-wire [4:0] shf_up = depth - bd_sub;
+wire [6:0] shf_up = depth - bd_sub;
 
 always @(posedge g_clk) begin
     if(!g_resetn || flush) begin
@@ -80,22 +97,22 @@ end
 // Does the buffer need updating this cycle?
 wire update_buffer = 
     (fill_en && (fill_2  || fill_4  || fill_6  || fill_8))  ||
-    drain_2 || drain_4 ;
+    drain_2 || drain_4 || drain_6 || drain_8 ;
 
 // Which bytes of the input data should be selected?
 wire [BR:0] n_d_buffer_in_pre_shift     =
-    fill_2  ? {32'b0, 80'b0, data_in[63:48]} :
-    fill_4  ? {32'b0, 64'b0, data_in[63:32]} :
-    fill_6  ? {32'b0, 48'b0, data_in[63:16]} :
-    fill_8  ? {32'b0, 32'b0, data_in[63: 0]} :
-                                         0   ;
+    fill_2  ? {{BR-15{1'b0}}, data_in[63:48]} :
+    fill_4  ? {{BR-31{1'b0}}, data_in[63:32]} :
+    fill_6  ? {{BR-47{1'b0}}, data_in[63:16]} :
+    fill_8  ? {{BR-63{1'b0}}, data_in[63: 0]} :
+                                          0   ;
 
 wire [ER:0] n_e_buffer_in_pre_shift     =
-    fill_2  ? { 7'b0, {1{error_in}}}    :
-    fill_4  ? { 6'b0, {2{error_in}}}    :
-    fill_6  ? { 5'b0, {3{error_in}}}    :
-    fill_8  ? { 4'b0, {4{error_in}}}    :
-                                0       ;
+    fill_2  ? {{ER  {1'b0}}, {1{error_in}}}    :
+    fill_4  ? {{ER-1{1'b0}}, {2{error_in}}}    :
+    fill_6  ? {{ER-2{1'b0}}, {3{error_in}}}    :
+    fill_8  ? {{ER-3{1'b0}}, {4{error_in}}}    :
+                                       0       ;
 
 // Shift the bytes-to-load up to their new position in the buffer register.
 wire [BR:0] n_d_buffer_in_shift_up    = n_d_buffer_in_pre_shift << (8*shf_up);
@@ -106,11 +123,15 @@ wire [ER:0] n_e_buffer_in_shift_up    = n_e_buffer_in_pre_shift << (  shf_up);
 wire [BR:0] n_d_buffer_out_shift_down =
     drain_2  ? {16'b0, d_buffer[BR:16]} :
     drain_4  ? {32'b0, d_buffer[BR:32]} :
+    drain_6  ? {48'b0, d_buffer[BR:48]} :
+    drain_8  ? {64'b0, d_buffer[BR:64]} :
                {       d_buffer       } ;
 
 wire [ER:0] n_e_buffer_out_shift_down =
     drain_2  ? { 1'b0, e_buffer[ER: 1]} :
     drain_4  ? { 2'b0, e_buffer[ER: 2]} :
+    drain_6  ? { 3'b0, e_buffer[ER: 3]} :
+    drain_8  ? { 4'b0, e_buffer[ER: 4]} :
                {       e_buffer       } ;
 
 // Or together the shifted out and shifted in data
@@ -139,7 +160,7 @@ end
 
 always @(posedge g_clk) if(g_resetn) begin
 
-    // Fetch buffer can store a maximum of 16 bytes.
+    // Fetch buffer can store a maximum of MAX_DEPTH bytes.
     assert(depth <= MAX_DEPTH);
 
 end
@@ -150,7 +171,7 @@ end
 always @(posedge g_clk) if(g_resetn) begin
     // This assumption is used for proofs by induction to make sure that
     // the fetch buffer starts in a valid state.
-    // Fetch buffer can store a maximum of 16 bytes.
+    // Fetch buffer can store a maximum of MAX_DEPTH bytes.
     assume(depth <= MAX_DEPTH);
 end
 `endif
@@ -29,17 +29,32 @@ input  wire [         31:0] s3_instr        , // Writeback stage instr word
 input  wire [         XL:0] s3_wdata        , // Writeback stage instr word
 input  wire [ REG_ADDR_R:0] s3_rd           , // Writeback stage instr word
 input  wire [   LSU_OP_R:0] s3_lsu_op       , // Writeback LSU op
+input  wire                 s3_lsu_split    , // Writeback LSU access was split
+input  wire [         XL:0] s3_lsu_rdata_lo , // First beat of split load
+input  wire                 s3_lsu_err_lo   , // First beat of split access err
+input  wire                 dmem_split_first, // First beat of split access
 input  wire [   CSR_OP_R:0] s3_csr_op       , // Writeback CSR op
 input  wire [         11:0] s3_csr_addr     , // CSR Address
 input  wire [   CFU_OP_R:0] s3_cfu_op       , // Writeback CFU op
 input  wire [    WB_OP_R:0] s3_wb_op        , // Writeback Data source.
 input  wire                 s3_trap         , // Raise a trap
 
+input  wire                 s3_b_full       , // WB has a second lane instr.
+input  wire [         XL:0] s3_b_pc         , // Second lane WB PC
+input  wire [         31:0] s3_b_instr      , // Second lane WB instr word
+input  wire [         XL:0] s3_b_wdata      , // Second lane WB write data
+input  wire [ REG_ADDR_R:0] s3_b_rd         , // Second lane WB rd address
+
 output wire                 s3_fwd_rd_wen   , // RD write en for fwd network
 output wire                 s3_rd_wen       , // RD write enable
 output wire [ REG_ADDR_R:0] s3_rd_addr      , // RD write addr
 output wire [         XL:0] s3_rd_wdata     , // RD write data.
 
+output wire                 s3_b_fwd_rd_wen , // Second lane fwd write en
+output wire                 s3_b_rd_wen     , // Second lane RD write enable
+output wire [ REG_ADDR_R:0] s3_b_rd_addr    , // Second lane RD write addr
+output wire [         XL:0] s3_b_rd_wdata   , // Second lane RD write data.
+
 output wire                 csr_en          , // CSR Access Enable
 output wire                 csr_wr          , // CSR Write Enable
 output wire                 csr_wr_set      , // CSR Write - Set
@@ -64,6 +79,7 @@ output wire [         XL:0] trap_pc         , // PC associated with the trap.
 
 output wire                 exec_mret       , // MRET instruction executed.
 output wire                 instr_ret       ,
+output wire                 instr_ret_b     , // Second lane instr retired.
 
 input  wire                 dmem_req        , // Memory request
 input  wire [ MEM_ADDR_R:0] dmem_addr       , // Memory request address
@@ -92,7 +108,11 @@ output wire                 wfi_sleep       , // Core asleep due to WFI.
 
 output wire                 trs_valid       , // Instruction trace valid
 output wire [         31:0] trs_instr       , // Instruction trace data
-output wire [         XL:0] trs_pc            // Instruction trace PC
+output wire [         XL:0] trs_pc          , // Instruction trace PC
+
+output wire                 trs_b_valid     , // Second lane trace valid
+output wire [         31:0] trs_b_instr     , // Second lane trace data
+output wire [         XL:0] trs_b_pc          // Second lane trace PC
 
 );
 
@@ -158,6 +178,22 @@ assign  s3_rd_wdata=
 
 assign  s3_rd_addr = s3_rd          ;
 
+// The second lane only ever holds a simple ALU instruction, which is
+// written back in the same cycle as the first lane instruction.
+// It writes back and retires on an interrupt because the trap PC
+// (s3_n_pc) already points past it.
+assign  s3_b_fwd_rd_wen = rd_wen_enable && s3_b_full;
+
+assign  s3_b_rd_wen     = s3_b_fwd_rd_wen   &&
+                         !trap_cpu          &&
+                         !trapped           ;
+
+assign  s3_b_rd_wdata   = s3_b_wdata    ;
+
+assign  s3_b_rd_addr    = s3_b_rd       ;
+
+assign  instr_ret_b     = e_instr_ret && s3_b_full && !trapped;
+
 //
 // CSR Control
 // ------------------------------------------------------------
@@ -218,7 +254,14 @@ wire        lsu_word       = s3_lsu_op[LSU_OP_WORD  ];
 wire        lsu_double     = s3_lsu_op[LSU_OP_DOUBLE];
 wire        lsu_sext       = s3_lsu_op[LSU_OP_SEXT  ];
 
-wire [XL:0] rdata_shifted  = dmem_rdata >> data_shift;
+// Split accesses return the lower addressed double-word first.
+wire [2*XLEN-1:0] rdata_pair =
+    s3_lsu_split ? {dmem_rdata  , s3_lsu_rdata_lo} :
+                   {{XLEN{1'b0}}, dmem_rdata     } ;
+
+wire [2*XLEN-1:0] rdata_pair_shifted = rdata_pair >> data_shift;
+
+wire [XL:0] rdata_shifted  = rdata_pair_shifted[XL:0];
 
 wire [XL:0] mask_ls_byte   = {56'h0,  8'hFF};
 wire [XL:0] mask_ls_half   = {48'h0, 16'hFFFF};
@@ -236,19 +279,23 @@ assign      lsu_rdata      =
     lsu_byte    ? rdata_byte    :
     lsu_half    ? rdata_half    :
     lsu_word    ? rdata_word    :
-                  dmem_rdata ;
+                  rdata_shifted ;
 
 reg         p_lsu_req      ;
 always @(posedge g_clk) begin
     if(!g_resetn) begin
         p_lsu_req <= 1'b0;
     end else begin
-        p_lsu_req <= dmem_req && dmem_gnt;
+        p_lsu_req <= dmem_req && dmem_gnt && !dmem_split_first;
     end
 end
 
-wire        lsu_trap_load  = lsu_load   && dmem_err && p_lsu_req;
-wire        lsu_trap_store = lsu_store  && dmem_err && p_lsu_req;
+wire        lsu_split_err  = s3_lsu_split && s3_lsu_err_lo;
+
+wire        lsu_err        = dmem_err   || lsu_split_err;
+
+wire        lsu_trap_load  = lsu_load   && lsu_err && p_lsu_req;
+wire        lsu_trap_store = lsu_store  && lsu_err && p_lsu_req;
 wire        trap_lsu       = lsu_trap_load || lsu_trap_store;
 
 
@@ -371,6 +418,10 @@ assign trs_valid = e_instr_ret  ;
 assign trs_pc    = s3_pc        ;
 assign trs_instr = s3_instr     ;
 
+assign trs_b_valid = instr_ret_b ;
+assign trs_b_pc    = s3_b_pc     ;
+assign trs_b_instr = s3_b_instr  ;
+
 
 //
 // RVFI Interface
@@ -3,7 +3,8 @@
 //
 // module: core_regfile
 //
-//  Core register file. 2 read, 1 write.
+//  Core register file. 2 read, 1 write. With DUAL_ISSUE set, an extra
+//  2 read, 1 write port set is added for the second issue lane.
 //
 module core_regfile (
 
@@ -19,7 +20,17 @@ output wire [        XL:0] rs2_data     ,
 
 input  wire                rd_wen       ,
 input  wire [REG_ADDR_R:0] rd_addr      ,
-input  wire [        XL:0] rd_wdata  
+input  wire [        XL:0] rd_wdata     ,
+
+input  wire [REG_ADDR_R:0] rs1_b_addr   , // Second issue lane ports.
+input  wire [REG_ADDR_R:0] rs2_b_addr   , // Unused unless DUAL_ISSUE.
+
+output wire [        XL:0] rs1_b_data   ,
+output wire [        XL:0] rs2_b_data   ,
+
+input  wire                rd_b_wen     ,
+input  wire [REG_ADDR_R:0] rd_b_addr    ,
+input  wire [        XL:0] rd_b_wdata   
 
 );
 
@@ -29,6 +40,12 @@ input  wire [        XL:0] rd_wdata
 // Use a FPGA-inference-friendly implementation of the register file.
 parameter FPGA_REGFILE = 0;
 
+// Add the second issue lane read and write ports.
+parameter DUAL_ISSUE   = 0;
+
+// Lane A and lane B never write the same register in the same cycle.
+wire    rd_b_wen_en = DUAL_ISSUE && rd_b_wen;
+
 generate if (FPGA_REGFILE) begin : fpga_regfile // Use DMEM based regfile.
 
     reg  [XL:0] regs  [31:0];
@@ -36,12 +53,18 @@ generate if (FPGA_REGFILE) begin : fpga_regfile // Use DMEM based regfile.
     assign  rs1_data    = |rs1_addr ? regs[rs1_addr] : {XLEN{1'b0}};
     assign  rs2_data    = |rs2_addr ? regs[rs2_addr] : {XLEN{1'b0}};
 
-    assign  g_clk_req   = rd_wen;
+    assign  rs1_b_data  = |rs1_b_addr ? regs[rs1_b_addr] : {XLEN{1'b0}};
+    assign  rs2_b_data  = |rs2_b_addr ? regs[rs2_b_addr] : {XLEN{1'b0}};
+
+    assign  g_clk_req   = rd_wen || rd_b_wen_en;
 
     always @(posedge g_clk) begin
         if(rd_wen && |rd_addr) begin
             regs[rd_addr] <= rd_wdata;
         end
+        if(rd_b_wen_en && |rd_b_addr) begin
+            regs[rd_b_addr] <= rd_b_wdata;
+        end
     end
 
 end else begin : ff_regfile                     // Use FF based regfile
@@ -50,20 +73,26 @@ end else begin : ff_regfile                     // Use FF based regfile
 
     assign  rs1_data    = regs[rs1_addr];
     assign  rs2_data    = regs[rs2_addr];
+
+    assign  rs1_b_data  = regs[rs1_b_addr];
+    assign  rs2_b_data  = regs[rs2_b_addr];
     
-    assign  g_clk_req   = rd_wen;
+    assign  g_clk_req   = rd_wen || rd_b_wen_en;
 
     assign regs[0]      = 0;
 
+    // Named, and public, so simulation harnesses can peek / poke GPRs.
     genvar i;
-    for(i = 1; i < 32; i = i + 1) begin
+    for(i = 1; i < 32; i = i + 1) begin : gen_regs
 
-        reg [XL:0] r;
+        reg [XL:0] r /*verilator public_flat_rw*/;
 
         assign regs[i] = r;
 
         always @(posedge g_clk) begin
-            if(rd_wen && (rd_addr == i)) begin
+            if(rd_b_wen_en && (rd_b_addr == i)) begin
+                r <= rd_b_wdata;
+            end else if(rd_wen && (rd_addr == i)) begin
                 r <= rd_wdata;
             end
         end
@@ -44,6 +44,7 @@ input  wire [ MEM_DATA_R:0] dmem_rdata   , // Memory response read data
 output wire                 wfi_sleep    , // Core is asleep due to WFI.
 
 output wire                 instr_ret    , // Instruction retired;
+output wire                 instr_ret_b  , // Second lane instr retired.
                
 input  wire [         63:0] ctr_time     , // The time counter value.
 input  wire [         63:0] ctr_cycle    , // The cycle counter value.
@@ -55,7 +56,11 @@ output wire                 inhibit_ir   , // Stop instret incrementing.
 
 output wire                 trs_valid    , // Instruction trace valid
 output wire [         31:0] trs_instr    , // Instruction trace data
-output wire [         XL:0] trs_pc         // Instruction trace PC
+output wire [         XL:0] trs_pc       , // Instruction trace PC
+
+output wire                 trs_b_valid  , // Second lane trace valid
+output wire [         31:0] trs_b_instr  , // Second lane trace data
+output wire [         XL:0] trs_b_pc       // Second lane trace PC
 
 );
 
@@ -69,6 +74,38 @@ parameter   PC_RESET_ADDRESS= 'h10000000;
 // Use a FPGA-inference-friendly implementation of the register file.
 parameter FPGA_REGFILE = 0;
 
+// Issue pairs of simple ALU instructions in the same cycle.
+parameter DUAL_ISSUE   = 0;
+
+// Multiplier implementation. 0=iterative, 1=pipelined, 2=FPGA DSP.
+parameter MUL_IMPL     = 0;
+
+// Bits of rs2 consumed per cycle by the iterative multiplier (MUL_IMPL=0)
+// and the carry-less multiplier. Powers of two from 1 to 32.
+parameter MUL_UNROLL   = 4;
+parameter CLMUL_UNROLL = 8;
+
+// Divider quotient bits per cycle (1 or 2), and whether it skips
+// iterations which cannot produce a quotient bit.
+parameter DIV_UNROLL   = 1;
+parameter DIV_NORMALISE= 1;
+
+// Crypto datapath implementation.
+//  0 = area   : 4 AES sboxes, saes64 sbox instructions take 2 cycles.
+//  1 = fast   : 8 AES sboxes, every saes64.* instruction takes 1 cycle.
+//  2 = shared : As fast, but AES and SM4 share 8 combined sboxes.
+parameter CRYPTO_IMPL  = 0;
+
+// Split misaligned loads/stores into aligned beats, rather than trap.
+parameter MISALIGNED_HW= 0;
+
+// Fetch buffer size in bits (128, 256 or 512) and prefetch enable.
+parameter FETCH_BUFFER_DEPTH = 128;
+parameter FETCH_PREFETCH     = 0;
+
+// Number of implemented mhpmcounter/mhpmevent pairs, from 0 to 29.
+parameter HPM_COUNTERS       = 4;
+
 //
 // Feature Set Parameters
 //
@@ -87,6 +124,9 @@ parameter ARCH_ZKNH = 1; // Turn on NIST SHA2 instructions
 parameter ARCH_ZKS  = 1; // Turn on ShangMi suite crypto instructions
 parameter ARCH_ZKSED= 1; // Turn on ShangMi SM4 instructions
 parameter ARCH_ZKSH = 1; // Turn on ShangMi SM3 instructions
+parameter ARCH_ZBA  = 1; // Turn on Zba address generation instructions
+parameter ARCH_ZBB  = 1; // Turn on Zbb basic bit-manipulation instructions
+parameter ARCH_ZBS  = 1; // Turn on Zbs single-bit instructions
 
 localparam F_ZKB  = ARCH_ZK || ARCH_ZKB ;
 localparam F_ZKG  = ARCH_ZK || ARCH_ZKG ;
@@ -95,6 +135,9 @@ localparam F_ZKND = ARCH_ZK || ARCH_ZKN || ARCH_ZKND;
 localparam F_ZKNH = ARCH_ZK || ARCH_ZKN || ARCH_ZKNH;
 localparam F_ZKSED= ARCH_ZK || ARCH_ZKS || ARCH_ZKSED;
 localparam F_ZKSH = ARCH_ZK || ARCH_ZKS || ARCH_ZKSH;
+localparam F_ZBA  = ARCH_ZBA;
+localparam F_ZBB  = ARCH_ZBB;
+localparam F_ZBS  = ARCH_ZBS;
 
 //
 // Clock request and delivery wires.
@@ -155,6 +198,18 @@ wire [         XL:0] s1_rs1_data ; // RS1 Read Data (Forwarded)
 wire [ REG_ADDR_R:0] s1_rs2_addr ; // RS2 Address
 wire [         XL:0] s1_rs2_data ; // RS2 Read Data (Forwarded)
 
+wire                 s1_b_i16bit   ; // Second 16 bit instruction?
+wire                 s1_b_i32bit   ; // Second 32 bit instruction?
+wire [  FD_IBUF_R:0] s1_b_instr    ; // Second instruction to decode
+wire [   FD_ERR_R:0] s1_b_ferr     ; // Second instr fetch bus error?
+wire                 s1_b_eat_2    ; // Decode eats 2 more bytes
+wire                 s1_b_eat_4    ; // Decode eats 4 more bytes
+
+wire [ REG_ADDR_R:0] s1_b_rs1_addr ; // Second lane RS1 Address
+wire [         XL:0] s1_b_rs1_data ; // Second lane RS1 Data (Forwarded)
+wire [ REG_ADDR_R:0] s1_b_rs2_addr ; // Second lane RS2 Address
+wire [         XL:0] s1_b_rs2_data ; // Second lane RS2 Data (Forwarded)
+
 wire                 s2_ready       ; // EX ready for new instruction
 wire                 s2_valid       ; // Decode -> EX instr valid.
 
@@ -195,6 +250,23 @@ wire                 s2_alu_grev    ; //
 wire                 s2_alu_gorc    ; //
 wire                 s2_alu_xpermn  ; //
 wire                 s2_alu_xpermb  ; //
+wire                 s2_alu_uw      ; //
+wire                 s2_alu_sh1add  ; //
+wire                 s2_alu_sh2add  ; //
+wire                 s2_alu_sh3add  ; //
+wire                 s2_alu_clz     ; //
+wire                 s2_alu_ctz     ; //
+wire                 s2_alu_cpop    ; //
+wire                 s2_alu_min     ; //
+wire                 s2_alu_minu    ; //
+wire                 s2_alu_max     ; //
+wire                 s2_alu_maxu    ; //
+wire                 s2_alu_sextb   ; //
+wire                 s2_alu_sexth   ; //
+wire                 s2_alu_bclr    ; //
+wire                 s2_alu_bset    ; //
+wire                 s2_alu_binv    ; //
+wire                 s2_alu_bext    ; //
 wire                 s2_alu_word    ; // Word result only.
 
 wire                 s2_cfu_beq     ; // Control flow operation.
@@ -269,6 +341,25 @@ wire                 s2_wb_lsu      ; // Writeback LSU Loaded data
 wire                 s2_wb_cry      ; // Writeback crypto result.
 wire                 s2_wb_npc      ; // Writeback next PC value
 
+wire                 s2_b_valid     ; // Second lane instr valid.
+wire [ REG_ADDR_R:0] s2_b_rd        ; // Second lane rd address.
+wire [         XL:0] s2_b_pc        ; // Second lane PC.
+wire [         31:0] s2_b_instr     ; // Second lane instr word.
+wire [         XL:0] s2_b_alu_lhs   ; // Second lane ALU left  operand
+wire [         XL:0] s2_b_alu_rhs   ; // Second lane ALU right operand
+wire [          5:0] s2_b_alu_shamt ; // Second lane ALU shift amount
+wire                 s2_b_alu_add   ; // Second lane ALU Operation.
+wire                 s2_b_alu_and   ; //
+wire                 s2_b_alu_or    ; //
+wire                 s2_b_alu_sll   ; //
+wire                 s2_b_alu_srl   ; //
+wire                 s2_b_alu_slt   ; //
+wire                 s2_b_alu_sltu  ; //
+wire                 s2_b_alu_sra   ; //
+wire                 s2_b_alu_sub   ; //
+wire                 s2_b_alu_xor   ; //
+wire                 s2_b_alu_word  ; //
+
 wire                 s3_valid       ; // New instruction ready
 wire                 s3_ready       ; // WB ready for new instruciton.
 wire                 s3_full        ; // WB has an instr in it.
@@ -277,12 +368,22 @@ wire [         31:0] s3_instr       ; // Writeback stage instr word
 wire [         XL:0] s3_wdata       ; // Writeback stage instr word
 wire [ REG_ADDR_R:0] s3_rd          ; // Writeback stage instr word
 wire [   LSU_OP_R:0] s3_lsu_op      ; // Writeback LSU op
+wire                 s3_lsu_split   ; // Writeback LSU access was split
+wire [         XL:0] s3_lsu_rdata_lo; // First beat of split load
+wire                 s3_lsu_err_lo  ; // First beat of split access err
+wire                 dmem_split_first; // First beat of split access
 wire [   CSR_OP_R:0] s3_csr_op      ; // Writeback CSR op
 wire [         11:0] s3_csr_addr    ; // CSR access address
 wire [   CFU_OP_R:0] s3_cfu_op      ; // Writeback CFU op
 wire [    WB_OP_R:0] s3_wb_op       ; // Writeback Data source.
 wire                 s3_trap        ; // Raise a trap
 
+wire                 s3_b_full      ; // WB has a second lane instr.
+wire [         XL:0] s3_b_pc        ; // Second lane WB PC
+wire [         31:0] s3_b_instr     ; // Second lane WB instr word
+wire [         XL:0] s3_b_wdata     ; // Second lane WB write data
+wire [ REG_ADDR_R:0] s3_b_rd        ; // Second lane WB rd address
+
 `ifdef RVFI
 wire [ REG_ADDR_R:0] s3_rs1_addr    ;
 wire [ REG_ADDR_R:0] s3_rs2_addr    ;
@@ -299,6 +400,10 @@ wire                 s3_rd_wen      ; // Destination register write enable
 wire [ REG_ADDR_R:0] s3_rd_addr     ; // Destination register write addr
 wire [         XL:0] s3_rd_wdata    ; // Destination register write data.
 
+wire                 s3_b_rd_wen    ; // Second lane rd write enable
+wire [ REG_ADDR_R:0] s3_b_rd_addr   ; // Second lane rd write addr
+wire [         XL:0] s3_b_rd_wdata  ; // Second lane rd write data.
+
 
 wire                 csr_en      ; // CSR Access Enable
 wire                 csr_wr      ; // CSR Write Enable
@@ -349,12 +454,93 @@ wire [XL:0] gpr_rs2_data;
 // like trap calculation and calcalation of a GPR write from the
 // critical path.
 wire        s3_fwd_rd_wen;
+wire        s3_b_fwd_rd_wen;
 
 wire    fwd_rs1     = s3_fwd_rd_wen && |s3_rd_addr && s3_rd_addr==s1_rs1_addr;
 wire    fwd_rs2     = s3_fwd_rd_wen && |s3_rd_addr && s3_rd_addr==s1_rs2_addr;
 
-assign  s1_rs1_data = fwd_rs1 ? s3_rd_wdata : gpr_rs1_data;
-assign  s1_rs2_data = fwd_rs2 ? s3_rd_wdata : gpr_rs2_data;
+// Second issue lane writeback. Both lanes never write the same register,
+// so at most one of the s3 lanes matches any given source register.
+wire    fwd_b_rs1   = s3_b_fwd_rd_wen && |s3_b_rd_addr &&
+                      s3_b_rd_addr==s1_rs1_addr;
+wire    fwd_b_rs2   = s3_b_fwd_rd_wen && |s3_b_rd_addr &&
+                      s3_b_rd_addr==s1_rs2_addr;
+
+assign  s1_rs1_data = fwd_rs1   ? s3_rd_wdata   :
+                      fwd_b_rs1 ? s3_b_rd_wdata : gpr_rs1_data;
+assign  s1_rs2_data = fwd_rs2   ? s3_rd_wdata   :
+                      fwd_b_rs2 ? s3_b_rd_wdata : gpr_rs2_data;
+
+wire [XL:0] gpr_rs1_b_data;
+wire [XL:0] gpr_rs2_b_data;
+
+wire    fwd_rs1_b   = s3_fwd_rd_wen && |s3_rd_addr && s3_rd_addr==s1_b_rs1_addr;
+wire    fwd_rs2_b   = s3_fwd_rd_wen && |s3_rd_addr && s3_rd_addr==s1_b_rs2_addr;
+
+wire    fwd_b_rs1_b = s3_b_fwd_rd_wen && |s3_b_rd_addr &&
+                      s3_b_rd_addr==s1_b_rs1_addr;
+wire    fwd_b_rs2_b = s3_b_fwd_rd_wen && |s3_b_rd_addr &&
+                      s3_b_rd_addr==s1_b_rs2_addr;
+
+assign  s1_b_rs1_data = fwd_rs1_b   ? s3_rd_wdata   :
+                        fwd_b_rs1_b ? s3_b_rd_wdata : gpr_rs1_b_data;
+assign  s1_b_rs2_data = fwd_rs2_b   ? s3_rd_wdata   :
+                        fwd_b_rs2_b ? s3_b_rd_wdata : gpr_rs2_b_data;
+
+//
+// Performance monitor events
+// ------------------------------------------------------------
+
+wire [HPM_EVENTS_R:0] hpm_events;
+
+wire    s2_stall        = s2_valid && !s2_ready;
+wire    s2_lsu          = s2_lsu_load || s2_lsu_store;
+
+wire    ret_c           = instr_ret   && trs_instr  [1:0] != 2'b11;
+wire    ret_b_c         = instr_ret_b && trs_b_instr[1:0] != 2'b11;
+
+assign  hpm_events[HPM_EV_FB_EMPTY ] = !s1_i16bit && !s1_i32bit;
+assign  hpm_events[HPM_EV_CF_CHANGE] = cf_valid && cf_ack;
+assign  hpm_events[HPM_EV_LSU_STALL] = s2_stall && s2_lsu;
+assign  hpm_events[HPM_EV_MDU_BUSY ] = s2_stall && s2_wb_mdu;
+assign  hpm_events[HPM_EV_IMEM_WAIT] = imem_req && !imem_gnt;
+assign  hpm_events[HPM_EV_DMEM_WAIT] = dmem_req && !dmem_gnt;
+assign  hpm_events[HPM_EV_BR_TAKEN ] = s2_cf_valid && cf_ack && !s3_cf_valid;
+assign  hpm_events[HPM_EV_RET_C    ] = ret_c || ret_b_c;
+
+//
+// Pipeline view
+// ------------------------------------------------------------
+//
+// Only read by the simulation testbench, which turns them into a per
+// instruction pipeline trace. See verif/share/verilator/tb_pipeview.hpp
+
+// Why the instruction in decode / execute is not issuing: 0 - it is,
+// 1 - writeback busy, 2 - lsu_ready, 3 - mdu_ready, 4 - cry_ready,
+// 5 - waiting on a control flow change or WFI.
+wire [2:0] pv_stall =
+    !s2_stall   ? 3'd0 :
+    !s3_ready   ? 3'd1 :
+    s2_lsu      ? 3'd2 :
+    s2_wb_mdu   ? 3'd3 :
+    s2_wb_cry   ? 3'd4 :
+                  3'd5 ;
+
+wire [9:0] pv_events /*verilator public_flat_rd*/ = {
+    pv_stall            , // 9:7
+    instr_ret_b         , // 6
+    instr_ret           , // 5
+    cf_valid && cf_ack  , // 4
+    s2_flush            , // 3
+    s2_b_valid          , // 2
+    s2_ready            , // 1
+    s2_valid              // 0
+};
+
+wire [XL:0] pv_s2_pc     /*verilator public_flat_rd*/ = s2_pc     ;
+wire [31:0] pv_s2_instr  /*verilator public_flat_rd*/ = s2_instr  ;
+wire [XL:0] pv_s2_b_pc   /*verilator public_flat_rd*/ = s2_b_pc   ;
+wire [31:0] pv_s2_b_instr/*verilator public_flat_rd*/ = s2_b_instr;
 
 //
 // Submodule instances.
@@ -368,7 +554,10 @@ assign  s1_rs2_data = fwd_rs2 ? s3_rd_wdata : gpr_rs2_data;
 //
 core_pipe_fetch #(
 .PC_RESET_ADDRESS(PC_RESET_ADDRESS),
-.MEM_ADDR_W      (MEM_ADDR_W      )
+.MEM_ADDR_W      (MEM_ADDR_W      ),
+.DUAL_ISSUE      (DUAL_ISSUE      ),
+.FETCH_BUFFER_DEPTH(FETCH_BUFFER_DEPTH),
+.FETCH_PREFETCH  (FETCH_PREFETCH  )
 ) i_core_pipe_fetch (
 .g_clk        (g_clk        ), // Global clock
 .g_resetn     (g_resetn     ), // Global active low sync reset.
@@ -392,7 +581,13 @@ core_pipe_fetch #(
 .s1_instr     (s1_instr     ), // Instruction to be decoded
 .s1_ferr      (s1_ferr      ), // Fetch bus error?
 .s1_eat_2     (s1_eat_2     ), // Decode eats 2 bytes
-.s1_eat_4     (s1_eat_4     )  // Decode eats 4 bytes
+.s1_eat_4     (s1_eat_4     ), // Decode eats 4 bytes
+.s1_b_i16bit  (s1_b_i16bit  ), // Second 16 bit instruction?
+.s1_b_i32bit  (s1_b_i32bit  ), // Second 32 bit instruction?
+.s1_b_instr   (s1_b_instr   ), // Second instruction to decode
+.s1_b_ferr    (s1_b_ferr    ), // Second instr fetch bus error?
+.s1_b_eat_2   (s1_b_eat_2   ), // Decode eats 2 more bytes
+.s1_b_eat_4   (s1_b_eat_4   )  // Decode eats 4 more bytes
 );
 
 
@@ -409,7 +604,11 @@ core_pipe_decode #(
 .F_ZKND          (F_ZKND ), // Turn on NIST AES decrypt
 .F_ZKNH          (F_ZKNH ), // Turn on NIST SHA2 instructions
 .F_ZKSED         (F_ZKSED), // Turn on ShangMi SM4 instructions
-.F_ZKSH          (F_ZKSH )  // Turn on ShangMi SM3 instructions
+.F_ZKSH          (F_ZKSH ), // Turn on ShangMi SM3 instructions
+.F_ZBA           (F_ZBA  ), // Turn on Zba address generation instructions
+.F_ZBB           (F_ZBB  ), // Turn on Zbb basic bit-manipulation instructions
+.F_ZBS           (F_ZBS  ), // Turn on Zbs single-bit instructions
+.DUAL_ISSUE      (DUAL_ISSUE)
 ) i_core_pipe_decode (
 .g_clk           (g_clk           ), // Global clock
 .g_resetn        (g_resetn        ), // Global active low sync reset.
@@ -465,6 +664,23 @@ core_pipe_decode #(
 .s2_alu_gorc     (s2_alu_gorc     ), //
 .s2_alu_xpermn   (s2_alu_xpermn   ), //
 .s2_alu_xpermb   (s2_alu_xpermb   ), //
+.s2_alu_uw       (s2_alu_uw       ), //
+.s2_alu_sh1add   (s2_alu_sh1add   ), //
+.s2_alu_sh2add   (s2_alu_sh2add   ), //
+.s2_alu_sh3add   (s2_alu_sh3add   ), //
+.s2_alu_clz      (s2_alu_clz      ), //
+.s2_alu_ctz      (s2_alu_ctz      ), //
+.s2_alu_cpop     (s2_alu_cpop     ), //
+.s2_alu_min      (s2_alu_min      ), //
+.s2_alu_minu     (s2_alu_minu     ), //
+.s2_alu_max      (s2_alu_max      ), //
+.s2_alu_maxu     (s2_alu_maxu     ), //
+.s2_alu_sextb    (s2_alu_sextb    ), //
+.s2_alu_sexth    (s2_alu_sexth    ), //
+.s2_alu_bclr     (s2_alu_bclr     ), //
+.s2_alu_bset     (s2_alu_bset     ), //
+.s2_alu_binv     (s2_alu_binv     ), //
+.s2_alu_bext     (s2_alu_bext     ), //
 .s2_alu_word     (s2_alu_word     ), // Word result only.
 .s2_cfu_beq      (s2_cfu_beq      ), // Control flow operation.
 .s2_cfu_bge      (s2_cfu_bge      ), //
@@ -531,7 +747,35 @@ core_pipe_decode #(
 .s2_wb_mdu       (s2_wb_mdu       ), // Writeback MDU result
 .s2_wb_lsu       (s2_wb_lsu       ), // Writeback LSU Loaded data
 .s2_wb_cry       (s2_wb_cry       ), // Writeback Crypto result
-.s2_wb_npc       (s2_wb_npc       )  // Writeback next PC value
+.s2_wb_npc       (s2_wb_npc       ), // Writeback next PC value
+.s1_b_i16bit     (s1_b_i16bit     ), // Second 16 bit instruction?
+.s1_b_i32bit     (s1_b_i32bit     ), // Second 32 bit instruction?
+.s1_b_instr      (s1_b_instr      ), // Second instr to be decoded
+.s1_b_ferr       (s1_b_ferr       ), // Second instr fetch error?
+.s1_b_eat_2      (s1_b_eat_2      ), // Decode eats 2 more bytes
+.s1_b_eat_4      (s1_b_eat_4      ), // Decode eats 4 more bytes
+.s1_b_rs1_addr   (s1_b_rs1_addr   ), // Second lane RS1 Address
+.s1_b_rs1_data   (s1_b_rs1_data   ), // Second lane RS1 Read Data
+.s1_b_rs2_addr   (s1_b_rs2_addr   ), // Second lane RS2 Address
+.s1_b_rs2_data   (s1_b_rs2_data   ), // Second lane RS2 Read Data
+.s2_b_valid      (s2_b_valid      ), // Second lane instr valid.
+.s2_b_rd         (s2_b_rd         ), // Second lane rd address.
+.s2_b_pc         (s2_b_pc         ), // Second lane PC.
+.s2_b_instr      (s2_b_instr      ), // Second lane instr word.
+.s2_b_alu_lhs    (s2_b_alu_lhs    ), // Second lane ALU operands.
+.s2_b_alu_rhs    (s2_b_alu_rhs    ), //
+.s2_b_alu_shamt  (s2_b_alu_shamt  ), //
+.s2_b_alu_add    (s2_b_alu_add    ), // Second lane ALU operation.
+.s2_b_alu_and    (s2_b_alu_and    ), //
+.s2_b_alu_or     (s2_b_alu_or     ), //
+.s2_b_alu_sll    (s2_b_alu_sll    ), //
+.s2_b_alu_srl    (s2_b_alu_srl    ), //
+.s2_b_alu_slt    (s2_b_alu_slt    ), //
+.s2_b_alu_sltu   (s2_b_alu_sltu   ), //
+.s2_b_alu_sra    (s2_b_alu_sra    ), //
+.s2_b_alu_sub    (s2_b_alu_sub    ), //
+.s2_b_alu_xor    (s2_b_alu_xor    ), //
+.s2_b_alu_word   (s2_b_alu_word   )  //
 );
 
 
@@ -547,7 +791,15 @@ core_pipe_exec #(
 .F_ZKND          (F_ZKND ), // Turn on NIST AES decrypt
 .F_ZKNH          (F_ZKNH ), // Turn on NIST SHA2 instructions
 .F_ZKSED         (F_ZKSED), // Turn on ShangMi SM4 instructions
-.F_ZKSH          (F_ZKSH )  // Turn on ShangMi SM3 instructions
+.F_ZKSH          (F_ZKSH ), // Turn on ShangMi SM3 instructions
+.DUAL_ISSUE      (DUAL_ISSUE), // Issue pairs of simple ALU instrs.
+.MUL_IMPL        (MUL_IMPL  ), // Multiplier implementation.
+.MUL_UNROLL      (MUL_UNROLL), // Iterative multiplier bits per cycle.
+.CLMUL_UNROLL    (CLMUL_UNROLL), // Carry-less multiplier bits per cycle.
+.DIV_UNROLL      (DIV_UNROLL  ), // Divider quotient bits per cycle.
+.DIV_NORMALISE   (DIV_NORMALISE), // Divider skips dead iterations.
+.CRYPTO_IMPL     (CRYPTO_IMPL), // Crypto datapath implementation.
+.MISALIGNED_HW   (MISALIGNED_HW)  // Split misaligned accesses.
 ) i_core_pipe_exec(
 .g_clk           (g_clk           ), // Global clock
 .g_clk_mul       (g_clk_mul       ), // Gated multiplier clock
@@ -600,6 +852,23 @@ core_pipe_exec #(
 .s2_alu_gorc     (s2_alu_gorc     ), //
 .s2_alu_xpermn   (s2_alu_xpermn   ), //
 .s2_alu_xpermb   (s2_alu_xpermb   ), //
+.s2_alu_uw       (s2_alu_uw       ), //
+.s2_alu_sh1add   (s2_alu_sh1add   ), //
+.s2_alu_sh2add   (s2_alu_sh2add   ), //
+.s2_alu_sh3add   (s2_alu_sh3add   ), //
+.s2_alu_clz      (s2_alu_clz      ), //
+.s2_alu_ctz      (s2_alu_ctz      ), //
+.s2_alu_cpop     (s2_alu_cpop     ), //
+.s2_alu_min      (s2_alu_min      ), //
+.s2_alu_minu     (s2_alu_minu     ), //
+.s2_alu_max      (s2_alu_max      ), //
+.s2_alu_maxu     (s2_alu_maxu     ), //
+.s2_alu_sextb    (s2_alu_sextb    ), //
+.s2_alu_sexth    (s2_alu_sexth    ), //
+.s2_alu_bclr     (s2_alu_bclr     ), //
+.s2_alu_bset     (s2_alu_bset     ), //
+.s2_alu_binv     (s2_alu_binv     ), //
+.s2_alu_bext     (s2_alu_bext     ), //
 .s2_alu_word     (s2_alu_word     ), // Word result only.
 .s2_cfu_beq      (s2_cfu_beq      ), // Control flow operation.
 .s2_cfu_bge      (s2_cfu_bge      ), //
@@ -667,6 +936,24 @@ core_pipe_exec #(
 .s2_wb_lsu       (s2_wb_lsu       ), // Writeback LSU Loaded data
 .s2_wb_cry       (s2_wb_cry       ), // Writeback Crypto result
 .s2_wb_npc       (s2_wb_npc       ), // Writeback next PC value
+.s2_b_valid      (s2_b_valid      ), // Second lane instr valid.
+.s2_b_rd         (s2_b_rd         ), // Second lane rd address.
+.s2_b_pc         (s2_b_pc         ), // Second lane PC.
+.s2_b_instr      (s2_b_instr      ), // Second lane instr word.
+.s2_b_alu_lhs    (s2_b_alu_lhs    ), // Second lane ALU operands.
+.s2_b_alu_rhs    (s2_b_alu_rhs    ), //
+.s2_b_alu_shamt  (s2_b_alu_shamt  ), //
+.s2_b_alu_add    (s2_b_alu_add    ), // Second lane ALU operation.
+.s2_b_alu_and    (s2_b_alu_and    ), //
+.s2_b_alu_or     (s2_b_alu_or     ), //
+.s2_b_alu_sll    (s2_b_alu_sll    ), //
+.s2_b_alu_srl    (s2_b_alu_srl    ), //
+.s2_b_alu_slt    (s2_b_alu_slt    ), //
+.s2_b_alu_sltu   (s2_b_alu_sltu   ), //
+.s2_b_alu_sra    (s2_b_alu_sra    ), //
+.s2_b_alu_sub    (s2_b_alu_sub    ), //
+.s2_b_alu_xor    (s2_b_alu_xor    ), //
+.s2_b_alu_word   (s2_b_alu_word   ),
 .s3_valid        (s3_valid        ), // New instruction ready
 .s3_ready        (s3_ready        ), // WB ready for new instruciton.
 .s3_full         (s3_full         ), // WB has an instr in it.
@@ -675,11 +962,20 @@ core_pipe_exec #(
 .s3_wdata        (s3_wdata        ), // Writeback stage instr word
 .s3_rd           (s3_rd           ), // Writeback stage instr word
 .s3_lsu_op       (s3_lsu_op       ), // Writeback LSU op
+.s3_lsu_split    (s3_lsu_split    ), // Writeback LSU access was split
+.s3_lsu_rdata_lo (s3_lsu_rdata_lo ), // First beat of split load
+.s3_lsu_err_lo   (s3_lsu_err_lo   ), // First beat of split access err
+.dmem_split_first(dmem_split_first), // First beat of split access
 .s3_csr_op       (s3_csr_op       ), // Writeback CSR op
 .s3_csr_addr     (s3_csr_addr     ), // CSR Access address
 .s3_cfu_op       (s3_cfu_op       ), // Writeback CFU op
 .s3_wb_op        (s3_wb_op        ), // Writeback Data source.
 .s3_trap         (s3_trap         ), // Raise a trap
+.s3_b_full       (s3_b_full       ), // WB has a second lane instr.
+.s3_b_pc         (s3_b_pc         ), // Second lane WB PC
+.s3_b_instr      (s3_b_instr      ), // Second lane WB instr word
+.s3_b_wdata      (s3_b_wdata      ), // Second lane WB write data
+.s3_b_rd         (s3_b_rd         ), // Second lane WB rd address
 `ifdef RVFI
 .s3_rs1_addr     (s3_rs1_addr     ),
 .s3_rs2_addr     (s3_rs2_addr     ),
@@ -731,15 +1027,28 @@ core_pipe_wb #(
 .s3_wdata        (s3_wdata        ), // Writeback stage instr word
 .s3_rd           (s3_rd           ), // Writeback stage instr word
 .s3_lsu_op       (s3_lsu_op       ), // Writeback LSU op
+.s3_lsu_split    (s3_lsu_split    ), // Writeback LSU access was split
+.s3_lsu_rdata_lo (s3_lsu_rdata_lo ), // First beat of split load
+.s3_lsu_err_lo   (s3_lsu_err_lo   ), // First beat of split access err
+.dmem_split_first(dmem_split_first), // First beat of split access
 .s3_csr_op       (s3_csr_op       ), // Writeback CSR op
 .s3_csr_addr     (s3_csr_addr     ), // CSR Access address
 .s3_cfu_op       (s3_cfu_op       ), // Writeback CFU op
 .s3_wb_op        (s3_wb_op        ), // Writeback Data source.
 .s3_trap         (s3_trap         ), // Raise a trap
+.s3_b_full       (s3_b_full       ), // WB has a second lane instr.
+.s3_b_pc         (s3_b_pc         ), // Second lane WB PC
+.s3_b_instr      (s3_b_instr      ), // Second lane WB instr word
+.s3_b_wdata      (s3_b_wdata      ), // Second lane WB write data
+.s3_b_rd         (s3_b_rd         ), // Second lane WB rd address
 .s3_fwd_rd_wen   (s3_fwd_rd_wen   ), // RD write en for forwarding network.
 .s3_rd_wen       (s3_rd_wen       ), // RD write enable
 .s3_rd_addr      (s3_rd_addr      ), // RD write addr
 .s3_rd_wdata     (s3_rd_wdata     ), // RD write data.
+.s3_b_fwd_rd_wen (s3_b_fwd_rd_wen ), // Second lane fwd write en
+.s3_b_rd_wen     (s3_b_rd_wen     ), // Second lane RD write enable
+.s3_b_rd_addr    (s3_b_rd_addr    ), // Second lane RD write addr
+.s3_b_rd_wdata   (s3_b_rd_wdata   ), // Second lane RD write data.
 .csr_en          (csr_en          ), // CSR Access Enable
 .csr_wr          (csr_wr          ), // CSR Write Enable
 .csr_wr_set      (csr_wr_set      ), // CSR Write - Set
@@ -760,6 +1069,7 @@ core_pipe_wb #(
 .trap_pc         (trap_pc         ), // PC value associated with the trap.
 .exec_mret       (exec_mret       ), // MRET instruction executed.
 .instr_ret       (instr_ret       ), // INstruction retired
+.instr_ret_b     (instr_ret_b     ), // Second lane instr retired
 .dmem_req        (dmem_req        ), // Memory request
 .dmem_addr       (dmem_addr       ), // Memory request address
 .dmem_wen        (dmem_wen        ), // Memory request write enable
@@ -784,7 +1094,10 @@ core_pipe_wb #(
 .wfi_sleep       (wfi_sleep       ), // Core asleep due to WFI.
 .trs_valid       (trs_valid       ), // Instruction trace valid
 .trs_instr       (trs_instr       ), // Instruction trace data
-.trs_pc          (trs_pc          )  // Instruction trace PC
+.trs_pc          (trs_pc          ), // Instruction trace PC
+.trs_b_valid     (trs_b_valid     ), // Second lane trace valid
+.trs_b_instr     (trs_b_instr     ), // Second lane trace data
+.trs_b_pc        (trs_b_pc        )  // Second lane trace PC
 );
 
 
@@ -792,10 +1105,12 @@ core_pipe_wb #(
 //
 // instance: core_regfile
 //
-//  Core register file. 2 read, 1 write.
+//  Core register file. 2 read, 1 write. Plus 2 read, 1 write for the
+//  second issue lane when DUAL_ISSUE is set.
 //
 core_regfile #(
-.FPGA_REGFILE   (FPGA_REGFILE   )
+.FPGA_REGFILE   (FPGA_REGFILE   ),
+.DUAL_ISSUE     (DUAL_ISSUE     )
 ) i_core_regfile (
 .g_clk    (g_clk_rf    ),
 .g_clk_req(g_clk_rf_req),
@@ -806,7 +1121,14 @@ core_regfile #(
 .rs2_data (gpr_rs2_data),
 .rd_wen   (s3_rd_wen   ),
 .rd_addr  (s3_rd_addr  ),
-.rd_wdata (s3_rd_wdata ) 
+.rd_wdata (s3_rd_wdata ),
+.rs1_b_addr(s1_b_rs1_addr ),
+.rs2_b_addr(s1_b_rs2_addr ),
+.rs1_b_data(gpr_rs1_b_data),
+.rs2_b_data(gpr_rs2_b_data),
+.rd_b_wen  (s3_b_rd_wen   ),
+.rd_b_addr (s3_b_rd_addr  ),
+.rd_b_wdata(s3_b_rd_wdata ) 
 );
 
 
@@ -815,7 +1137,9 @@ core_regfile #(
 //
 //  Responsible for keeping control/status registers up to date.
 //
-core_csrs i_core_csrs (
+core_csrs #(
+.HPM_COUNTERS     (HPM_COUNTERS     )
+) i_core_csrs (
 .g_clk            (g_clk            ), // global clock
 .g_resetn         (g_resetn         ), // synchronous reset
 .csr_en           (csr_en           ), // CSR Access Enable
@@ -851,6 +1175,7 @@ core_csrs i_core_csrs (
 .inhibit_cy       (inhibit_cy       ), // Stop cycle counter incrementing.
 .inhibit_tm       (inhibit_tm       ), // Stop time counter incrementing.
 .inhibit_ir       (inhibit_ir       ), // Stop instret incrementing.
+.hpm_events       (hpm_events       ), // Performance monitor events.
 .trap_cpu         (trap_cpu         ), // A trap occured due to CPU
 .trap_int         (trap_int         ), // A trap occured due to interrupt
 .trap_cause       (trap_cause       ), // A trap occured due to interrupt
@@ -340,3 +340,109 @@ assign err = 1'b0;
 
 				
 endmodule
+
+
+//
+// module: mem_sram_dp_wxd
+//
+//  True dual-port memory for use with Xilinx FPGAs.
+//  Same ports and behaviour as the simulation model, using the
+//  xpm_memory_tdpram macro. Both ports share the same clock.
+//
+module mem_sram_dp_wxd  #(
+parameter           WIDTH =  64,  // Width of each memory word.
+parameter           DEPTH =1024,  // Number of 64-bit wordsin the memory.
+parameter [255*8:0] MEMH  = ""    // Memory file to read.
+)(
+input  wire         g_clk       ,
+input  wire         g_resetn    ,
+
+input  wire         a_cen       , // Port A enable
+input  wire [S:0]   a_wstrb     , // Port A write strobe
+input  wire [A:0]   a_addr      , // Port A word address
+input  wire [W:0]   a_wdata     , // Port A write data
+output wire [W:0]   a_rdata     , // Port A read data
+output wire         a_err       , // Port A error
+
+input  wire         b_cen       , // Port B enable
+input  wire [S:0]   b_wstrb     , // Port B write strobe
+input  wire [A:0]   b_addr      , // Port B word address
+input  wire [W:0]   b_wdata     , // Port B write data
+output wire [W:0]   b_rdata     , // Port B read data
+output wire         b_err         // Port B error
+);
+
+localparam W      = WIDTH-1;
+localparam S      = WIDTH/8-1;
+localparam A      = $clog2(DEPTH)-1; 
+localparam AX     = A + 1; 
+
+localparam SIZE_BITS= WIDTH*DEPTH;
+
+initial $display("Loading file: %s",MEMH);
+
+assign a_err = 1'b0;
+assign b_err = 1'b0;
+
+   // xpm_memory_tdpram: True Dual Port RAM
+   // Xilinx Parameterized Macro, version 2019.2
+
+   xpm_memory_tdpram #(
+      .ADDR_WIDTH_A(AX),             // DECIMAL
+      .ADDR_WIDTH_B(AX),             // DECIMAL
+      .AUTO_SLEEP_TIME(0),           // DECIMAL
+      .BYTE_WRITE_WIDTH_A(8),        // DECIMAL
+      .BYTE_WRITE_WIDTH_B(8),        // DECIMAL
+      .CASCADE_HEIGHT(0),            // DECIMAL
+      .CLOCKING_MODE("common_clock"),// String
+      .ECC_MODE("no_ecc"),           // String
+      .MEMORY_INIT_FILE(MEMH),       // String
+      .MEMORY_INIT_PARAM(""),        // String
+      .MEMORY_OPTIMIZATION("true"),  // String
+      .MEMORY_PRIMITIVE("block"),    // String
+      .MEMORY_SIZE(SIZE_BITS),       // DECIMAL
+      .MESSAGE_CONTROL(0),           // DECIMAL
+      .READ_DATA_WIDTH_A(WIDTH),     // DECIMAL
+      .READ_DATA_WIDTH_B(WIDTH),     // DECIMAL
+      .READ_LATENCY_A(1),            // DECIMAL
+      .READ_LATENCY_B(1),            // DECIMAL
+      .READ_RESET_VALUE_A("0"),      // String
+      .READ_RESET_VALUE_B("0"),      // String
+      .RST_MODE_A("SYNC"),           // String
+      .RST_MODE_B("SYNC"),           // String
+      .SIM_ASSERT_CHK(1),            // DECIMAL
+      .USE_EMBEDDED_CONSTRAINT(0),   // DECIMAL
+      .USE_MEM_INIT(1),              // DECIMAL
+      .WAKEUP_TIME("disable_sleep"), // String
+      .WRITE_DATA_WIDTH_A(WIDTH),    // DECIMAL
+      .WRITE_DATA_WIDTH_B(WIDTH),    // DECIMAL
+      .WRITE_MODE_A("read_first"),   // String
+      .WRITE_MODE_B("read_first")    // String
+   )
+   xpm_memory_tdpram_inst (
+      .douta(a_rdata),                 // Data output for port A read operations.
+      .doutb(b_rdata),                 // Data output for port B read operations.
+      .addra(a_addr ),                 // Address for port A write and read operations.
+      .addrb(b_addr ),                 // Address for port B write and read operations.
+      .clka(g_clk),                    // Clock signal for port A.
+      .clkb(g_clk),                    // Unused when CLOCKING_MODE is "common_clock".
+      .dina(a_wdata),                  // Data input for port A write operations.
+      .dinb(b_wdata),                  // Data input for port B write operations.
+      .ena(a_cen),                     // Memory enable signal for port A.
+      .enb(b_cen),                     // Memory enable signal for port B.
+      .injectdbiterra(1'b0),           // ECC disabled.
+      .injectdbiterrb(1'b0),           // ECC disabled.
+      .injectsbiterra(1'b0),           // ECC disabled.
+      .injectsbiterrb(1'b0),           // ECC disabled.
+      .regcea(a_cen),                  // Clock Enable for the last register stage, port A.
+      .regceb(b_cen),                  // Clock Enable for the last register stage, port B.
+      .rsta(!g_resetn),                // Reset for the final port A output register stage.
+      .rstb(!g_resetn),                // Reset for the final port B output register stage.
+      .sleep(1'b0 ),                   // Dynamic power saving disabled.
+      .wea(a_wstrb),                   // Byte write enables for port A.
+      .web(b_wstrb)                    // Byte write enables for port B.
+   );
+
+   // End of xpm_memory_tdpram_inst instantiation
+
+endmodule
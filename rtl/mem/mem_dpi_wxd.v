@@ -0,0 +1,96 @@
+
+//
+// module: mem_dpi_wxd
+//
+//  A simulation memory model whose storage lives in the testbench.
+//  - 64 bit wide words
+//  - D words deep
+//  - 8 per-byte write strobes
+//  - Optional ROM switch. ROM writes are dropped and flagged as errors.
+//  - Optional second port, as per mem_sram_dp_wxd. If both ports
+//    write the same byte in the same cycle, port A wins. Reads always
+//    return the data from before any write in the same cycle.
+//  - Every access is forwarded to the mem_dpi_read / mem_dpi_write
+//    DPI functions, at byte address BASE + (addr * 8). The testbench
+//    maps these onto its memory_bus, so programs are loaded, and
+//    results read back, without going through the RTL at all.
+//    See verif/share/verilator/memory_dpi.hpp
+//
+module mem_dpi_wxd  #(
+parameter           ROM   =   0,  // Is this a read only memory?
+parameter           DEPTH =1024,  // Number of 64-bit words in the memory.
+parameter [63:0]    BASE  =   0   // Byte address of word zero.
+)(
+input  wire         g_clk       ,
+input  wire         g_resetn    ,
+
+input  wire         a_cen       , // Port A enable
+input  wire [  7:0] a_wstrb     , // Port A write strobe
+input  wire [WAW:0] a_addr      , // Port A word address
+input  wire [ 63:0] a_wdata     , // Port A write data
+output reg  [ 63:0] a_rdata     , // Port A read data
+output reg          a_err       , // Port A error
+
+input  wire         b_cen       , // Port B enable. Tie low if unused.
+input  wire [  7:0] b_wstrb     , // Port B write strobe
+input  wire [WAW:0] b_addr      , // Port B word address
+input  wire [ 63:0] b_wdata     , // Port B write data
+output reg  [ 63:0] b_rdata     , // Port B read data
+output reg          b_err         // Port B error
+);
+
+localparam WORD_ADDR_W  = $clog2(DEPTH);
+localparam WAW          = WORD_ADDR_W - 1;
+
+import "DPI-C" function longint mem_dpi_read (
+    input longint addr
+);
+
+import "DPI-C" function void    mem_dpi_write(
+    input longint addr,
+    input longint data,
+    input byte    strb
+);
+
+// Byte addresses in the testbench memory map.
+wire [63:0] a_byte_addr = BASE + {{(61-WORD_ADDR_W){1'b0}}, a_addr, 3'b000};
+wire [63:0] b_byte_addr = BASE + {{(61-WORD_ADDR_W){1'b0}}, b_addr, 3'b000};
+
+wire        a_wr        = a_cen && |a_wstrb;
+wire        b_wr        = b_cen && |b_wstrb;
+
+//
+// Both ports live in one process, so that the read-before-write and
+// port A priority orderings are fixed.
+always @(posedge g_clk) begin
+    if(a_cen) begin
+        a_rdata <= mem_dpi_read(a_byte_addr);
+    end
+    if(b_cen) begin
+        b_rdata <= mem_dpi_read(b_byte_addr);
+    end
+    if(ROM == 0 && b_wr) begin
+        mem_dpi_write(b_byte_addr, b_wdata, b_wstrb);
+    end
+    if(ROM == 0 && a_wr) begin
+        mem_dpi_write(a_byte_addr, a_wdata, a_wstrb);
+    end
+end
+
+generate if(ROM == 0) begin
+    always @(*) a_err = 1'b0;
+    always @(*) b_err = 1'b0;
+end else begin
+    always @(posedge g_clk) begin
+        if(!g_resetn) begin
+            a_err <= 1'b0;
+            b_err <= 1'b0;
+        end else begin
+            a_err <= a_wr;
+            b_err <= b_wr;
+        end
+    end
+end endgenerate
+
+endmodule
+
@@ -0,0 +1,101 @@
+
+//
+// module: mem_sram_dp_wxd
+//
+//  A simple true dual-port simulation memory model
+//  - W bit wide word
+//  - D words deep
+//  - W/8 per-byte write strobes based, on both ports.
+//  - Configurable pre-loaded memory file.
+//  - Both ports may read and write every cycle. If both ports write
+//    the same byte in the same cycle, port A wins. A read returns the
+//    old data when the other port writes the same word that cycle.
+//
+module mem_sram_dp_wxd  #(
+parameter           WIDTH =  64,  // Width of each memory word.
+parameter           DEPTH =1024,  // Number of 64-bit wordsin the memory.
+/* verilator lint_off WIDTH */
+parameter [255*8:0] MEMH  = ""    // Memory file to read.
+/* verilator lint_on  WIDTH */
+)(
+input  wire         g_clk       ,
+input  wire         g_resetn    ,
+
+input  wire         a_cen       , // Port A enable
+input  wire [BLW:0] a_wstrb     , // Port A write strobe
+input  wire [WAW:0] a_addr      , // Port A word address
+input  wire [DW :0] a_wdata     , // Port A write data
+output reg  [DW :0] a_rdata     , // Port A read data
+output wire         a_err       , // Port A error
+
+input  wire         b_cen       , // Port B enable
+input  wire [BLW:0] b_wstrb     , // Port B write strobe
+input  wire [WAW:0] b_addr      , // Port B word address
+input  wire [DW :0] b_wdata     , // Port B write data
+output reg  [DW :0] b_rdata     , // Port B read data
+output wire         b_err         // Port B error
+);
+
+localparam BYTE_LANES   = WIDTH / 8;
+localparam SIZE_BYTES   = BYTE_LANES * DEPTH;
+localparam WORD_ADDR_W  = $clog2(DEPTH);
+localparam BYTE_ADDR_W  = WORD_ADDR_W + $clog2(BYTE_LANES);
+
+localparam DW           = WIDTH       - 1   ;
+localparam BLW          = BYTE_LANES  - 1   ;
+localparam WAW          = WORD_ADDR_W - 1   ;
+localparam BAW          = BYTE_ADDR_W - 1   ;
+
+// Byte array of memory.
+reg [7:0] mem [SIZE_BYTES-1:0];
+
+// Byte aligned addresses.
+wire [BAW:0] a_addrin = {a_addr, {$clog2(BYTE_LANES){1'b0}}};
+wire [BAW:0] b_addrin = {b_addr, {$clog2(BYTE_LANES){1'b0}}};
+
+initial begin
+    if(MEMH != "") begin
+        $display("Loading file: %s",MEMH);
+        $readmemh(MEMH, mem);
+    end
+end
+
+assign a_err = 1'b0;
+assign b_err = 1'b0;
+
+genvar i;
+
+generate for (i = 0; i < BYTE_LANES; i = i + 1) begin
+
+    wire [BAW:0] idx = i;
+
+    wire a_wr = a_cen && a_wstrb[i];
+    wire b_wr = b_cen && b_wstrb[i] &&
+                !(a_wr && a_addr == b_addr);
+
+    //
+    // Reads
+    always @(posedge g_clk) begin
+        if(a_cen) begin
+            a_rdata[8*i+:8] <= mem[a_addrin | idx];
+        end
+        if(b_cen) begin
+            b_rdata[8*i+:8] <= mem[b_addrin | idx];
+        end
+    end
+
+    //
+    // Writes
+    always @(posedge g_clk) begin
+        if(a_wr) begin
+            mem[a_addrin | idx] <= a_wdata[8*i+:8];
+        end
+        if(b_wr) begin
+            mem[b_addrin | idx] <= b_wdata[8*i+:8];
+        end
+    end
+
+end endgenerate
+
+endmodule
+
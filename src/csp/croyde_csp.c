@@ -4,3 +4,21 @@
 uint64_t volatile * const croyde_csp_mtime    = (uint64_t*)0x20000;
 uint64_t volatile * const croyde_csp_mtimecmp = (uint64_t*)0x20008;
 
+uint64_t volatile * const croyde_csp_tohost    = (uint64_t*)0x11001000;
+uint64_t volatile * const croyde_csp_fromhost  = (uint64_t*)0x11001008;
+uint64_t volatile * const croyde_csp_htif_args = (uint64_t*)0x11001040;
+
+int64_t croyde_csp_htif_syscall(
+    uint64_t n, uint64_t a0, uint64_t a1, uint64_t a2, uint64_t a3
+) {
+    croyde_csp_htif_args[0] = n ;
+    croyde_csp_htif_args[1] = a0;
+    croyde_csp_htif_args[2] = a1;
+    croyde_csp_htif_args[3] = a2;
+    croyde_csp_htif_args[4] = a3;
+    *croyde_csp_fromhost    = 0;
+    *croyde_csp_tohost      = (uint64_t)croyde_csp_htif_args;
+    while(*croyde_csp_fromhost == 0) {}
+    *croyde_csp_fromhost    = 0;
+    return (int64_t)croyde_csp_htif_args[0];
+}
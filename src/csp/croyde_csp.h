@@ -45,5 +45,112 @@ inline uint64_t croyde_csp_rdinstret() {
     return rd;
 }
 
+//
+// Performance monitor event bits, for writing to mhpmevent* registers.
+// A counter increments on each cycle where any selected event is active.
+#define CROYDE_CSP_HPM_FB_EMPTY  (1 << 0) // Fetch buffer has no instruction
+#define CROYDE_CSP_HPM_CF_CHANGE (1 << 1) // Control flow change / flush
+#define CROYDE_CSP_HPM_LSU_STALL (1 << 2) // Load/store stalled in execute
+#define CROYDE_CSP_HPM_MDU_BUSY  (1 << 3) // Multiply/divide in progress
+#define CROYDE_CSP_HPM_IMEM_WAIT (1 << 4) // Instruction memory grant wait
+#define CROYDE_CSP_HPM_DMEM_WAIT (1 << 5) // Data memory grant wait
+#define CROYDE_CSP_HPM_BR_TAKEN  (1 << 6) // Taken branch or jump
+#define CROYDE_CSP_HPM_RET_C     (1 << 7) // Compressed instruction retired
+
+//
+// Access functions for hpmcounterN / mhpmcounterN / mhpmeventN.
+#define CROYDE_CSP_DECL_HPM(N)                                          \
+inline uint64_t croyde_csp_rdhpmcounter##N() {                          \
+    uint64_t rd;                                                        \
+    asm volatile("csrr %0, hpmcounter" #N :"=r"(rd):);                  \
+    return rd;                                                          \
+}                                                                       \
+inline void croyde_csp_wrmhpmcounter##N(uint64_t new_value) {           \
+    asm volatile("csrw mhpmcounter" #N ", %0"::"r"(new_value));         \
+}                                                                       \
+inline uint64_t croyde_csp_rdmhpmevent##N() {                           \
+    uint64_t rd;                                                        \
+    asm volatile("csrr %0, mhpmevent" #N :"=r"(rd):);                   \
+    return rd;                                                          \
+}                                                                       \
+inline void croyde_csp_wrmhpmevent##N(uint64_t new_value) {             \
+    asm volatile("csrw mhpmevent" #N ", %0"::"r"(new_value));           \
+}
+
+CROYDE_CSP_DECL_HPM(3)
+CROYDE_CSP_DECL_HPM(4)
+CROYDE_CSP_DECL_HPM(5)
+CROYDE_CSP_DECL_HPM(6)
+
+//
+// Region of interest markers. The Verilator testbench counts cycles and
+// instructions separately for each region, and can limit waves and the
+// pipeline view to them. They are HINTs, so do nothing anywhere else.
+// ID is a constant 0..1023. NAME is a string, or 0 for none. The nop stops
+// the register holding NAME being overwritten before the testbench reads it.
+#define CROYDE_CSP_ROI_BEGIN(ID, NAME)                                  \
+    asm volatile("slti x0, %z0, %1\n\tnop" ::                           \
+                 "rJ"((uint64_t)(NAME)), "i"(((ID) & 0x3FF) << 1)       \
+                 : "memory")
+
+#define CROYDE_CSP_ROI_END(ID)                                          \
+    asm volatile("slti x0, x0, %0\n\tnop" ::                            \
+                 "i"((((ID) & 0x3FF) << 1) | 1)                         \
+                 : "memory")
+
+//
+// Host interface (HTIF). Only present in the Verilator testbenches.
+// Syscall buffers must be visible to the testbench memory bus. In the
+// CCX, the internal RAM is only visible when built with MEM_DPI=1.
+#define CROYDE_CSP_HTIF_SYS_OPENAT   56
+#define CROYDE_CSP_HTIF_SYS_CLOSE    57
+#define CROYDE_CSP_HTIF_SYS_LSEEK    62
+#define CROYDE_CSP_HTIF_SYS_READ     63
+#define CROYDE_CSP_HTIF_SYS_WRITE    64
+#define CROYDE_CSP_HTIF_SYS_EXIT     93
+#define CROYDE_CSP_HTIF_SYS_OPEN   1024
+
+#define CROYDE_CSP_HTIF_O_RDONLY  0x000
+#define CROYDE_CSP_HTIF_O_WRONLY  0x001
+#define CROYDE_CSP_HTIF_O_RDWR    0x002
+#define CROYDE_CSP_HTIF_O_CREAT   0x040
+#define CROYDE_CSP_HTIF_O_EXCL    0x080
+#define CROYDE_CSP_HTIF_O_TRUNC   0x200
+#define CROYDE_CSP_HTIF_O_APPEND  0x400
+
+uint64_t volatile * const croyde_csp_tohost   ;
+uint64_t volatile * const croyde_csp_fromhost ;
+uint64_t volatile * const croyde_csp_htif_args;
+
+//! Run a host syscall. Returns its result, or -errno on failure.
+int64_t croyde_csp_htif_syscall(
+    uint64_t n, uint64_t a0, uint64_t a1, uint64_t a2, uint64_t a3
+);
+
+//! End the simulation with the given exit code. 0 means pass.
+inline void croyde_csp_htif_exit(uint64_t code) {
+    *croyde_csp_tohost = (code << 1) | 1;
+    while(1) {}
+}
+
+inline int64_t croyde_csp_htif_write(int fd, const void * buf, uint64_t len) {
+    return croyde_csp_htif_syscall(
+        CROYDE_CSP_HTIF_SYS_WRITE, fd, (uint64_t)buf, len, 0);
+}
+
+inline int64_t croyde_csp_htif_read(int fd, void * buf, uint64_t len) {
+    return croyde_csp_htif_syscall(
+        CROYDE_CSP_HTIF_SYS_READ, fd, (uint64_t)buf, len, 0);
+}
+
+inline int64_t croyde_csp_htif_open(const char * path, int flags) {
+    return croyde_csp_htif_syscall(
+        CROYDE_CSP_HTIF_SYS_OPEN, (uint64_t)path, flags, 0644, 0);
+}
+
+inline int64_t croyde_csp_htif_close(int fd) {
+    return croyde_csp_htif_syscall(CROYDE_CSP_HTIF_SYS_CLOSE, fd, 0, 0, 0);
+}
+
 #endif
 
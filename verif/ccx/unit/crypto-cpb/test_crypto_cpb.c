@@ -0,0 +1,228 @@
+
+#include "croyde_csp.h"
+#include "unit_test.h"
+
+//
+// Measures cycles per byte for AES-128, AES-256 and SM4 block encryption
+// using the scalar crypto instructions, and checks each result against
+// the FIPS-197 / GB/T 32907 test vectors.
+//
+// All block words are little-endian loads of the standard byte strings.
+
+//! Number of blocks encrypted per measurement.
+#define BLOCKS 4
+
+#define AES64KS1I(RD, RS1, RNUM) \
+    asm volatile("aes64ks1i %0, %1, %2" : "=r"(RD) : "r"(RS1), "i"(RNUM))
+
+static inline uint64_t aes64ks2(uint64_t rs1, uint64_t rs2) {
+    uint64_t rd;
+    asm volatile("aes64ks2 %0, %1, %2" : "=r"(rd) : "r"(rs1), "r"(rs2));
+    return rd;
+}
+
+static inline uint64_t aes64es(uint64_t rs1, uint64_t rs2) {
+    uint64_t rd;
+    asm volatile("aes64es %0, %1, %2" : "=r"(rd) : "r"(rs1), "r"(rs2));
+    return rd;
+}
+
+static inline uint64_t aes64esm(uint64_t rs1, uint64_t rs2) {
+    uint64_t rd;
+    asm volatile("aes64esm %0, %1, %2" : "=r"(rd) : "r"(rs1), "r"(rs2));
+    return rd;
+}
+
+#define SM4ED(RD, RS2, BS) \
+    asm volatile("sm4ed %0, %0, %1, %2" : "+r"(RD) : "r"(RS2), "i"(BS))
+
+#define SM4KS(RD, RS2, BS) \
+    asm volatile("sm4ks %0, %0, %1, %2" : "+r"(RD) : "r"(RS2), "i"(BS))
+
+// FIPS-197 appendix C.1 and C.3 vectors.
+const uint64_t aes_key[4] = {
+    0x0706050403020100, 0x0f0e0d0c0b0a0908,
+    0x1716151413121110, 0x1f1e1d1c1b1a1918
+};
+const uint64_t aes_pt [2] = {0x7766554433221100, 0xffeeddccbbaa9988};
+const uint64_t aes128_ct[2] = {0x30047b6ad8e0c469, 0x5ac5b47080b7cdd8};
+const uint64_t aes256_ct[2] = {0xbf456751cab7a28e, 0x8960494b9049fcea};
+
+// GB/T 32907 example 1. The key and plaintext are the same.
+const uint32_t sm4_pt [4] = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476};
+const uint32_t sm4_ct [4] = {0x34df1e68, 0x5e9606d2, 0x4fe9b386, 0x46426e53};
+const uint32_t sm4_fk [4] = {0xc6bab1a3, 0x5033aa56, 0x97917d67, 0xdc2270b2};
+
+uint64_t aes_rk [30];
+uint32_t sm4_rk [32];
+
+uint64_t aes_out[2*BLOCKS];
+uint32_t sm4_out[4*BLOCKS];
+
+//
+// AES
+// ------------------------------------------------------------
+
+#define AES128_KS_STEP(I) {                                 \
+    uint64_t t; AES64KS1I(t, rk[2*I+1], I);                 \
+    rk[2*I+2] = aes64ks2(t        , rk[2*I+0]);             \
+    rk[2*I+3] = aes64ks2(rk[2*I+2], rk[2*I+1]);             \
+}
+
+void aes128_key_schedule(uint64_t rk[22], const uint64_t key[2]) {
+    rk[0] = key[0];
+    rk[1] = key[1];
+    AES128_KS_STEP(0) AES128_KS_STEP(1) AES128_KS_STEP(2)
+    AES128_KS_STEP(3) AES128_KS_STEP(4) AES128_KS_STEP(5)
+    AES128_KS_STEP(6) AES128_KS_STEP(7) AES128_KS_STEP(8)
+    AES128_KS_STEP(9)
+}
+
+#define AES256_KS_HALF(I) {                                 \
+    uint64_t t; AES64KS1I(t, rk[4*I+3], I);                 \
+    rk[4*I+4] = aes64ks2(t        , rk[4*I+0]);             \
+    rk[4*I+5] = aes64ks2(rk[4*I+4], rk[4*I+1]);             \
+}
+
+#define AES256_KS_STEP(I) {                                 \
+    AES256_KS_HALF(I)                                       \
+    uint64_t t; AES64KS1I(t, rk[4*I+5], 0xA);               \
+    rk[4*I+6] = aes64ks2(t        , rk[4*I+2]);             \
+    rk[4*I+7] = aes64ks2(rk[4*I+6], rk[4*I+3]);             \
+}
+
+void aes256_key_schedule(uint64_t rk[30], const uint64_t key[4]) {
+    rk[0] = key[0];
+    rk[1] = key[1];
+    rk[2] = key[2];
+    rk[3] = key[3];
+    AES256_KS_STEP(0) AES256_KS_STEP(1) AES256_KS_STEP(2)
+    AES256_KS_STEP(3) AES256_KS_STEP(4) AES256_KS_STEP(5)
+    AES256_KS_HALF(6)
+}
+
+//! Encrypt the same plaintext block "blocks" times, with nr rounds.
+void aes_enc_blocks(
+    uint64_t * ct, const uint64_t * pt, const uint64_t * rk, int nr, int blocks
+) {
+    for(int b = 0; b < blocks; b ++) {
+        uint64_t n0 = pt[0] ^ rk[0];
+        uint64_t n1 = pt[1] ^ rk[1];
+        for(int r = 1; r < nr; r ++) {
+            uint64_t t0 = aes64esm(n0, n1);
+            uint64_t t1 = aes64esm(n1, n0);
+            n0 = t0 ^ rk[2*r+0];
+            n1 = t1 ^ rk[2*r+1];
+        }
+        ct[2*b+0] = aes64es(n0, n1) ^ rk[2*nr+0];
+        ct[2*b+1] = aes64es(n1, n0) ^ rk[2*nr+1];
+    }
+}
+
+//
+// SM4
+// ------------------------------------------------------------
+
+void sm4_key_schedule(uint32_t rk[32], const uint32_t mk[4]) {
+    uint32_t k0 = mk[0] ^ sm4_fk[0];
+    uint32_t k1 = mk[1] ^ sm4_fk[1];
+    uint32_t k2 = mk[2] ^ sm4_fk[2];
+    uint32_t k3 = mk[3] ^ sm4_fk[3];
+    for(int i = 0; i < 32; i ++) {
+        uint32_t ck = 0;
+        for(int j = 0; j < 4; j ++) {
+            ck |= (uint32_t)(((4*i+j)*7) & 0xFF) << (8*j);
+        }
+        uint32_t t = k1 ^ k2 ^ k3 ^ ck;
+        SM4KS(k0, t, 0); SM4KS(k0, t, 1); SM4KS(k0, t, 2); SM4KS(k0, t, 3);
+        rk[i] = k0;
+        k0 = k1; k1 = k2; k2 = k3; k3 = rk[i];
+    }
+}
+
+//! Encrypt the same plaintext block "blocks" times.
+void sm4_enc_blocks(
+    uint32_t * ct, const uint32_t * pt, const uint32_t * rk, int blocks
+) {
+    for(int b = 0; b < blocks; b ++) {
+        uint32_t x0 = pt[0], x1 = pt[1], x2 = pt[2], x3 = pt[3];
+        for(int i = 0; i < 32; i ++) {
+            uint32_t t = x1 ^ x2 ^ x3 ^ rk[i];
+            SM4ED(x0, t, 0); SM4ED(x0, t, 1); SM4ED(x0, t, 2); SM4ED(x0, t, 3);
+            uint32_t n = x0;
+            x0 = x1; x1 = x2; x2 = x3; x3 = n;
+        }
+        ct[4*b+0] = x3;
+        ct[4*b+1] = x2;
+        ct[4*b+2] = x1;
+        ct[4*b+3] = x0;
+    }
+}
+
+//
+// Measurement
+// ------------------------------------------------------------
+
+//! Print the cycles taken to encrypt BLOCKS blocks, and cycles / byte.
+void report(char * name, uint64_t cycles) {
+    __putstr(name);
+    __putstr(": cycles=0x");
+    __puthex64_nlz(cycles);
+    __putstr(" bytes=0x");
+    __puthex64_nlz(16*BLOCKS);
+    __putstr(" cycles/byte=0x");
+    __puthex64_nlz(cycles / (16*BLOCKS));
+    __putstr("\n");
+}
+
+int test_main() {
+
+    uint64_t start, end;
+
+    // AES-128
+    aes128_key_schedule(aes_rk, aes_key);
+    start = croyde_csp_rdcycle();
+    aes_enc_blocks(aes_out, aes_pt, aes_rk, 10, BLOCKS);
+    end   = croyde_csp_rdcycle();
+    report("AES-128", end - start);
+
+    for(int b = 0; b < BLOCKS; b ++) {
+        if(aes_out[2*b] != aes128_ct[0] || aes_out[2*b+1] != aes128_ct[1]) {
+            __putstr("AES-128 ciphertext mismatch.\n");
+            return 1;
+        }
+    }
+
+    // AES-256
+    aes256_key_schedule(aes_rk, aes_key);
+    start = croyde_csp_rdcycle();
+    aes_enc_blocks(aes_out, aes_pt, aes_rk, 14, BLOCKS);
+    end   = croyde_csp_rdcycle();
+    report("AES-256", end - start);
+
+    for(int b = 0; b < BLOCKS; b ++) {
+        if(aes_out[2*b] != aes256_ct[0] || aes_out[2*b+1] != aes256_ct[1]) {
+            __putstr("AES-256 ciphertext mismatch.\n");
+            return 2;
+        }
+    }
+
+    // SM4
+    sm4_key_schedule(sm4_rk, sm4_pt);
+    start = croyde_csp_rdcycle();
+    sm4_enc_blocks(sm4_out, sm4_pt, sm4_rk, BLOCKS);
+    end   = croyde_csp_rdcycle();
+    report("SM4    ", end - start);
+
+    for(int b = 0; b < BLOCKS; b ++) {
+        for(int i = 0; i < 4; i ++) {
+            if(sm4_out[4*b+i] != sm4_ct[i]) {
+                __putstr("SM4 ciphertext mismatch.\n");
+                return 3;
+            }
+        }
+    }
+
+    return 0;
+
+}
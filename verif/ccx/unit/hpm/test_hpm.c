@@ -0,0 +1,108 @@
+
+#include "croyde_csp.h"
+#include "unit_test.h"
+
+// Kept volatile so the compiler cannot fold the divide away.
+volatile uint64_t dividend = 0x123456789ABCDEF0;
+volatile uint64_t divisor  = 0x3;
+
+//! Runs a loop with a known number of taken backwards branches.
+void __attribute__((noinline)) branch_loop(int n) {
+    for(volatile int i = 0; i < n; i ++) {
+        asm volatile("nop");
+    }
+}
+
+/*!
+@brief Test the mhpmcounter / mhpmevent performance monitor counters.
+@note Assumes at least 4 counters (mhpmcounter3..6) are implemented.
+*/
+int test_main() {
+
+    __wrmcountinhibit(0x0);
+
+    croyde_csp_wrmhpmevent3(CROYDE_CSP_HPM_BR_TAKEN );
+    croyde_csp_wrmhpmevent4(CROYDE_CSP_HPM_MDU_BUSY );
+    croyde_csp_wrmhpmevent5(CROYDE_CSP_HPM_RET_C    );
+    croyde_csp_wrmhpmevent6(CROYDE_CSP_HPM_CF_CHANGE);
+
+    if(croyde_csp_rdmhpmevent3() != CROYDE_CSP_HPM_BR_TAKEN) {
+        __putstr("mhpmevent3 did not read back the written value.\n");
+        return 1;
+    }
+
+    croyde_csp_wrmhpmcounter3(0);
+    croyde_csp_wrmhpmcounter4(0);
+    croyde_csp_wrmhpmcounter5(0);
+    croyde_csp_wrmhpmcounter6(0);
+
+    branch_loop(10);
+
+    volatile uint64_t quotient = dividend / divisor;
+
+    uint64_t br_taken   = croyde_csp_rdhpmcounter3();
+    uint64_t mdu_busy   = croyde_csp_rdhpmcounter4();
+    uint64_t ret_c      = croyde_csp_rdhpmcounter5();
+    uint64_t cf_change  = croyde_csp_rdhpmcounter6();
+
+    if(quotient != 0x0611722833944A50) {
+        __putstr("Unexpected divide result.\n");
+        return 2;
+    }
+
+    if(br_taken < 10) {
+        __putstr("Expected at least 10 taken branches.\n");
+        __puthex64(br_taken);
+        return 3;
+    }
+
+    if(mdu_busy == 0) {
+        __putstr("Expected MDU busy cycles from the divide.\n");
+        return 4;
+    }
+
+    if(ret_c == 0) {
+        __putstr("Expected compressed instructions to retire.\n");
+        return 5;
+    }
+
+    if(cf_change < br_taken) {
+        __putstr("Every taken branch should also be a CF change.\n");
+        return 6;
+    }
+
+    // Inhibit mhpmcounter3. It should not change while the loop runs.
+    __wrmcountinhibit(0x1 << 3);
+
+    uint64_t a_br_taken = croyde_csp_rdhpmcounter3();
+    branch_loop(10);
+    uint64_t b_br_taken = croyde_csp_rdhpmcounter3();
+
+    if(a_br_taken != b_br_taken) {
+        __putstr("mhpmcounter3 inhibited, should not change.\n");
+        return 7;
+    }
+
+    // Re-enable it, and check it counts again.
+    __wrmcountinhibit(0x0);
+
+    branch_loop(10);
+    b_br_taken = croyde_csp_rdhpmcounter3();
+
+    if(b_br_taken < a_br_taken + 10) {
+        __putstr("mhpmcounter3 re-enabled, should count again.\n");
+        return 8;
+    }
+
+    // Unimplemented counters read as zero.
+    uint64_t hpm31;
+    asm volatile("csrr %0, hpmcounter31":"=r"(hpm31):);
+
+    if(hpm31 != 0) {
+        __putstr("Unimplemented hpmcounter31 should read as zero.\n");
+        return 9;
+    }
+
+    return 0;
+
+}
@@ -0,0 +1,243 @@
+#include "croyde_csp.h"
+#include "unit_test.h"
+
+//
+// Checks misaligned loads and stores of every size and offset.
+//
+// - With CORE_MISALIGNED_HW=0, every misaligned access must raise an
+//   alignment trap, and stores must not modify memory.
+// - With CORE_MISALIGNED_HW=1, no access may trap and every result must
+//   match a byte-wise reference. The test then times parsing a stream of
+//   packed records with misaligned loads against byte-wise loads.
+//
+
+//! Trap handler wrapper which saves registers and calls test_trap_handler.
+extern void __access_traps_trap_handler();
+
+volatile int    trap_seen   = 0; // Number of alignment traps taken.
+volatile int    trap_bad    = 0; // Set on any other trap.
+
+void test_trap_handler() {
+
+    uint64_t cause = rd_mcause();
+
+    if(cause != CAUSE_CODE_LDALIGN && cause != CAUSE_CODE_STALIGN) {
+        trap_bad = 1;
+    }
+
+    // Step over the faulting instruction.
+    uint64_t mepc = rd_mepc();
+    uint8_t  ib   = ((uint8_t*)mepc)[0];
+    mepc         += 2;
+    if((ib & 0x3) == 0x3) {
+        mepc += 2;
+    }
+    wr_mepc(mepc);
+
+    trap_seen += 1;
+}
+
+static volatile uint8_t buf[32] __attribute__((aligned(8)));
+
+//! Fill buf with a known pattern.
+static void fill_buf() {
+    for(int i = 0; i < sizeof(buf); i ++) {
+        buf[i] = 0x80 + 0x11*i;
+    }
+}
+
+//! Little-endian byte-wise reference load.
+static uint64_t ref_load(int off, int bytes) {
+    uint64_t r = 0;
+    for(int i = bytes - 1; i >= 0; i --) {
+        r = (r << 8) | buf[off + i];
+    }
+    return r;
+}
+
+//! Sign extend the low bytes of a value.
+static uint64_t sext(uint64_t v, int bytes) {
+    int sh = 64 - 8*bytes;
+    return (uint64_t)(((int64_t)(v << sh)) >> sh);
+}
+
+//! Perform one load of the given size and signedness at buf+off.
+static uint64_t do_load(int off, int bytes, int sign) {
+    volatile uint8_t * p = buf + off;
+    switch(bytes) {
+        case 2 : return sign ? (uint64_t)*(volatile int16_t *)p :
+                               (uint64_t)*(volatile uint16_t*)p ;
+        case 4 : return sign ? (uint64_t)*(volatile int32_t *)p :
+                               (uint64_t)*(volatile uint32_t*)p ;
+        default: return        (uint64_t)*(volatile uint64_t*)p ;
+    }
+}
+
+//! Perform one store of the given size at buf+off.
+static void do_store(int off, int bytes, uint64_t v) {
+    volatile uint8_t * p = buf + off;
+    switch(bytes) {
+        case 2 : *(volatile uint16_t*)p = v; break;
+        case 4 : *(volatile uint32_t*)p = v; break;
+        default: *(volatile uint64_t*)p = v; break;
+    }
+}
+
+//! Check every load/store size at every offset in a double-word.
+//! Returns the number of accesses which trapped.
+static int check_accesses() {
+
+    int traps = 0;
+
+    for(int bytes = 2; bytes <= 8; bytes *= 2) {
+        for(int off = 8; off < 16; off ++) {
+            for(int sign = 0; sign < 2; sign ++) {
+
+                fill_buf();
+
+                int      before = trap_seen;
+                uint64_t v      = do_load(off, bytes, sign);
+                uint64_t exp    = ref_load(off, bytes);
+
+                if(sign) {
+                    exp = sext(exp, bytes);
+                }
+
+                if(trap_seen != before) {
+                    traps ++;
+                    if(off % bytes == 0) {
+                        __putstr("Aligned load trapped.\n");
+                        test_fail();
+                    }
+                } else if(v != exp) {
+                    __putstr("Load data mismatch.\n");
+                    test_fail();
+                }
+            }
+
+            fill_buf();
+
+            uint64_t wv     = 0x0123456789ABCDEF;
+            int      before = trap_seen;
+
+            do_store(off, bytes, wv);
+
+            int      trapped= trap_seen != before;
+
+            if(trapped) {
+                traps ++;
+                if(off % bytes == 0) {
+                    __putstr("Aligned store trapped.\n");
+                    test_fail();
+                }
+            }
+
+            for(int i = 0; i < sizeof(buf); i ++) {
+                uint8_t exp = 0x80 + 0x11*i;
+                if(!trapped && i >= off && i < off + bytes) {
+                    exp = (wv >> (8*(i - off))) & 0xFF;
+                }
+                if(buf[i] != exp) {
+                    __putstr("Store data mismatch.\n");
+                    test_fail();
+                }
+            }
+        }
+    }
+
+    return traps;
+}
+
+//
+// Packed record parsing, as found in network headers.
+// ------------------------------------------------------------
+
+#define RECORD_BYTES 7
+#define RECORDS      16
+
+static uint8_t stream[RECORD_BYTES*RECORDS] __attribute__((aligned(8)));
+
+//! Sum the fields of each {u16 id; u32 len; u8 flags} record.
+static uint64_t parse_misaligned() {
+    uint64_t sum = 0;
+    for(int i = 0; i < RECORDS; i ++) {
+        uint8_t * r = stream + RECORD_BYTES*i;
+        sum += *(volatile uint16_t*)(r + 0);
+        sum += *(volatile uint32_t*)(r + 2);
+        sum += r[6];
+    }
+    return sum;
+}
+
+//! As parse_misaligned, but assembling each field from byte loads.
+static uint64_t parse_bytewise() {
+    uint64_t sum = 0;
+    for(int i = 0; i < RECORDS; i ++) {
+        volatile uint8_t * r = stream + RECORD_BYTES*i;
+        sum += (uint16_t)(r[0] | r[1] << 8);
+        sum += (uint32_t)(r[2] | r[3] << 8 | r[4] << 16 | (uint32_t)r[5] << 24);
+        sum += r[6];
+    }
+    return sum;
+}
+
+static void report(char * name, uint64_t cycles) {
+    __putstr(name);
+    __putstr(": cycles=0x");
+    __puthex64_nlz(cycles);
+    __putstr("\n");
+}
+
+int test_main() {
+
+    uint64_t old_mtvec = rd_mtvec();
+
+    wr_mtvec((uint64_t)&__access_traps_trap_handler);
+
+    int traps = check_accesses();
+
+    wr_mtvec(old_mtvec);
+
+    if(trap_bad) {
+        __putstr("Unexpected trap cause.\n");
+        test_fail();
+    }
+
+    // 2, 4 and 8 byte sizes have 4, 6 and 7 misaligned offsets in a
+    // double-word. Each offset has 2 loads and 1 store.
+    int misaligned = 3*(4 + 6 + 7);
+
+    if(traps == misaligned) {
+        __putstr("Misaligned accesses trap.\n");
+        return 0;
+    } else if(traps != 0) {
+        __putstr("Only some misaligned accesses trapped.\n");
+        test_fail();
+    }
+
+    __putstr("Misaligned accesses handled in hardware.\n");
+
+    for(int i = 0; i < sizeof(stream); i ++) {
+        stream[i] = 0x3 + 0x25*i;
+    }
+
+    uint64_t start, end, sum_m, sum_b;
+
+    start = croyde_csp_rdcycle();
+    sum_m = parse_misaligned();
+    end   = croyde_csp_rdcycle();
+    report("misaligned loads", end - start);
+
+    start = croyde_csp_rdcycle();
+    sum_b = parse_bytewise();
+    end   = croyde_csp_rdcycle();
+    report("byte-wise loads ", end - start);
+
+    if(sum_m != sum_b) {
+        __putstr("Record parse mismatch.\n");
+        test_fail();
+    }
+
+    return 0;
+
+}
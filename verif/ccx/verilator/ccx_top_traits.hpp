@@ -0,0 +1,161 @@
+
+#include <iostream>
+
+#include "memory_bus.hpp"
+#include "memory_device_ram.hpp"
+#include "memory_dpi.hpp"
+#include "dut_wrapper.hpp"
+#include "core_state.hpp"
+
+// Build against the AXI4 external port variant of the CCX?
+#ifdef CCX_AXI4
+#include "Vccx_top_axi4.h"
+#include "Vccx_top_axi4___024root.h"
+#include "axi_slave_agent.hpp"
+typedef Vccx_top_axi4   Vccx_dut;
+#define CCX_COUNTERS(SIG) \
+    rootp -> ccx_top_axi4__DOT__i_ccx_top__DOT__i_core_counters__DOT__ ## SIG
+#define CCX_CORE_TOP ccx_top_axi4__DOT__i_ccx_top__DOT__i_core_top
+#else
+#include "Vccx_top.h"
+#include "Vccx_top___024root.h"
+#include "core_mem_agent.hpp"
+typedef Vccx_top        Vccx_dut;
+#define CCX_COUNTERS(SIG) \
+    rootp -> ccx_top__DOT__i_core_counters__DOT__ ## SIG
+#define CCX_CORE_TOP ccx_top__DOT__i_core_top
+#endif
+
+#ifndef CCX_TOP_TRAITS_HPP
+#define CCX_TOP_TRAITS_HPP
+
+#ifdef CCX_AXI4
+AXI_SLAVE_PORT(ccx_top_ext_port, Vccx_dut, axi)
+#else
+CORE_MEM_PORT (ccx_top_ext_port, Vccx_dut, emem)
+#endif
+
+/*!
+@brief Binds dut_wrapper and testbench to the ccx_top / ccx_top_axi4
+    ports.
+*/
+struct ccx_top_traits {
+
+    typedef Vccx_dut top_t;
+
+#ifdef CCX_AXI4
+    static const char * name() {return "ccx_top_axi4";}
+#else
+    static const char * name() {return "ccx_top";}
+#endif
+
+    //! The external memory agent.
+    struct agents_t {
+
+#ifdef CCX_AXI4
+        axi_slave_agent<ccx_top_ext_port> ext;
+#else
+        core_mem_agent <ccx_top_ext_port> ext;
+#endif
+
+        agents_t (
+            top_t      * dut,
+            memory_bus * mem
+        ) : ext(dut, mem) {}
+
+        void set_reset    () { ext.set_reset    (); }
+        void clear_reset  () { ext.clear_reset  (); }
+        void posedge_clk  () { ext.posedge_clk  (); }
+        void drive_signals() { ext.drive_signals(); }
+
+        uint64_t max_wait () { return ext.max_wait(); }
+
+        void print_outstanding(std::ostream & os) {
+            ext.print_outstanding(os);
+        }
+
+#ifdef CCX_AXI4
+        void configure(dut_agent_cfg_t const & cfg) {
+            ext.rd_latency    = cfg.axi_rd_latency;
+            ext.wr_latency    = cfg.axi_wr_latency;
+            ext.beat_interval = cfg.axi_beat_interval;
+        }
+
+        void print_stats(std::ostream & os) {
+            ext.print_stats(os);
+        }
+#else
+        void configure(dut_agent_cfg_t const & cfg) {
+            ext.max_req_stall = cfg.mem_max_stall;
+        }
+
+        void print_stats(std::ostream & os) {}
+#endif
+
+    };
+
+    static const int trace_lanes = 1;
+
+    static bool     trs_valid(top_t * d, int lane) {return d -> trs_valid;}
+    static uint64_t trs_pc   (top_t * d, int lane) {return d -> trs_pc   ;}
+    static uint32_t trs_instr(top_t * d, int lane) {return d -> trs_instr;}
+
+    //! Pointer to general purpose register idx, or NULL for x0.
+    static uint64_t * gpr(top_t * d, unsigned idx) {
+        CORE_GPR_SWITCH(d -> rootp, CCX_CORE_TOP, idx)
+    }
+
+    static dut_csrs_t csrs(top_t * d) {
+        CORE_CSRS_RETURN(d -> rootp, CCX_CORE_TOP)
+    }
+
+    //! The core's gated clock domains. See core_clock_ctrl.
+    static const int clock_domains = CORE_CLOCK_DOMAINS;
+
+    static const char * clock_name(int i) {return core_clock_name(i);}
+
+    static bool clock_en(top_t * d, int i) {
+        return CORE_CLOCK_EN(d -> rootp, CCX_CORE_TOP, i);
+    }
+
+    //! Pipeline state for tb_pipeview.
+    static pv_sample_t pipeview(top_t * d) {
+        CORE_PIPEVIEW_RETURN(d -> rootp, CCX_CORE_TOP)
+    }
+
+    //! WFI fast-forward reads and writes the core_counters registers.
+    static const bool has_timer = true;
+
+    static uint64_t & mtime   (top_t * d) {
+        return d -> CCX_COUNTERS(mapped_mtime   );
+    }
+
+    static uint64_t & mtimecmp(top_t * d) {
+        return d -> CCX_COUNTERS(mapped_mtimecmp);
+    }
+
+    static uint64_t & mcycle  (top_t * d) {
+        return d -> CCX_COUNTERS(ctr_cycle      );
+    }
+
+    /*!
+    @brief Add the external RAM and, when built with MEM_DPI, the internal
+        ROM / RAM contents. The internal ranges must match the ccx_top
+        ROM_* / RAM_* parameters.
+    */
+    static void add_devices(memory_bus * bus) {
+
+        bus -> add_device(new memory_device_ram(0x12000000, 0x00010000));
+
+#ifdef CCX_MEM_DPI
+        // The ROM and RAM RTL read and write these devices through DPI.
+        bus -> add_device(new memory_device_ram(0x00000000, 0x00000400));
+        bus -> add_device(new memory_device_ram(0x00010000, 0x00010000));
+
+        memory_dpi_set_bus(bus);
+#endif
+    }
+
+};
+
+#endif
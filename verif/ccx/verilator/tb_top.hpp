@@ -0,0 +1,13 @@
+
+//
+// Selects the top level built by verif/share/verilator/main.cpp.
+//
+
+#include "ccx_top_traits.hpp"
+
+#ifndef TB_TOP_HPP
+#define TB_TOP_HPP
+
+typedef ccx_top_traits tb_top_traits;
+
+#endif
@@ -0,0 +1,62 @@
+
+#include "unit_test.h"
+
+#define RTYPE(NAME, MNEMONIC)                                           \
+inline uint64_t NAME (uint64_t rs1, uint64_t rs2) {                     \
+    uint64_t rd;                                                        \
+    asm (MNEMONIC " %0, %1, %2" : "=r"(rd) : "r"(rs1), "r"(rs2));       \
+    return rd;                                                          \
+}
+
+RTYPE(sh1add   , "sh1add"   )
+RTYPE(sh2add   , "sh2add"   )
+RTYPE(sh3add   , "sh3add"   )
+RTYPE(add_uw   , "add.uw"   )
+RTYPE(sh1add_uw, "sh1add.uw")
+RTYPE(sh2add_uw, "sh2add.uw")
+RTYPE(sh3add_uw, "sh3add.uw")
+
+inline uint64_t slli_uw_4 (uint64_t rs1) {
+    uint64_t rd;
+    asm ("slli.uw %0, %1, 4" : "=r"(rd) : "r"(rs1));
+    return rd;
+}
+
+inline uint64_t slli_uw_33(uint64_t rs1) {
+    uint64_t rd;
+    asm ("slli.uw %0, %1, 33" : "=r"(rd) : "r"(rs1));
+    return rd;
+}
+
+#define TEST(INSN,EXP,RS1,RS2) {        \
+    uint64_t rd = INSN(RS1,RS2);        \
+    if(rd != EXP) {                     \
+        test_fail();                    \
+    }                                   \
+}
+
+#define TEST1(INSN,EXP,RS1) {           \
+    uint64_t rd = INSN(RS1);            \
+    if(rd != EXP) {                     \
+        test_fail();                    \
+    }                                   \
+}
+
+int test_main() {
+
+    TEST(sh1add   , 0x0123456789abcdee, 0x0123456789ABCDEF, 0xFEDCBA9876543210)
+    TEST(sh2add   , 0x0369d0369d0369cc, 0x0123456789ABCDEF, 0xFEDCBA9876543210)
+    TEST(sh3add   , 0x07f6e5d4c3b2a188, 0x0123456789ABCDEF, 0xFEDCBA9876543210)
+    
+    TEST(add_uw   , 0xfedcba98ffffffff, 0x0123456789ABCDEF, 0xFEDCBA9876543210)
+    TEST(add_uw   , 0x00000000fffffff1, 0x80000000FFFFFFF0, 0x0000000000000001)
+    TEST(sh1add_uw, 0xfedcba9989abcdee, 0x0123456789ABCDEF, 0xFEDCBA9876543210)
+    TEST(sh2add_uw, 0xfedcba9a9d0369cc, 0x0123456789ABCDEF, 0xFEDCBA9876543210)
+    TEST(sh3add_uw, 0xfedcba9cc3b2a188, 0x0123456789ABCDEF, 0xFEDCBA9876543210)
+
+    TEST1(slli_uw_4 , 0x0000000fffffff00, 0x80000000FFFFFFF0)
+    TEST1(slli_uw_33, 0x13579bde00000000, 0x0123456789ABCDEF)
+
+    return 0;
+
+}
@@ -0,0 +1,87 @@
+
+#include "unit_test.h"
+
+#define RTYPE(NAME, MNEMONIC)                                           \
+inline uint64_t NAME (uint64_t rs1, uint64_t rs2) {                     \
+    uint64_t rd;                                                        \
+    asm (MNEMONIC " %0, %1, %2" : "=r"(rd) : "r"(rs1), "r"(rs2));       \
+    return rd;                                                          \
+}
+
+#define UNARY(NAME, MNEMONIC)                                           \
+inline uint64_t NAME (uint64_t rs1) {                                   \
+    uint64_t rd;                                                        \
+    asm (MNEMONIC " %0, %1" : "=r"(rd) : "r"(rs1));                     \
+    return rd;                                                          \
+}
+
+UNARY(clz   , "clz"   )
+UNARY(ctz   , "ctz"   )
+UNARY(cpop  , "cpop"  )
+UNARY(clzw  , "clzw"  )
+UNARY(ctzw  , "ctzw"  )
+UNARY(cpopw , "cpopw" )
+UNARY(sext_b, "sext.b")
+UNARY(sext_h, "sext.h")
+UNARY(zext_h, "zext.h")
+UNARY(orc_b , "orc.b" )
+UNARY(rev8  , "rev8"  )
+
+RTYPE(min   , "min"   )
+RTYPE(minu  , "minu"  )
+RTYPE(max   , "max"   )
+RTYPE(maxu  , "maxu"  )
+
+#define TEST(INSN,EXP,RS1,RS2) {        \
+    uint64_t rd = INSN(RS1,RS2);        \
+    if(rd != EXP) {                     \
+        test_fail();                    \
+    }                                   \
+}
+
+#define TEST1(INSN,EXP,RS1) {           \
+    uint64_t rd = INSN(RS1);            \
+    if(rd != EXP) {                     \
+        test_fail();                    \
+    }                                   \
+}
+
+int test_main() {
+
+    TEST1(clz   , 64, 0x0000000000000000)
+    TEST1(clz   , 63, 0x0000000000000001)
+    TEST1(clz   ,  7, 0x0123456789ABCDEF)
+    TEST1(clz   , 31, 0x0000000100000000)
+    TEST1(clzw  , 32, 0x0000000100000000)
+    TEST1(clzw  ,  0, 0x0123456789ABCDEF)
+    TEST1(clzw  ,  1, 0xFEDCBA9876543210)
+
+    TEST1(ctz   , 64, 0x0000000000000000)
+    TEST1(ctz   ,  4, 0xFEDCBA9876543210)
+    TEST1(ctz   , 32, 0x0000000100000000)
+    TEST1(ctzw  , 32, 0x0000000100000000)
+    TEST1(ctzw  ,  4, 0x80000000FFFFFFF0)
+
+    TEST1(cpop  ,  0, 0x0000000000000000)
+    TEST1(cpop  , 32, 0x0123456789ABCDEF)
+    TEST1(cpop  , 29, 0x80000000FFFFFFF0)
+    TEST1(cpopw , 20, 0x0123456789ABCDEF)
+    TEST1(cpopw , 28, 0x80000000FFFFFFF0)
+
+    TEST(min    , 0xFEDCBA9876543210, 0x0123456789ABCDEF, 0xFEDCBA9876543210)
+    TEST(minu   , 0x0123456789ABCDEF, 0x0123456789ABCDEF, 0xFEDCBA9876543210)
+    TEST(max    , 0x0123456789ABCDEF, 0x0123456789ABCDEF, 0xFEDCBA9876543210)
+    TEST(maxu   , 0xFEDCBA9876543210, 0x0123456789ABCDEF, 0xFEDCBA9876543210)
+
+    TEST1(sext_b, 0xFFFFFFFFFFFFFFEF, 0x0123456789ABCDEF)
+    TEST1(sext_b, 0x000000000000007F, 0x000000000000007F)
+    TEST1(sext_h, 0xFFFFFFFFFFFFCDEF, 0x0123456789ABCDEF)
+    TEST1(sext_h, 0x0000000000003210, 0xFEDCBA9876543210)
+    TEST1(zext_h, 0x000000000000CDEF, 0x0123456789ABCDEF)
+
+    TEST1(orc_b , 0xFF00FF0000FF0000, 0x0100FF0000800000)
+    TEST1(rev8  , 0xEFCDAB8967452301, 0x0123456789ABCDEF)
+
+    return 0;
+
+}
@@ -0,0 +1,59 @@
+
+#include "unit_test.h"
+
+#define RTYPE(NAME, MNEMONIC)                                           \
+inline uint64_t NAME (uint64_t rs1, uint64_t rs2) {                     \
+    uint64_t rd;                                                        \
+    asm (MNEMONIC " %0, %1, %2" : "=r"(rd) : "r"(rs1), "r"(rs2));       \
+    return rd;                                                          \
+}
+
+#define ITYPE(NAME, MNEMONIC, SHAMT)                                    \
+inline uint64_t NAME (uint64_t rs1) {                                   \
+    uint64_t rd;                                                        \
+    asm (MNEMONIC " %0, %1, " #SHAMT : "=r"(rd) : "r"(rs1));            \
+    return rd;                                                          \
+}
+
+RTYPE(bclr, "bclr")
+RTYPE(bset, "bset")
+RTYPE(binv, "binv")
+RTYPE(bext, "bext")
+
+ITYPE(bclri_4 , "bclri",  4)
+ITYPE(bseti_63, "bseti", 63)
+ITYPE(binvi_0 , "binvi",  0)
+ITYPE(bexti_63, "bexti", 63)
+
+#define TEST(INSN,EXP,RS1,RS2) {        \
+    uint64_t rd = INSN(RS1,RS2);        \
+    if(rd != EXP) {                     \
+        test_fail();                    \
+    }                                   \
+}
+
+#define TEST1(INSN,EXP,RS1) {           \
+    uint64_t rd = INSN(RS1);            \
+    if(rd != EXP) {                     \
+        test_fail();                    \
+    }                                   \
+}
+
+int test_main() {
+
+    TEST(bclr, 0x0123456789ABCDEE, 0x0123456789ABCDEF,  0)
+    TEST(bclr, 0x0123456789ABCDEF, 0x0123456789ABCDEF,  4)
+    TEST(bset, 0x0123456789ABCDFF, 0x0123456789ABCDEF,  4)
+    TEST(bset, 0x0000000000000008, 0x0000000000000000, 67)
+    TEST(binv, 0x8123456789ABCDEF, 0x0123456789ABCDEF, 63)
+    TEST(bext, 0x0000000000000001, 0x0123456789ABCDEF,  8)
+    TEST(bext, 0x0000000000000000, 0x0123456789ABCDEF,  4)
+
+    TEST1(bclri_4 , 0xFEDCBA9876543200, 0xFEDCBA9876543210)
+    TEST1(bseti_63, 0x8000000000000000, 0x0000000000000000)
+    TEST1(binvi_0 , 0x0123456789ABCDEE, 0x0123456789ABCDEF)
+    TEST1(bexti_63, 0x0000000000000001, 0xFEDCBA9876543210)
+
+    return 0;
+
+}
@@ -344,6 +344,28 @@ int test_remu (){
 }
 
 
+//
+// Operand magnitudes which exercise the divider normalisation, where
+// most iterations are skipped.
+int test_div_norm (){
+
+    //
+    //       func , expected          , rs1               , rs2
+    CHECK_IS(divu , 0x000000000000008e, 0x00000000000003e8, 0x0000000000000007)
+    CHECK_IS(remu , 0x0000000000000006, 0x00000000000003e8, 0x0000000000000007)
+    CHECK_IS(div  , 0xffffffffffffff72, 0xfffffffffffffc18, 0x0000000000000007)
+    CHECK_IS(rem  , 0xfffffffffffffffa, 0xfffffffffffffc18, 0x0000000000000007)
+    CHECK_IS(divu , 0x00000000ffffffff, 0xffffffffffffffff, 0x0000000100000000)
+    CHECK_IS(remu , 0x123456789abcdef0, 0x123456789abcdef0, 0x123456789abcdef1)
+    CHECK_IS(divu , 0x2aaaaaaaaaaaaaaa, 0x8000000000000000, 0x0000000000000003)
+    CHECK_IS(div  , 0x0000000000000000, 0x0000000000000005, 0x8000000000000000)
+    CHECK_IS(divuw, 0x000000000000000b, 0x0000000000000064, 0x0000000000000009)
+    CHECK_IS(remw , 0xffffffffffffffff, 0xffffffffffffff9c, 0x0000000000000009)
+
+    return 0;
+
+}
+
 int test_main() {
     
     test_div  ();
@@ -356,6 +378,8 @@ int test_main() {
     test_remw ();
     test_remuw();
 
+    test_div_norm();
+
     return 0;
 
 }
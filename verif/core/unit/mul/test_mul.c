@@ -245,6 +245,22 @@ int test_mulhu () {
 
 }
 
+//
+// Operands where the upper half of rs2 is zero. These take the narrow
+// operand early-out path of the iterative multiplier.
+int test_mul_narrow () {
+
+    CHECK_IS(mul   , 0xcf13578ad05ebe80, 0x123456789abcdef0, 0xfedcba98)
+    CHECK_IS(mul   , 0xb2a1908800000000, 0xedcba98765432110, 0x80000000)
+    CHECK_IS(mulh  , 0xffffffffffffffff, 0xfffffffffffffffb, 0x80000000)
+    CHECK_IS(mulh  , 0x000000007fffffff, 0x7fffffffffffffff, 0xffffffff)
+    CHECK_IS(mulhsu, 0xffffffffffffffff, 0xffffffffffffedcc, 0xdeadbeef)
+    CHECK_IS(mulhu , 0x00000000fffffffe, 0xffffffffffffffff, 0xffffffff)
+
+    return 0;
+
+}
+
 int test_main() {
 
     test_mulw  ();
@@ -252,6 +268,7 @@ int test_main() {
     test_mulh  ();
     test_mulhsu();
     test_mulhu ();
+    test_mul_narrow();
 
     return 0;
 
@@ -0,0 +1,126 @@
+
+#include <algorithm>
+#include <iostream>
+
+#include "Vcore_top.h"
+#include "Vcore_top___024root.h"
+
+#include "memory_bus.hpp"
+#include "memory_device_ram.hpp"
+#include "core_mem_agent.hpp"
+#include "core_state.hpp"
+#include "dut_wrapper.hpp"
+
+#ifndef CORE_TOP_TRAITS_HPP
+#define CORE_TOP_TRAITS_HPP
+
+CORE_MEM_PORT(core_top_imem_port, Vcore_top, imem)
+CORE_MEM_PORT(core_top_dmem_port, Vcore_top, dmem)
+
+/*!
+@brief Binds dut_wrapper and testbench to the core_top ports.
+*/
+struct core_top_traits {
+
+    typedef Vcore_top top_t;
+
+    static const char * name() {return "core_top";}
+
+    //! Instruction and data memory SRAM agents.
+    struct agents_t {
+
+        core_mem_agent<core_top_imem_port> imem;
+        core_mem_agent<core_top_dmem_port> dmem;
+
+        agents_t (
+            top_t      * dut,
+            memory_bus * mem
+        ) : imem(dut, mem), dmem(dut, mem) {}
+
+        void set_reset() {
+            imem.set_reset();
+            dmem.set_reset();
+        }
+
+        void clear_reset() {
+            imem.clear_reset();
+            dmem.clear_reset();
+        }
+
+        void posedge_clk() {
+            imem.posedge_clk();
+            dmem.posedge_clk();
+        }
+
+        void drive_signals() {
+            imem.drive_signals();
+            dmem.drive_signals();
+        }
+
+        void configure(dut_agent_cfg_t const & cfg) {
+            imem.max_req_stall = cfg.imem_max_stall;
+            dmem.max_req_stall = cfg.dmem_max_stall;
+        }
+
+        void print_stats(std::ostream & os) {}
+
+        uint64_t max_wait() {
+            return std::max(imem.max_wait(), dmem.max_wait());
+        }
+
+        void print_outstanding(std::ostream & os) {
+            imem.print_outstanding(os);
+            dmem.print_outstanding(os);
+        }
+
+    };
+
+    //! Both issue lanes have a trace port. Lane 1 is trs_b_*.
+    static const int trace_lanes = 2;
+
+    static bool     trs_valid(top_t * d, int lane) {
+        return lane ? d -> trs_b_valid : d -> trs_valid;
+    }
+
+    static uint64_t trs_pc   (top_t * d, int lane) {
+        return lane ? d -> trs_b_pc    : d -> trs_pc;
+    }
+
+    static uint32_t trs_instr(top_t * d, int lane) {
+        return lane ? d -> trs_b_instr : d -> trs_instr;
+    }
+
+    //! Pointer to general purpose register idx, or NULL for x0.
+    static uint64_t * gpr(top_t * d, unsigned idx) {
+        CORE_GPR_SWITCH(d -> rootp, core_top, idx)
+    }
+
+    static dut_csrs_t csrs(top_t * d) {
+        CORE_CSRS_RETURN(d -> rootp, core_top)
+    }
+
+    //! The core's gated clock domains. See core_clock_ctrl.
+    static const int clock_domains = CORE_CLOCK_DOMAINS;
+
+    static const char * clock_name(int i) {return core_clock_name(i);}
+
+    static bool clock_en(top_t * d, int i) {
+        return CORE_CLOCK_EN(d -> rootp, core_top, i);
+    }
+
+    //! Pipeline state for tb_pipeview.
+    static pv_sample_t pipeview(top_t * d) {
+        CORE_PIPEVIEW_RETURN(d -> rootp, core_top)
+    }
+
+    //! The timer lives outside core_top. Never fast-forward WFI.
+    static const bool has_timer = false;
+
+    //! Default RAM, holding all code and data.
+    static void add_devices(memory_bus * bus) {
+        bus -> add_device(new memory_device_ram(0x10000000, 0x00200000));
+    }
+
+};
+
+#endif
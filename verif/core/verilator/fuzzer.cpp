@@ -0,0 +1,623 @@
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <memory>
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "fuzzer.hpp"
+
+//! Boot stub, trap handler and start flag. All in the default RAM.
+#define FUZZ_STUB_BASE      0x10000000
+#define FUZZ_STUB_WAIT      0x10000020
+#define FUZZ_HANDLER_BASE   0x10000100
+#define FUZZ_HANDLER_END    0x10000124
+#define FUZZ_FLAG_ADDR      0x10000200
+
+//! Edge map class used for entry to the trap handler.
+#define FUZZ_CLASS_TRAP     0xFFFFFFFF
+
+//! Give up on an input after this many traps in a row.
+#define FUZZ_MAX_TRAP_RUN   8
+
+//
+// Instruction encoders, for the boot stub and the instruction generator.
+// ------------------------------------------------------------
+
+static uint32_t enc_u(uint32_t opc, uint32_t rd, uint32_t imm20) {
+    return (imm20 << 12) | (rd << 7) | opc;
+}
+
+static uint32_t enc_i(uint32_t opc, uint32_t f3, uint32_t rd, uint32_t rs1,
+                      uint32_t imm) {
+    return ((imm & 0xFFF) << 20) | (rs1 << 15) | (f3 << 12) | (rd << 7) | opc;
+}
+
+static uint32_t enc_s(uint32_t opc, uint32_t f3, uint32_t rs1, uint32_t rs2,
+                      uint32_t imm) {
+    return ((imm >> 5 & 0x7F) << 25) | (rs2 << 20) | (rs1 << 15) |
+           (f3 << 12) | ((imm & 0x1F) << 7) | opc;
+}
+
+static uint32_t enc_r(uint32_t opc, uint32_t f3, uint32_t f7, uint32_t rd,
+                      uint32_t rs1, uint32_t rs2) {
+    return (f7 << 25) | (rs2 << 20) | (rs1 << 15) | (f3 << 12) | (rd << 7) |
+           opc;
+}
+
+static uint32_t enc_b(uint32_t f3, uint32_t rs1, uint32_t rs2, uint32_t off) {
+    return ((off >> 12 & 0x01) << 31) | ((off >> 5 & 0x3F) << 25) |
+           (rs2 << 20) | (rs1 << 15) | (f3 << 12) |
+           ((off >> 1 & 0x0F) <<  8) | ((off >> 11 & 0x01) <<  7) | 0x63;
+}
+
+static uint32_t enc_j(uint32_t rd, uint32_t off) {
+    return ((off >> 20 & 0x001) << 31) | ((off >> 1 & 0x3FF) << 21) |
+           ((off >> 11 & 0x001) << 20) | ((off >> 12 & 0x0FF) << 12) |
+           (rd << 7) | 0x6F;
+}
+
+//! Reduce an instruction to the fields which select what it does.
+static uint32_t instr_class(uint32_t instr) {
+    if((instr & 0x3) != 0x3) {
+        // Compressed. Quadrant 1 funct3=4 has more minor opcode bits.
+        uint32_t c = instr & 0xE003;
+        return c == 0x8001 ? instr & 0xFC63 : c;
+    }
+    uint32_t opc = instr & 0x7F;
+    uint32_t f3  = instr >> 12 & 0x7;
+    switch(opc) {
+        case 0x33: case 0x3B:           return instr & 0xFE00707F;
+        case 0x2F:                      return instr & 0xF800707F;
+        case 0x73:                      return instr & 0xFFF0707F;
+        case 0x13: case 0x1B:
+            return f3 == 1 || f3 == 5 ? instr & 0xFC00707F : instr & 0x707F;
+        case 0x17: case 0x37: case 0x6F: return opc;
+        default:                        return instr & 0x707F;
+    }
+}
+
+//! Map a hit count onto a coarse bucket, so loops only count as new
+//! coverage when their trip count changes a lot.
+static uint8_t count_bucket(uint8_t n) {
+    if(n <   4) return n;
+    if(n <   8) return 4;
+    if(n <  16) return 5;
+    if(n <  32) return 6;
+    if(n < 128) return 7;
+    return 8;
+}
+
+static void push_word(std::vector<uint8_t> & v, uint32_t w) {
+    for(int i = 0; i < 4; i ++) {
+        v.push_back(w >> (8*i));
+    }
+}
+
+
+/*!
+*/
+void memory_device_fuzz_code::load (
+    std::vector<uint8_t> const & input
+) {
+    std::vector<uint8_t> img(input);
+    push_word(img, enc_j(0, 0));    // j .
+
+    std::unique_ptr<bool[]> s(new bool[img.size()]);
+    for(size_t i = 0; i < img.size(); i ++) {
+        s[i] = true;
+    }
+
+    this -> locked   = false;
+    memory_device_ram::write_range(this -> addr_base, img.size(), img.data(),
+                                   s.get());
+    this -> locked   = true;
+    this -> end_addr = this -> addr_base + input.size();
+}
+
+
+/*!
+*/
+fuzzer::fuzzer (
+    core_testbench * tb,
+    uint32_t         seed
+) : rng(seed) {
+
+    this -> tb   = tb;
+    this -> code = new memory_device_fuzz_code(FUZZ_CODE_BASE,FUZZ_CODE_SIZE);
+
+    this -> code_mapped = tb -> bus -> add_device(this -> code);
+
+    // Random stores must never make host syscalls.
+    tb -> htif_0 -> syscalls_enabled = false;
+
+    this -> trace_map = (uint8_t*)mmap(NULL, FUZZ_MAP_SIZE,
+        PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+
+    this -> virgin_map.assign(FUZZ_MAP_SIZE, 0);
+
+    // Boot stub: install the trap handler, point some base registers at
+    // RAM so loads/stores sometimes succeed, then wait for the flag.
+    uint32_t stub[] = {
+        enc_u(0x37, 5, FUZZ_STUB_BASE >> 12),       // lui  t0, stub
+        enc_i(0x13, 0, 5, 5, 0x100),                // addi t0, t0, 0x100
+        enc_i(0x73, 1, 0, 5, 0x305),                // csrw mtvec, t0
+        enc_u(0x37, 2, 0x10100),                    // lui  sp, 0x10100
+        enc_u(0x37, 3, 0x10100),                    // lui  gp, 0x10100
+        enc_u(0x37,10, 0x10100),                    // lui  a0, 0x10100
+        enc_u(0x37, 6, FUZZ_STUB_BASE >> 12),       // lui  t1, stub
+        enc_i(0x13, 0, 6, 6, 0x200),                // addi t1, t1, 0x200
+        enc_i(0x03, 2, 7, 6, 0),                    // lw   t2, 0(t1)
+        enc_b(0, 7, 0, -4),                         // beqz t2, .-4
+        enc_u(0x37, 5, FUZZ_CODE_BASE >> 12),       // lui  t0, code
+        enc_i(0x67, 0, 0, 5, 0),                    // jr   t0
+    };
+
+    // Trap handler: skip the trapping 16 or 32 bit instruction.
+    uint32_t handler[] = {
+        enc_i(0x73, 2, 5, 0, 0x341),                // csrr t0, mepc
+        enc_i(0x03, 4, 6, 5, 0),                    // lbu  t1, 0(t0)
+        enc_i(0x13, 0, 5, 5, 2),                    // addi t0, t0, 2
+        enc_i(0x13, 7, 6, 6, 3),                    // andi t1, t1, 3
+        enc_i(0x13, 0, 6, 6, -3),                   // addi t1, t1, -3
+        enc_b(1, 6, 0, 8),                          // bnez t1, .+8
+        enc_i(0x13, 0, 5, 5, 2),                    // addi t0, t0, 2
+        enc_i(0x73, 1, 0, 5, 0x341),                // csrw mepc, t0
+        0x30200073                                  // mret
+    };
+
+    for(size_t i = 0; i < sizeof(stub) / 4; i ++) {
+        tb -> bus -> write_range(FUZZ_STUB_BASE + 4*i, 4, (uint8_t*)&stub[i]);
+    }
+
+    for(size_t i = 0; i < sizeof(handler) / 4; i ++) {
+        tb -> bus -> write_range(FUZZ_HANDLER_BASE + 4*i, 4,
+                                 (uint8_t*)&handler[i]);
+    }
+}
+
+
+//! Reset the core and run it into the stub's wait loop.
+bool fuzzer::boot() {
+
+    dut_wrapper<core_top_traits> * dut = this -> tb -> dut;
+
+    if(!this -> code_mapped) {
+        std::cerr << ">> Fuzz code memory overlaps another device"
+                  << std::endl;
+        return false;
+    }
+
+    this -> tb -> bus -> write_byte(FUZZ_FLAG_ADDR, 0);
+
+    dut -> dut_set_reset();
+
+    for(int i = 0; i < 5; i ++) {
+        dut -> dut_step_clk();
+    }
+
+    dut -> dut_clear_reset();
+
+    int waits = 0;
+
+    for(int i = 0; i < 10000 && waits < 2; i ++) {
+        dut -> dut_step_clk();
+        while(!dut -> dut_trace.empty()) {
+            waits += dut -> dut_trace.front().program_counter ==
+                     FUZZ_STUB_WAIT;
+            dut -> dut_trace.pop();
+        }
+    }
+
+    if(waits < 2) {
+        std::cerr << ">> Fuzz boot stub did not reach its wait loop"
+                  << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+
+//! Run one input from the booted state. @returns an exit code.
+int fuzzer::run_one (
+    std::vector<uint8_t> const & input
+) {
+    dut_wrapper<core_top_traits> * dut = this -> tb -> dut;
+
+    this -> code -> load(input);
+    this -> tb -> bus -> write_byte(FUZZ_FLAG_ADDR, 1);
+
+    // dut_step_clk toggles the clock once, so each cycle is two steps.
+    uint64_t max_steps  = 2 * this -> max_cycles;
+    uint64_t hang_steps = 2 * this -> hang_cycles;
+    uint64_t last_ret   = 0;
+    uint32_t prev_hash  = 0;
+    int      trap_run   = 0;
+    bool     started    = false;
+
+    for(uint64_t step = 1; step <= max_steps; step ++) {
+
+        dut -> dut_step_clk();
+
+        while(!dut -> dut_trace.empty()) {
+
+            dut_trace_pkt_t t  = dut -> dut_trace.front();
+            memory_address  pc = t.program_counter;
+            uint32_t        cls;
+
+            dut -> dut_trace.pop();
+            last_ret = step;
+
+            if(this -> code -> in_range(pc)) {
+
+                if(pc == this -> code -> end_addr) {
+                    return 0;
+                }
+
+                uint32_t exp = 0;
+                this -> code -> read_range(pc, 4, (uint8_t*)&exp);
+
+                bool ok = (exp & 0x3) == 0x3 ? exp == t.instr_word :
+                          (exp & 0xFFFF) == (t.instr_word & 0xFFFF);
+
+                if(!ok) {
+                    return FUZZ_EXIT_MISMATCH;
+                }
+
+                cls      = instr_class(t.instr_word);
+                trap_run = 0;
+                started  = true;
+
+            } else if(pc >= FUZZ_HANDLER_BASE && pc < FUZZ_HANDLER_END) {
+
+                started  = true;
+                if(pc != FUZZ_HANDLER_BASE) {
+                    continue;
+                }
+                if(++trap_run > FUZZ_MAX_TRAP_RUN) {
+                    return 0;
+                }
+                cls      = FUZZ_CLASS_TRAP;
+
+            } else if(!started) {
+                continue;   // Still leaving the stub's wait loop.
+            } else {
+                return 0;   // Jumped out of the input.
+            }
+
+            uint32_t h   = (cls * 2654435761u) >> 16;
+            uint32_t idx = (h ^ prev_hash) & (FUZZ_MAP_SIZE - 1);
+            prev_hash    = h >> 1;
+
+            if(this -> trace_map[idx] < 0xFF) {
+                this -> trace_map[idx] ++;
+            }
+        }
+
+        if(dut -> dut_wfi_sleep() || this -> tb -> htif_0 -> exited()) {
+            return 0;
+        }
+
+        if(step - last_ret > hang_steps) {
+            return FUZZ_EXIT_HANG;
+        }
+    }
+
+    return 0;
+}
+
+
+//! Fold trace_map into virgin_map. @returns true on new coverage.
+bool fuzzer::has_new_coverage() {
+    bool found = false;
+    for(size_t i = 0; i < FUZZ_MAP_SIZE; i ++) {
+        uint8_t b = count_bucket(this -> trace_map[i]);
+        if(b > this -> virgin_map[i]) {
+            this -> virgin_map[i] = b;
+            found = true;
+        }
+    }
+    return found;
+}
+
+
+//! Return a random 16 or 32 bit instruction, as bytes.
+void fuzzer::random_instr (
+    std::vector<uint8_t> & out
+) {
+    static const uint32_t opcodes[] = {
+        0x03, 0x0F, 0x13, 0x17, 0x1B, 0x23, 0x2F, 0x33, 0x37, 0x3B,
+        0x63, 0x67, 0x6F, 0x73
+    };
+    static const uint32_t funct7s[] = {
+        0x00, 0x01, 0x04, 0x05, 0x07, 0x10, 0x14, 0x20, 0x24, 0x30, 0x34
+    };
+    static const uint32_t shift_f6[] = {
+        0x00, 0x02, 0x0C, 0x10, 0x12, 0x14, 0x18, 0x1A
+    };
+    static const uint32_t csrs[] = {
+        0x300, 0x301, 0x304, 0x305, 0x306, 0x320, 0x323, 0x340, 0x341,
+        0x342, 0x343, 0x344, 0x7C0, 0xB00, 0xB02, 0xB03, 0xB04, 0xC00,
+        0xC01, 0xC02, 0xC03, 0xF11, 0xF12, 0xF13, 0xF14, 0x015
+    };
+    static const uint32_t sys_f12[] = {
+        0x000, 0x001, 0x102, 0x105, 0x302, 0x7B2
+    };
+    static const uint32_t mem_base[] = { 2, 3, 10 };
+
+    #define PICK(A) A[this -> rng() % (sizeof(A) / sizeof(A[0]))]
+
+    uint32_t r   = this -> rng();
+    uint32_t rd  = this -> rng() % 32;
+    uint32_t rs1 = this -> rng() % 32;
+    uint32_t rs2 = this -> rng() % 32;
+    uint32_t f3  = this -> rng() % 8;
+    uint32_t w;
+
+    switch(this -> rng() % 8) {
+
+        case 0:
+            push_word(out, r | 0x3);
+            return;
+
+        case 1:
+            r &= 0xFFFF;
+            if((r & 0x3) == 0x3) {
+                r ^= 0x1;
+            }
+            out.push_back(r     );
+            out.push_back(r >> 8);
+            return;
+
+        default:
+            break;
+    }
+
+    uint32_t opc = PICK(opcodes);
+    uint32_t off = ((int32_t)(this -> rng() % 32) - 16) * 2;
+    off = off ? off : 4;
+
+    switch(opc) {
+        case 0x63: w = enc_b(f3, rs1, rs2, off);                       break;
+        case 0x6F: w = enc_j(rd, off);                                 break;
+        case 0x17:
+        case 0x37: w = enc_u(opc, rd, r >> 12);                        break;
+        case 0x33:
+        case 0x3B: w = enc_r(opc, f3, PICK(funct7s), rd, rs1, rs2);    break;
+        case 0x03: w = enc_i(opc, f3, rd, PICK(mem_base), r % 64);     break;
+        case 0x23: w = enc_s(opc, f3, PICK(mem_base), rs2, r % 64);    break;
+        case 0x2F:
+            w = enc_r(opc, 2 + (r & 1), (this -> rng() % 128), rd,
+                      PICK(mem_base), rs2);
+            break;
+        case 0x13:
+        case 0x1B:
+            if(f3 == 1 || f3 == 5) {
+                w = enc_i(opc, f3, rd, rs1, PICK(shift_f6) << 6 | (r % 64));
+            } else {
+                w = enc_i(opc, f3, rd, rs1, r);
+            }
+            break;
+        case 0x73:
+            if(f3 == 0 || f3 == 4) {
+                w = enc_i(opc, 0, 0, 0, PICK(sys_f12));
+            } else {
+                w = enc_i(opc, f3, rd, rs1, r & 1 ? PICK(csrs) : r >> 20);
+            }
+            break;
+        default:
+            w = enc_i(opc, f3, rd, rs1, r);
+            break;
+    }
+
+    #undef PICK
+
+    push_word(out, w);
+}
+
+
+//! Return a mutated copy of a corpus entry.
+std::vector<uint8_t> fuzzer::mutate (
+    std::vector<uint8_t> const & input
+) {
+    std::vector<uint8_t> v(input);
+    int ops = 1 + this -> rng() % 4;
+
+    for(int n = 0; n < ops; n ++) {
+
+        // Instruction boundaries are at least 2-byte aligned.
+        size_t pos = v.empty() ? 0 : (this -> rng() % v.size()) & ~0x1;
+        std::vector<uint8_t> ins;
+
+        switch(this -> rng() % 6) {
+
+            case 0: // Replace an instruction.
+                this -> random_instr(ins);
+                for(size_t i = 0; i < ins.size() && pos + i < v.size(); i ++) {
+                    v[pos+i] = ins[i];
+                }
+                break;
+
+            case 1: // Flip a bit.
+                if(!v.empty()) {
+                    v[this -> rng() % v.size()] ^= 1 << (this -> rng() % 8);
+                }
+                break;
+
+            case 2: // Insert an instruction.
+                this -> random_instr(ins);
+                v.insert(v.begin() + pos, ins.begin(), ins.end());
+                break;
+
+            case 3: // Delete a half-word or word.
+                if(v.size() > 4) {
+                    size_t len = std::min(v.size() - pos,
+                                          (size_t)(2 + 2 * (this->rng() % 2)));
+                    v.erase(v.begin() + pos, v.begin() + pos + len);
+                }
+                break;
+
+            case 4: { // Splice with another corpus entry.
+                std::vector<uint8_t> const & o =
+                    this -> corpus[this -> rng() % this -> corpus.size()];
+                size_t opos = o.empty() ? 0 : (this -> rng() % o.size()) & ~1;
+                v.resize(pos);
+                v.insert(v.end(), o.begin() + opos, o.end());
+                break;
+            }
+
+            case 5: { // Duplicate a chunk, e.g. to unroll a loop body.
+                size_t len = std::min(v.size() - pos,
+                                      (size_t)(2 * (1 + this -> rng() % 8)));
+                std::vector<uint8_t> c(v.begin() + pos, v.begin() + pos + len);
+                v.insert(v.begin() + pos, c.begin(), c.end());
+                break;
+            }
+        }
+    }
+
+    if(v.size() > this -> max_input_len) {
+        v.resize(this -> max_input_len & ~0x1);
+    }
+
+    if(v.empty()) {
+        this -> random_instr(v);
+    }
+
+    return v;
+}
+
+
+//! Write an input to <out_dir>/<sub>/<name>.bin
+void fuzzer::save (
+    std::string                  sub ,
+    std::string                  name,
+    std::vector<uint8_t> const & input
+) {
+    std::string dir = this -> out_dir + "/" + sub;
+    mkdir(this -> out_dir.c_str(), 0755);
+    mkdir(dir.c_str(), 0755);
+
+    std::ofstream fh(dir + "/" + name + ".bin", std::ios::binary);
+    fh.write((const char*)input.data(), input.size());
+}
+
+
+/*!
+*/
+int fuzzer::run (
+    uint64_t iterations
+) {
+    auto     t_start  = std::chrono::steady_clock::now();
+    auto     t_report = t_start;
+    uint64_t crashes  = 0;
+    uint64_t edges    = 0;
+
+    if(!this -> boot()) {
+        std::cout << ">> FUZZ BOOT FAIL" << std::endl;
+        return FUZZ_EXIT_BOOT;
+    }
+
+    for(uint64_t iter = 0; iter < iterations; iter ++) {
+
+        std::vector<uint8_t> input;
+
+        if(this -> corpus.empty() || this -> rng() % 16 == 0) {
+            while(input.size() < this -> max_input_len / 2) {
+                this -> random_instr(input);
+            }
+        } else {
+            input = this -> mutate(
+                this -> corpus[this -> rng() % this -> corpus.size()]
+            );
+        }
+
+        memset(this -> trace_map, 0, FUZZ_MAP_SIZE);
+
+        std::cout.flush();
+        fflush(stdout);
+
+        pid_t pid = fork();
+
+        if(pid < 0) {
+            perror(">> Fuzz fork failed");
+            break;
+        } else if(pid == 0) {
+            _exit(this -> run_one(input));
+        }
+
+        int status = 0;
+        waitpid(pid, &status, 0);
+
+        bool crashed = WIFSIGNALED(status) ||
+                       (WIFEXITED(status) && WEXITSTATUS(status) != 0);
+
+        if(crashed) {
+            crashes ++;
+            std::string name = "crash-" + std::to_string(iter);
+            this -> save("crashes", name, input);
+            std::cout << ">> Fuzz crash: " << name << " ("
+                      << (WIFSIGNALED(status) ? "signal " : "exit ")
+                      << std::dec
+                      << (WIFSIGNALED(status) ? WTERMSIG(status)
+                                              : WEXITSTATUS(status))
+                      << ")" << std::endl;
+        } else if(this -> has_new_coverage()) {
+            this -> corpus.push_back(input);
+            this -> save("corpus", "id-" + std::to_string(iter), input);
+        }
+
+        auto now = std::chrono::steady_clock::now();
+
+        if(now - t_report > std::chrono::seconds(2) ||
+           iter + 1 == iterations) {
+            double secs = std::chrono::duration<double>(now - t_start).count();
+            edges = 0;
+            for(uint8_t b : this -> virgin_map) {
+                edges += b != 0;
+            }
+            std::cout << ">> Fuzz: " << std::dec << iter + 1 << " runs, "
+                      << this -> corpus.size() << " corpus, "
+                      << edges   << " edges, "
+                      << crashes << " crashes, "
+                      << (uint64_t)((iter + 1) / secs) << " runs/s"
+                      << std::endl;
+            t_report = now;
+        }
+    }
+
+    return crashes > 0 ? FUZZ_EXIT_CRASHES : 0;
+}
+
+
+/*!
+*/
+int fuzzer::replay (
+    std::string path
+) {
+    std::ifstream        fh(path, std::ios::binary);
+    std::vector<uint8_t> input((std::istreambuf_iterator<char>(fh)),
+                                std::istreambuf_iterator<char>());
+
+    if(!this -> boot()) {
+        std::cout << ">> FUZZ BOOT FAIL" << std::endl;
+        return FUZZ_EXIT_BOOT;
+    }
+
+    memset(this -> trace_map, 0, FUZZ_MAP_SIZE);
+
+    int rc = this -> run_one(input);
+
+    std::cout << ">> Fuzz replay of " << path << " ("
+              << std::dec << input.size() << " bytes): exit " << rc
+              << std::endl;
+
+    return rc;
+}
@@ -0,0 +1,190 @@
+
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "memory_device_ram.hpp"
+#include "testbench.hpp"
+#include "core_top_traits.hpp"
+
+#ifndef FUZZER_HPP
+#define FUZZER_HPP
+
+//! Base address of the read-only memory holding each fuzz input.
+#define FUZZ_CODE_BASE      0x10400000
+
+//! Size of the fuzz input memory. Inputs must be a little smaller.
+#define FUZZ_CODE_SIZE      0x00010000
+
+//! Number of entries in the coverage edge map.
+#define FUZZ_MAP_SIZE       (1 << 16)
+
+//! Child exit codes which count as crashes.
+#define FUZZ_EXIT_HANG      10  //!< No instruction retired for too long.
+#define FUZZ_EXIT_MISMATCH  11  //!< Traced instruction != memory contents.
+
+//! Exit codes of the testbench when fuzzing.
+#define FUZZ_EXIT_CRASHES   2   //!< The run found at least one crash.
+#define FUZZ_EXIT_BOOT      12  //!< Boot failed, so nothing was fuzzed.
+
+/*!
+@brief Read-only memory holding the current fuzz input.
+@details Writes from the core fail, so self-modifying code cannot make the
+    trace check report a false mismatch.
+*/
+class memory_device_fuzz_code : public memory_device_ram {
+
+public:
+
+    memory_device_fuzz_code (
+        memory_address base,
+        size_t         range
+    ) : memory_device_ram(base,range) {}
+
+    //! Replace the contents with input, followed by a "j ." terminator.
+    void load (
+        std::vector<uint8_t> const & input
+    );
+
+    //! Address of the terminator instruction after the input.
+    memory_address end_addr;
+
+    bool write_byte (
+        memory_address addr,
+        uint8_t        data
+    ) {
+        return this -> locked ? false : memory_device_ram::write_byte(addr,data);
+    }
+
+    bool write_range (
+        memory_address addr,
+        size_t         size,
+        uint8_t      * wdata,
+        bool         * strb
+    ) {
+        return this -> locked ? false :
+            memory_device_ram::write_range(addr, size, wdata, strb);
+    }
+
+protected:
+
+    bool locked = true;
+
+};
+
+//! The fuzzer only runs on the core_top testbench.
+typedef testbench<core_top_traits> core_testbench;
+
+/*!
+@brief Fork-server instruction stream fuzzer for the core.
+@details The core is reset and booted once, into a stub which installs a
+    trap handler, then spins waiting for a flag in memory. For each input,
+    the fuzzer forks. The child loads the input at FUZZ_CODE_BASE, sets
+    the flag, and runs until the core leaves the input, sleeps in WFI, or
+    runs out of cycles. The parent never advances the model, so every
+    child starts from the same booted state, without re-running reset or
+    re-loading anything.
+
+    The trap handler skips the faulting instruction, adding 2 or 4 to
+    mepc depending on its length, and returns. So one input exercises
+    many illegal / trapping encodings.
+
+    Coverage feedback is an edge map over pairs of retired instruction
+    classes (opcode, funct3, funct7 and CSR address), plus trap entries,
+    shared with each child through an anonymous shared mapping. Inputs
+    which reach new edges, or hit an edge more often, join the corpus.
+
+    A crash is any child which:
+    - Dies from a signal, e.g. a Verilator assertion or $fatal abort.
+    - Exits non-zero, e.g. FUZZ_EXIT_HANG or FUZZ_EXIT_MISMATCH.
+    Crashing inputs are written to <out>/crashes/ as raw little-endian
+    binaries, which can be re-run in-process with replay().
+*/
+class fuzzer {
+
+public:
+
+    fuzzer (
+        core_testbench * tb,
+        uint32_t         seed
+    );
+
+    //! Most bytes in one input.
+    size_t      max_input_len   = 256;
+
+    //! Most clock cycles each input may run for.
+    uint64_t    max_cycles      = 4000;
+
+    //! Cycles without a retired instruction which count as a hang.
+    uint64_t    hang_cycles     = 500;
+
+    //! Output directory for the corpus and crashes.
+    std::string out_dir         = "fuzz-out";
+
+    //! Boot the core, then run iterations fuzz inputs.
+    //! @returns 0, FUZZ_EXIT_CRASHES if any input crashed, or
+    //!     FUZZ_EXIT_BOOT if the core could not be booted.
+    int      run (
+        uint64_t iterations
+    );
+
+    //! Boot the core and run one input file in-process.
+    //! @returns the child exit code that input would give, or
+    //!     FUZZ_EXIT_BOOT if the core could not be booted.
+    int      replay (
+        std::string path
+    );
+
+protected:
+
+    core_testbench          * tb;
+
+    memory_device_fuzz_code * code;
+
+    //! Did code get added to the bus? If not, boot() fails.
+    bool                      code_mapped;
+
+    std::mt19937              rng;
+
+    //! Shared with each child. Hit counts per edge for the last input.
+    uint8_t                 * trace_map;
+
+    //! Highest hit count bucket seen so far per edge.
+    std::vector<uint8_t>      virgin_map;
+
+    std::vector<std::vector<uint8_t>> corpus;
+
+    //! Reset the core and run it into the stub's wait loop.
+    //! @returns false if the stub never got there, or the fuzz code
+    //!     memory could not be mapped.
+    bool     boot();
+
+    //! Run one input from the booted state. @returns an exit code.
+    int      run_one (
+        std::vector<uint8_t> const & input
+    );
+
+    //! Fold trace_map into virgin_map. @returns true on new coverage.
+    bool     has_new_coverage();
+
+    //! Return a random 16 or 32 bit instruction, as bytes.
+    void     random_instr (
+        std::vector<uint8_t> & out
+    );
+
+    //! Return a mutated copy of a corpus entry.
+    std::vector<uint8_t> mutate (
+        std::vector<uint8_t> const & input
+    );
+
+    //! Write an input to <out_dir>/<sub>/<name>.bin
+    void     save (
+        std::string                  sub ,
+        std::string                  name,
+        std::vector<uint8_t> const & input
+    );
+
+};
+
+#endif
@@ -0,0 +1,17 @@
+
+//
+// Selects the top level built by verif/share/verilator/main.cpp.
+//
+
+#include "core_top_traits.hpp"
+#include "fuzzer.hpp"
+
+#ifndef TB_TOP_HPP
+#define TB_TOP_HPP
+
+typedef core_top_traits tb_top_traits;
+
+//! The core testbench has the instruction stream fuzzer.
+#define TB_FUZZER
+
+#endif
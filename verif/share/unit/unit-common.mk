@@ -15,6 +15,16 @@ define map_unit_test_elf
 $(call unit_test_build_dir,${1})/${2}/${2}.elf
 endef
 
+#
+# Shell expression for the address of a symbol in an ELF file, evaluated
+# when the recipe runs. Used for pass / fail addresses, so they follow
+# any change to the boot code.
+# 1. ELF file
+# 2. Symbol name
+define map_elf_symbol
+0x`$(NM) ${1} | grep -w ${2} | cut -d' ' -f1`
+endef
+
 #
 # 1. Unit test catagory: {core, ccx}
 # 2. Unit test name
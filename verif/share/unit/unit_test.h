@@ -134,7 +134,9 @@ void __puthex32(uint32_t w);
 void __puthex8(uint8_t w);
 
 #define CAUSE_CODE_IACCESS  0x1l
+#define CAUSE_CODE_LDALIGN  0x4l
 #define CAUSE_CODE_LDACCESS 0x5l
+#define CAUSE_CODE_STALIGN  0x6l
 #define CAUSE_CODE_STACCESS 0x7l
 
 #endif
@@ -0,0 +1,394 @@
+
+#include <algorithm>
+#include <deque>
+#include <iomanip>
+#include <iostream>
+
+#include "memory_txns.hpp"
+#include "memory_bus.hpp"
+
+#ifndef AXI_SLAVE_AGENT_HPP
+#define AXI_SLAVE_AGENT_HPP
+
+/*!
+@brief Declare a port binding traits struct for an axi_slave_agent.
+@details NAME is the new struct, TOP the Verilated top level class and PFX
+    the port name prefix, e.g. axi. See CORE_MEM_PORT.
+*/
+#define AXI_SLAVE_PORT(NAME, TOP, PFX)                                      \
+struct NAME {                                                               \
+    typedef TOP top_t;                                                      \
+    static const char * name() {return #PFX;}                               \
+    static uint8_t  & awvalid(TOP * d) {return d -> PFX ## _awvalid;}       \
+    static uint8_t  & awready(TOP * d) {return d -> PFX ## _awready;}       \
+    static uint8_t  & awid   (TOP * d) {return d -> PFX ## _awid   ;}       \
+    static uint64_t & awaddr (TOP * d) {return d -> PFX ## _awaddr ;}       \
+    static uint8_t  & awlen  (TOP * d) {return d -> PFX ## _awlen  ;}       \
+    static uint8_t  & wvalid (TOP * d) {return d -> PFX ## _wvalid ;}       \
+    static uint8_t  & wready (TOP * d) {return d -> PFX ## _wready ;}       \
+    static uint64_t & wdata  (TOP * d) {return d -> PFX ## _wdata  ;}       \
+    static uint8_t  & wstrb  (TOP * d) {return d -> PFX ## _wstrb  ;}       \
+    static uint8_t  & wlast  (TOP * d) {return d -> PFX ## _wlast  ;}       \
+    static uint8_t  & bvalid (TOP * d) {return d -> PFX ## _bvalid ;}       \
+    static uint8_t  & bready (TOP * d) {return d -> PFX ## _bready ;}       \
+    static uint8_t  & bid    (TOP * d) {return d -> PFX ## _bid    ;}       \
+    static uint8_t  & bresp  (TOP * d) {return d -> PFX ## _bresp  ;}       \
+    static uint8_t  & arvalid(TOP * d) {return d -> PFX ## _arvalid;}       \
+    static uint8_t  & arready(TOP * d) {return d -> PFX ## _arready;}       \
+    static uint8_t  & arid   (TOP * d) {return d -> PFX ## _arid   ;}       \
+    static uint64_t & araddr (TOP * d) {return d -> PFX ## _araddr ;}       \
+    static uint8_t  & arlen  (TOP * d) {return d -> PFX ## _arlen  ;}       \
+    static uint8_t  & rvalid (TOP * d) {return d -> PFX ## _rvalid ;}       \
+    static uint8_t  & rready (TOP * d) {return d -> PFX ## _rready ;}       \
+    static uint8_t  & rid    (TOP * d) {return d -> PFX ## _rid    ;}       \
+    static uint64_t & rdata  (TOP * d) {return d -> PFX ## _rdata  ;}       \
+    static uint8_t  & rresp  (TOP * d) {return d -> PFX ## _rresp  ;}       \
+    static uint8_t  & rlast  (TOP * d) {return d -> PFX ## _rlast  ;}       \
+};
+
+/*!
+@brief Acts as an AXI4 slave agent with configurable latency and bandwidth.
+@details Supports INCR bursts of 8-byte beats, and multiple outstanding
+    read and write transactions. Read data is returned in request order.
+@tparam PORT - Port binding traits, declared with AXI_SLAVE_PORT.
+*/
+template <class PORT>
+class axi_slave_agent {
+
+public:
+
+    typedef typename PORT::top_t top_t;
+
+    axi_slave_agent (
+        top_t      * dut,
+        memory_bus * mem
+    ) {
+        this -> dut = dut;
+        this -> mem = mem;
+    }
+
+
+    //! Put the interface in reset
+    void set_reset();
+
+    //! Take the interface out of reset
+    void clear_reset();
+
+    //! Compute any *next* signal values
+    void posedge_clk();
+
+    //! Drive any signal updates
+    void drive_signals();
+
+    //! Print bandwidth / latency statistics.
+    void print_stats(std::ostream & os);
+
+    //! Cycles since the oldest outstanding transaction was accepted.
+    uint64_t max_wait();
+
+    //! Print every outstanding transaction.
+    void print_outstanding(std::ostream & os);
+
+    //! Cycles from an accepted AR to the first R beat.
+    uint32_t   rd_latency      = 8;
+
+    //! Cycles from the last accepted W beat to the B response.
+    uint32_t   wr_latency      = 4;
+
+    //! Minimum cycles between data beats. 1 = one beat per cycle.
+    uint32_t   beat_interval   = 1;
+
+    //! Maximum outstanding read / write transactions.
+    uint32_t   max_outstanding = 8;
+
+protected:
+
+    //! A single outstanding AXI transaction.
+    typedef struct axi_txn {
+        uint8_t  id      ; // Transaction ID
+        uint64_t addr    ; // Start address
+        uint32_t len     ; // Number of beats - 1
+        uint32_t beat    ; // Next beat to transfer.
+        uint64_t ready_at; // Cycle at which the next beat may go.
+        uint64_t start   ; // Cycle the address was accepted.
+        bool     err     ; // Error seen on any beat so far.
+    } axi_txn_t;
+
+    //! The DUT whose port this agent drives.
+    top_t      * dut;
+
+    //! memory bus this agent can access.
+    memory_bus * mem;
+
+    //! Current cycle count.
+    uint64_t   cycle = 0;
+
+    std::deque<axi_txn_t> rd_q; // Accepted read bursts.
+    std::deque<axi_txn_t> aw_q; // Accepted write addresses.
+    std::deque<axi_txn_t> b_q ; // Writes waiting for their response.
+
+    //! Can a beat / response which is ready at cycle t be driven now?
+    bool can_drive(uint64_t t) {
+        return t <= cycle + 1;
+    }
+
+    //! Cycles since the oldest transaction in q was accepted.
+    uint64_t oldest(std::deque<axi_txn_t> & q) {
+        return q.empty() ? 0 : cycle - q.front().start;
+    }
+
+    //! Print each transaction in q.
+    void print_queue(
+        std::ostream          & os,
+        const char            * what,
+        std::deque<axi_txn_t> & q
+    );
+
+    //! Address of a given beat within a burst.
+    uint64_t beat_addr(axi_txn_t & t) {
+        return t.beat == 0 ? t.addr : (t.addr & ~0x7UL) + 8*t.beat;
+    }
+
+    uint8_t  n_awready  = 0;
+    uint8_t  n_wready   = 0;
+    uint8_t  n_bvalid   = 0;
+    uint8_t  n_bid      = 0;
+    uint8_t  n_bresp    = 0;
+    uint8_t  n_arready  = 0;
+    uint8_t  n_rvalid   = 0;
+    uint8_t  n_rid      = 0;
+    uint64_t n_rdata    = 0;
+    uint8_t  n_rresp    = 0;
+    uint8_t  n_rlast    = 0;
+
+    // Statistics
+    uint64_t stat_rd_bursts     = 0;
+    uint64_t stat_rd_beats      = 0;
+    uint64_t stat_rd_latency    = 0; // Sum of AR -> first R beat cycles.
+    uint64_t stat_wr_bursts     = 0;
+    uint64_t stat_wr_beats      = 0;
+    uint64_t stat_wr_latency    = 0; // Sum of AW -> B cycles.
+
+};
+
+
+//! Put the interface in reset
+template <class PORT>
+void axi_slave_agent<PORT>::set_reset(){
+
+    n_awready = 0;
+    n_wready  = 0;
+    n_bvalid  = 0;
+    n_arready = 0;
+    n_rvalid  = 0;
+
+    rd_q.clear();
+    aw_q.clear();
+    b_q.clear();
+
+    this -> drive_signals();
+
+}
+
+
+//! Take the interface out of reset
+template <class PORT>
+void axi_slave_agent<PORT>::clear_reset(){
+
+}
+
+
+//! Drive any signal updates
+template <class PORT>
+void axi_slave_agent<PORT>::drive_signals(){
+
+    PORT::awready(dut)  = n_awready;
+    PORT::wready(dut)   = n_wready ;
+    PORT::bvalid(dut)   = n_bvalid ;
+    PORT::bid(dut)      = n_bid    ;
+    PORT::bresp(dut)    = n_bresp  ;
+    PORT::arready(dut)  = n_arready;
+    PORT::rvalid(dut)   = n_rvalid ;
+    PORT::rid(dut)      = n_rid    ;
+    PORT::rdata(dut)    = n_rdata  ;
+    PORT::rresp(dut)    = n_rresp  ;
+    PORT::rlast(dut)    = n_rlast  ;
+
+}
+
+
+//! Compute any *next* signal values
+template <class PORT>
+void axi_slave_agent<PORT>::posedge_clk(){
+
+    this -> cycle ++;
+
+    //
+    // Handshakes which happened on this clock edge.
+
+    if(PORT::arvalid(dut) && PORT::arready(dut)) {
+        rd_q.push_back({
+            PORT::arid(dut), PORT::araddr(dut), PORT::arlen(dut), 0,
+            cycle + rd_latency, cycle, false
+        });
+        stat_rd_bursts ++;
+    }
+
+    if(PORT::rvalid(dut) && PORT::rready(dut)) {
+        axi_txn_t & t = rd_q.front();
+        if(t.beat == 0) {
+            stat_rd_latency += cycle - t.start;
+        }
+        stat_rd_beats ++;
+        if(t.beat == t.len) {
+            rd_q.pop_front();
+        } else {
+            t.beat     ++;
+            t.ready_at = cycle + beat_interval;
+        }
+    }
+
+    if(PORT::awvalid(dut) && PORT::awready(dut)) {
+        aw_q.push_back({
+            PORT::awid(dut), PORT::awaddr(dut), PORT::awlen(dut), 0,
+            cycle, cycle, false
+        });
+        stat_wr_bursts ++;
+    }
+
+    if(PORT::wvalid(dut) && PORT::wready(dut)) {
+
+        axi_txn_t & t = aw_q.front();
+
+        memory_req_txn * req = new memory_req_txn(beat_addr(t), 8, true);
+
+        for(int i = 0; i < 8 ; i ++) {
+            req -> data()[i] = (PORT::wdata(dut) >> (8*i)) & 0xFF;
+            req -> strb()[i] = (bool)((PORT::wstrb(dut) >> i) & 0x1);
+        }
+
+        memory_rsp_txn * rsp = this -> mem -> request(req);
+
+        t.err |= rsp -> error();
+
+        delete req;
+        delete rsp;
+
+        stat_wr_beats ++;
+
+        if(PORT::wlast(dut) || t.beat == t.len) {
+            t.ready_at = cycle + wr_latency;
+            b_q.push_back(t);
+            aw_q.pop_front();
+        } else {
+            t.beat     ++;
+            t.ready_at = cycle + beat_interval;
+        }
+    }
+
+    if(PORT::bvalid(dut) && PORT::bready(dut)) {
+        stat_wr_latency += cycle - b_q.front().start;
+        b_q.pop_front();
+    }
+
+    //
+    // Next signal values.
+
+    n_arready = rd_q.size()               < max_outstanding;
+    n_awready = aw_q.size() + b_q.size()  < max_outstanding;
+    n_wready  = !aw_q.empty() && can_drive(aw_q.front().ready_at);
+
+    if(!rd_q.empty() && can_drive(rd_q.front().ready_at)) {
+
+        axi_txn_t & t = rd_q.front();
+
+        memory_req_txn * req = new memory_req_txn(beat_addr(t), 8, false);
+        memory_rsp_txn * rsp = this -> mem -> request(req);
+
+        n_rvalid = 1;
+        n_rid    = t.id;
+        n_rdata  = rsp -> data_dword();
+        n_rresp  = rsp -> error() ? 2 : 0;
+        n_rlast  = t.beat == t.len;
+
+        delete req;
+        delete rsp;
+
+    } else {
+        n_rvalid = 0;
+        n_rlast  = 0;
+    }
+
+    if(!b_q.empty() && can_drive(b_q.front().ready_at)) {
+        n_bvalid = 1;
+        n_bid    = b_q.front().id;
+        n_bresp  = b_q.front().err ? 2 : 0;
+    } else {
+        n_bvalid = 0;
+    }
+
+}
+
+
+//! Print bandwidth / latency statistics.
+template <class PORT>
+void axi_slave_agent<PORT>::print_stats(std::ostream & os) {
+
+    double rd_lat = stat_rd_bursts ?
+        (double)stat_rd_latency / stat_rd_bursts : 0;
+    double wr_lat = stat_wr_bursts ?
+        (double)stat_wr_latency / stat_wr_bursts : 0;
+    double bw     = cycle ?
+        (double)(8*(stat_rd_beats + stat_wr_beats)) / cycle : 0;
+
+    os << std::dec << std::fixed << std::setprecision(2)
+       << ">> AXI reads : " << stat_rd_bursts << " bursts, "
+       << stat_rd_beats << " beats, avg latency " << rd_lat << " cycles"
+       << std::endl
+       << ">> AXI writes: " << stat_wr_bursts << " bursts, "
+       << stat_wr_beats << " beats, avg latency " << wr_lat << " cycles"
+       << std::endl
+       << ">> AXI bandwidth: " << bw << " bytes/cycle" << std::endl;
+
+}
+
+
+//! Cycles since the oldest outstanding transaction was accepted.
+template <class PORT>
+uint64_t axi_slave_agent<PORT>::max_wait() {
+
+    return std::max(oldest(rd_q), std::max(oldest(aw_q), oldest(b_q)));
+
+}
+
+
+//! Print every outstanding transaction.
+template <class PORT>
+void axi_slave_agent<PORT>::print_outstanding(std::ostream & os) {
+
+    print_queue(os, "read  burst", rd_q);
+    print_queue(os, "write burst", aw_q);
+    print_queue(os, "write resp ", b_q );
+
+}
+
+
+//! Print each transaction in q.
+template <class PORT>
+void axi_slave_agent<PORT>::print_queue (
+    std::ostream          & os,
+    const char            * what,
+    std::deque<axi_txn_t> & q
+) {
+
+    for(axi_txn_t & t : q) {
+        os << ">> " << PORT::name() << ": " << what
+           << " id " << std::dec << (uint32_t)t.id
+           << " addr 0x" << std::hex << t.addr
+           << std::dec << " beat " << t.beat << "/" << t.len + 1
+           << ", waited " << cycle - t.start << " cycles" << std::endl;
+    }
+
+}
+
+#endif
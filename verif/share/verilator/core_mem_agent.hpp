@@ -1,5 +1,6 @@
 
-#include <queue>
+#include <cstdlib>
+#include <iostream>
 
 #include "memory_txns.hpp"
 #include "memory_bus.hpp"
@@ -7,58 +8,189 @@
 #ifndef SRAM_AGENT_HPP
 #define SRAM_AGENT_HPP
 
+/*!
+@brief Declare a port binding traits struct for a core_mem_agent.
+@details NAME is the new struct, TOP the Verilated top level class and PFX
+    the port name prefix, e.g. imem, dmem or emem. Each accessor returns a
+    reference to one port signal, so the agent reaches the DUT directly,
+    rather than through a pointer per signal.
+*/
+#define CORE_MEM_PORT(NAME, TOP, PFX)                                       \
+struct NAME {                                                               \
+    typedef TOP top_t;                                                      \
+    static const char * name() {return #PFX;}                               \
+    static uint8_t  & req  (TOP * d) {return d -> PFX ## _req  ;}           \
+    static uint64_t & addr (TOP * d) {return d -> PFX ## _addr ;}           \
+    static uint8_t  & wen  (TOP * d) {return d -> PFX ## _wen  ;}           \
+    static uint8_t  & strb (TOP * d) {return d -> PFX ## _strb ;}           \
+    static uint64_t & wdata(TOP * d) {return d -> PFX ## _wdata;}           \
+    static uint8_t  & gnt  (TOP * d) {return d -> PFX ## _gnt  ;}           \
+    static uint8_t  & err  (TOP * d) {return d -> PFX ## _err  ;}           \
+    static uint64_t & rdata(TOP * d) {return d -> PFX ## _rdata;}           \
+};
+
 /*!
 @brief Acts as an SRAM slave agent.
+@tparam PORT - Port binding traits, declared with CORE_MEM_PORT.
 */
+template <class PORT>
 class core_mem_agent {
 
 public:
 
+    typedef typename PORT::top_t top_t;
+
     core_mem_agent (
+        top_t      * dut,
         memory_bus * mem
-    );
+    ) {
+        this -> dut = dut;
+        this -> mem = mem;
+    }
 
 
     //! Put the interface in reset
-    void set_reset();
-    
+    void set_reset() {
+        PORT::gnt(dut) = 0;
+    }
+
     //! Take the interface out of reset
-    void clear_reset();
-    
+    void clear_reset() {}
+
     //! Compute any *next* signal values
     void posedge_clk();
 
     //! Drive any signal updates
-    void drive_signals();
-
-    uint8_t   * mem_req     ; // Memory request
-    uint64_t  * mem_addr    ; // Memory request address
-    uint8_t   * mem_wen     ; // Memory request write enable
-    uint8_t   * mem_strb    ; // Memory request write strobe
-    uint64_t  * mem_wdata   ; // Memory write data.
-    uint8_t   * mem_gnt     ; // Memory response valid
-    uint8_t   * mem_err     ; // Memory response error
-    uint64_t  * mem_rdata   ; // Memory response read data
+    void drive_signals() {
+        PORT::err  (dut) = n_mem_err  ;
+        PORT::rdata(dut) = n_mem_rdata;
+        PORT::gnt  (dut) = n_mem_gnt  ;
+    }
 
     //! Maximum length of a stalled request.
     uint32_t   max_req_stall = 2;
 
+    //! Cycles the current request has waited for a grant.
+    uint64_t max_wait() {
+        return req_wait;
+    }
+
+    //! Print the request waiting for a grant, if any.
+    void print_outstanding(std::ostream & os);
+
 protected:
 
+    //! Consecutive cycles req has been high without gnt.
+    uint64_t   req_wait      = 0;
+
     //! Current request stall length.
     uint32_t   req_stall_len = 0;
 
+    //! The DUT whose port this agent drives.
+    top_t      * dut;
+
     //! memory bus this agent can access.
     memory_bus * mem;
-    
+
     uint8_t  n_mem_err  ;  // Next Error
     uint8_t  n_mem_gnt  ;  // Next Memory stall
     uint64_t n_mem_rdata;  // Next Read data
-    
+
     uint8_t rand_chance(int a, int b) {
         return ((rand() % b) < a) ? 1 : 0;
     }
-    
+
 };
 
+
+//! Compute any *next* signal values
+template <class PORT>
+void core_mem_agent<PORT>::posedge_clk(){
+
+    if(PORT::req(dut) && PORT::gnt(dut)) {
+
+        // There is an outstanding request
+
+        this -> req_stall_len = 0;
+        this -> req_wait      = 0;
+
+        //
+        // Construct the new memory request.
+
+        size_t txn_length  = 8;
+
+        memory_req_txn * req = new memory_req_txn(
+            PORT::addr(dut),
+            txn_length,
+            PORT::wen(dut)
+        );
+
+        if(PORT::wen(dut)) {
+
+            for(int i = 0; i < txn_length ; i ++) {
+                req -> data()[i] = (PORT::wdata(dut) >> (8*i)) & 0xFF;
+                req -> strb()[i] = (bool)((PORT::strb(dut) >> i) & 0x1);
+            }
+
+        }
+
+        //
+        // Issue the memory request and get the response
+
+        memory_rsp_txn * rsp = this -> mem -> request(req);
+
+        n_mem_err   = rsp -> error();
+
+        if(req -> is_read()) {
+            n_mem_rdata = rsp -> data_dword();
+        }
+
+        if(n_mem_err) {
+            std::cout   << "Error accessing address: "
+                        << std::hex<<rsp->addr()
+                        << std::endl;
+        }
+
+        //
+        // Clean up the requests/responses.
+        delete req;
+        delete rsp;
+
+    } else {
+
+        // There is no outstanding memory request.
+
+        this -> req_wait = PORT::req(dut) ? this -> req_wait + 1 : 0;
+
+        n_mem_err   = rand_chance(5,10);
+        n_mem_rdata = ((uint64_t)rand() << 32) | rand();
+
+    }
+
+    n_mem_gnt   = rand_chance(9,10);
+
+}
+
+
+//! Print the request waiting for a grant, if any.
+template <class PORT>
+void core_mem_agent<PORT>::print_outstanding(std::ostream & os) {
+
+    if(!PORT::req(dut)) {
+        return;
+    }
+
+    os << ">> " << PORT::name() << ": "
+       << (PORT::wen(dut) ? "write" : "read ") << " 0x"
+       << std::hex << PORT::addr(dut);
+
+    if(PORT::wen(dut)) {
+        os << " strb 0x" << (uint32_t)PORT::strb(dut)
+           << " data 0x" << PORT::wdata(dut);
+    }
+
+    os << std::dec << ", waited " << req_wait << " cycles" << std::endl;
+
+}
+
 #endif
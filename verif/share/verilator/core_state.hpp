@@ -0,0 +1,119 @@
+
+#ifndef CORE_STATE_HPP
+#define CORE_STATE_HPP
+
+//
+// Access to core state through public RTL signals. GPRs come from the
+// flop-based core_regfile, so need FPGA_REGFILE = 0. The trap CSRs,
+// clock enables and pipeline view are public_flat_rd signals in
+// core_csrs, core_clock_ctrl, core_top and core_pipe_fetch.
+//
+
+//! Pointer to register N. PFX is the flattened core_top instance name.
+#define CORE_GPR_PTR(ROOTP, PFX, N) \
+    (& ROOTP -> PFX ## __DOT__i_core_regfile__DOT__ff_regfile__DOT__gen_regs__BRA__ ## N ## __KET____DOT__r)
+
+/*!
+@brief Return a pointer to register IDX, or NULL for x0 and out of range
+    indexes. Used to write top level traits gpr() accessors.
+*/
+#define CORE_GPR_SWITCH(ROOTP, PFX, IDX)                                    \
+    switch(IDX) {                                                           \
+        case  1: return CORE_GPR_PTR(ROOTP, PFX,  1);                       \
+        case  2: return CORE_GPR_PTR(ROOTP, PFX,  2);                       \
+        case  3: return CORE_GPR_PTR(ROOTP, PFX,  3);                       \
+        case  4: return CORE_GPR_PTR(ROOTP, PFX,  4);                       \
+        case  5: return CORE_GPR_PTR(ROOTP, PFX,  5);                       \
+        case  6: return CORE_GPR_PTR(ROOTP, PFX,  6);                       \
+        case  7: return CORE_GPR_PTR(ROOTP, PFX,  7);                       \
+        case  8: return CORE_GPR_PTR(ROOTP, PFX,  8);                       \
+        case  9: return CORE_GPR_PTR(ROOTP, PFX,  9);                       \
+        case 10: return CORE_GPR_PTR(ROOTP, PFX, 10);                       \
+        case 11: return CORE_GPR_PTR(ROOTP, PFX, 11);                       \
+        case 12: return CORE_GPR_PTR(ROOTP, PFX, 12);                       \
+        case 13: return CORE_GPR_PTR(ROOTP, PFX, 13);                       \
+        case 14: return CORE_GPR_PTR(ROOTP, PFX, 14);                       \
+        case 15: return CORE_GPR_PTR(ROOTP, PFX, 15);                       \
+        case 16: return CORE_GPR_PTR(ROOTP, PFX, 16);                       \
+        case 17: return CORE_GPR_PTR(ROOTP, PFX, 17);                       \
+        case 18: return CORE_GPR_PTR(ROOTP, PFX, 18);                       \
+        case 19: return CORE_GPR_PTR(ROOTP, PFX, 19);                       \
+        case 20: return CORE_GPR_PTR(ROOTP, PFX, 20);                       \
+        case 21: return CORE_GPR_PTR(ROOTP, PFX, 21);                       \
+        case 22: return CORE_GPR_PTR(ROOTP, PFX, 22);                       \
+        case 23: return CORE_GPR_PTR(ROOTP, PFX, 23);                       \
+        case 24: return CORE_GPR_PTR(ROOTP, PFX, 24);                       \
+        case 25: return CORE_GPR_PTR(ROOTP, PFX, 25);                       \
+        case 26: return CORE_GPR_PTR(ROOTP, PFX, 26);                       \
+        case 27: return CORE_GPR_PTR(ROOTP, PFX, 27);                       \
+        case 28: return CORE_GPR_PTR(ROOTP, PFX, 28);                       \
+        case 29: return CORE_GPR_PTR(ROOTP, PFX, 29);                       \
+        case 30: return CORE_GPR_PTR(ROOTP, PFX, 30);                       \
+        case 31: return CORE_GPR_PTR(ROOTP, PFX, 31);                       \
+        default: return NULL;                                               \
+    }
+
+//! A core_csrs register. PFX is the flattened core_top instance name.
+#define CORE_CSR(ROOTP, PFX, REG) \
+    ((uint64_t)ROOTP -> PFX ## __DOT__i_core_csrs__DOT__ ## REG)
+
+/*!
+@brief Return the trap CSRs as a dut_csrs_t, re-assembling each from its
+    fields the same way core_csrs does. Used to write top level traits
+    csrs() accessors.
+*/
+#define CORE_CSRS_RETURN(ROOTP, PFX)                                        \
+    dut_csrs_t r;                                                           \
+    r.mepc   =  CORE_CSR(ROOTP, PFX, reg_mepc_mepc       ) << 1;            \
+    r.mcause =  CORE_CSR(ROOTP, PFX, reg_mcause_interrupt) << 63 |          \
+                CORE_CSR(ROOTP, PFX, reg_mcause_cause    );                 \
+    r.mtval  =  CORE_CSR(ROOTP, PFX, reg_mtval           );                 \
+    r.mtvec  =  CORE_CSR(ROOTP, PFX, reg_mtvec_base      ) << 2 |           \
+                CORE_CSR(ROOTP, PFX, reg_mtvec_mode      );                 \
+    return r;
+
+//! Number of core gated clock domains. See core_clock_ctrl.
+#define CORE_CLOCK_DOMAINS 3
+
+//! Name of core gated clock domain i, in core_clock_ctrl clk_en order.
+static inline const char * core_clock_name(int i) {
+    static const char * names[CORE_CLOCK_DOMAINS] = {
+        "g_clk", "g_clk_rf", "g_clk_mul"
+    };
+    return names[i];
+}
+
+//! The core_clock_ctrl clk_en vector.
+#define CORE_CLOCK_EN_ALL(ROOTP, PFX) \
+    (ROOTP -> PFX ## __DOT__i_core_clock_ctrl__DOT__clk_en)
+
+//! Does core gated clock domain I tick on the next f_clk edge?
+#define CORE_CLOCK_EN(ROOTP, PFX, I) \
+    ((CORE_CLOCK_EN_ALL(ROOTP, PFX) >> (I)) & 1)
+
+//! A core_top signal. PFX is the flattened core_top instance name.
+#define CORE_SIG(ROOTP, PFX, SIG) (ROOTP -> PFX ## __DOT__ ## SIG)
+
+/*!
+@brief Return the pipeline view signals as a pv_sample_t. Used to write
+    top level traits pipeview() accessors. See tb_pipeview.hpp
+*/
+#define CORE_PIPEVIEW_RETURN(ROOTP, PFX)                                    \
+    uint32_t    ev = CORE_SIG(ROOTP, PFX, pv_events);                       \
+    pv_sample_t r;                                                          \
+    r.s2_valid   = (ev >> 0) & 1;                                           \
+    r.s2_ready   = (ev >> 1) & 1;                                           \
+    r.s2_b_valid = (ev >> 2) & 1;                                           \
+    r.s2_flush   = (ev >> 3) & 1;                                           \
+    r.cf_change  = (ev >> 4) & 1;                                           \
+    r.ret        = (ev >> 5) & 1;                                           \
+    r.ret_b      = (ev >> 6) & 1;                                           \
+    r.stall      = (pv_stall_t)((ev >> 7) & 7);                             \
+    r.fill       = CORE_SIG(ROOTP, PFX, i_core_pipe_fetch__DOT__pv_fill);   \
+    r.s2_pc      = CORE_SIG(ROOTP, PFX, pv_s2_pc     );                     \
+    r.s2_instr   = CORE_SIG(ROOTP, PFX, pv_s2_instr  );                     \
+    r.s2_b_pc    = CORE_SIG(ROOTP, PFX, pv_s2_b_pc   );                     \
+    r.s2_b_instr = CORE_SIG(ROOTP, PFX, pv_s2_b_instr);                     \
+    return r;
+
+#endif
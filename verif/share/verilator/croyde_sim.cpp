@@ -0,0 +1,297 @@
+
+#include <new>
+#include <string>
+
+#include "srec.hpp"
+#include "testbench.hpp"
+#include "croyde_sim.h"
+
+// Picks the top level traits. See main.cpp
+#include "tb_top.hpp"
+
+#ifdef CCX_MEM_DPI
+#include "memory_dpi.hpp"
+#endif
+
+typedef testbench<tb_top_traits> sim_testbench;
+
+//! One simulation instance. Opaque to C callers.
+struct croyde_sim {
+
+    croyde_sim (
+        std::string waves,
+        bool        dump
+    ) : tb(waves, dump) {}
+
+    sim_testbench           tb;
+
+    croyde_sim_retire_fn    retire_fn   = NULL;
+    void                  * retire_ctx  = NULL;
+
+};
+
+#ifdef CCX_MEM_DPI
+//! Instance whose bus the mem_dpi_wxd RTL currently reaches.
+static croyde_sim_t * dpi_owner = NULL;
+#endif
+
+//! Point any process-wide state at s before simulating it.
+static void sim_select (
+    croyde_sim_t * s
+) {
+#ifdef CCX_MEM_DPI
+    if(dpi_owner != s) {
+        memory_dpi_set_bus(s -> tb.bus);
+        dpi_owner = s;
+    }
+#endif
+}
+
+
+/*!
+@brief Step the clock once, then pass each retired instruction to the
+    retire callback.
+@returns true if pc retired.
+*/
+static bool sim_tick (
+    croyde_sim_t * s,
+    uint64_t       pc,
+    uint64_t       max_ticks
+) {
+    auto * dut   = s -> tb.dut;
+    bool   found = false;
+
+    dut -> dut_step_clk();
+    dut -> dut_wfi_fast_forward(max_ticks);
+
+    while(!dut -> dut_trace.empty()) {
+
+        dut_trace_pkt_t t = dut -> dut_trace.front();
+        dut -> dut_trace.pop();
+
+        if(s -> retire_fn != NULL) {
+            s -> retire_fn(s -> retire_ctx, t.program_counter, t.instr_word);
+        }
+
+        found |= t.program_counter == pc;
+    }
+
+    return found;
+}
+
+
+/*!
+@brief Run for up to max_cycles, stopping at HTIF exit, or when pc
+    retires if until_pc is set.
+@returns 1 if pc retired, -1 on exit, else 0.
+*/
+static int sim_run (
+    croyde_sim_t * s,
+    uint64_t       max_cycles,
+    bool           until_pc,
+    uint64_t       pc
+) {
+    sim_select(s);
+
+    auto   * dut   = s -> tb.dut;
+    uint64_t end   = dut -> get_sim_time() +
+                     max_cycles * dut -> ticks_per_cycle();
+
+    while(dut -> get_sim_time() < end) {
+
+        if(s -> tb.htif_0 -> exited()) {
+            return -1;
+        }
+
+        bool hit = sim_tick(s, pc, end - dut -> get_sim_time());
+
+        if(until_pc && hit) {
+            return 1;
+        }
+    }
+
+    return s -> tb.htif_0 -> exited() ? -1 : 0;
+}
+
+
+extern "C" {
+
+const char * croyde_sim_top (void) {
+    return tb_top_traits::name();
+}
+
+
+croyde_sim_t * croyde_sim_new (
+    const char * waves
+) {
+    croyde_sim_t * s = new (std::nothrow) croyde_sim(
+        waves == NULL ? "" : waves,
+        waves != NULL
+    );
+
+    if(s != NULL) {
+        // add_devices may have pointed the DPI memories at this bus.
+        sim_select(s);
+        s -> tb.dut -> dut_set_reset();
+    }
+
+    return s;
+}
+
+
+void croyde_sim_free (
+    croyde_sim_t * s
+) {
+#ifdef CCX_MEM_DPI
+    if(dpi_owner == s) {
+        memory_dpi_set_bus(NULL);
+        dpi_owner = NULL;
+    }
+#endif
+    delete s;
+}
+
+
+void croyde_sim_reset (
+    croyde_sim_t * s
+) {
+    sim_select(s);
+
+    auto * dut = s -> tb.dut;
+
+    dut -> dut_set_reset();
+
+    s -> tb.htif_0 -> reset();
+
+    for(int i = 0; i < 5; i ++) {
+        dut -> dut_step_clk();
+    }
+
+    dut -> dut_clear_reset();
+
+    while(!dut -> dut_trace.empty()) {
+        dut -> dut_trace.pop();
+    }
+}
+
+
+int croyde_sim_load_srec (
+    croyde_sim_t * s,
+    const char   * path
+) {
+    srec::srec_file fh(path);
+
+    if(fh.data.empty()) {
+        return -1;
+    }
+
+    for(auto it  = fh.data.begin();
+             it != fh.data.end();
+             it ++) {
+        if(!s -> tb.bus -> write_byte(it -> first, it -> second)) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+
+uint64_t croyde_sim_step (
+    croyde_sim_t * s,
+    uint64_t       n
+) {
+    uint64_t start = croyde_sim_cycles(s);
+    sim_run(s, n, false, 0);
+    return croyde_sim_cycles(s) - start;
+}
+
+
+int croyde_sim_run_until_pc (
+    croyde_sim_t * s,
+    uint64_t       pc,
+    uint64_t       max_cycles
+) {
+    return sim_run(s, max_cycles, true, pc);
+}
+
+
+int croyde_sim_read_mem (
+    croyde_sim_t * s,
+    uint64_t       addr,
+    void         * buf,
+    size_t         len
+) {
+    return s -> tb.bus -> read_range(addr, len, (uint8_t*)buf) ? 0 : -1;
+}
+
+
+int croyde_sim_write_mem (
+    croyde_sim_t * s,
+    uint64_t       addr,
+    void const   * buf,
+    size_t         len
+) {
+    return s -> tb.bus -> write_range(addr, len, (uint8_t*)buf) ? 0 : -1;
+}
+
+
+uint64_t croyde_sim_read_gpr (
+    croyde_sim_t * s,
+    unsigned       idx
+) {
+    uint64_t * r = s -> tb.dut -> dut_gpr(idx);
+    return r == NULL ? 0 : *r;
+}
+
+
+void croyde_sim_write_gpr (
+    croyde_sim_t * s,
+    unsigned       idx,
+    uint64_t       value
+) {
+    uint64_t * r = s -> tb.dut -> dut_gpr(idx);
+    if(r != NULL) {
+        *r = value;
+    }
+}
+
+
+uint64_t croyde_sim_cycles (
+    croyde_sim_t * s
+) {
+    return s -> tb.dut -> get_sim_time() / s -> tb.dut -> ticks_per_cycle();
+}
+
+
+uint64_t croyde_sim_instret (
+    croyde_sim_t * s
+) {
+    return s -> tb.dut -> instrs_retired;
+}
+
+
+int croyde_sim_exited (
+    croyde_sim_t * s,
+    uint64_t     * code
+) {
+    if(!s -> tb.htif_0 -> exited()) {
+        return 0;
+    }
+    if(code != NULL) {
+        *code = s -> tb.htif_0 -> exit_code();
+    }
+    return 1;
+}
+
+
+void croyde_sim_on_retire (
+    croyde_sim_t         * s,
+    croyde_sim_retire_fn   fn,
+    void                 * ctx
+) {
+    s -> retire_fn  = fn;
+    s -> retire_ctx = ctx;
+}
+
+}
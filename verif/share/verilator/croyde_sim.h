@@ -0,0 +1,133 @@
+
+/*!
+@file croyde_sim.h
+@brief C API for driving a Verilated top level in-process.
+@details Built as a shared library with make build-lib-<top>, e.g.
+    build-lib-core_top. Each croyde_sim_t owns its own model, memory bus
+    and devices, so a harness may keep several alive at once. They must
+    not be stepped from more than one thread at a time.
+
+    Cycles here are full clock cycles. The stand-alone testbench's
+    "simulated clock cycles" count is twice this.
+*/
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifndef CROYDE_SIM_H
+#define CROYDE_SIM_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+//! An opaque simulation instance.
+typedef struct croyde_sim croyde_sim_t;
+
+//! Called for every retired instruction, in program order.
+typedef void (*croyde_sim_retire_fn) (
+    void     * ctx  , //!< Passed through from croyde_sim_on_retire.
+    uint64_t   pc   , //!< Address of the instruction.
+    uint32_t   instr  //!< Instruction word. Compressed in the low 16 bits.
+);
+
+//! Name of the Verilated top level this library was built for.
+const char * croyde_sim_top         (void);
+
+/*!
+@brief Create a new instance, held in reset.
+@param waves - VCD file to write, or NULL for none.
+@returns NULL on failure.
+*/
+croyde_sim_t * croyde_sim_new       (const char * waves);
+
+//! Free an instance, closing any wave file.
+void     croyde_sim_free            (croyde_sim_t * s);
+
+/*!
+@brief Reset the core, its memory agents and the HTIF device. Memory
+    contents are kept.
+@details Holds reset for a few cycles, then releases it. The core starts
+    fetching from its reset vector on the next call which steps it.
+    Any HTIF exit is forgotten, and files the target opened are closed,
+    so the instance can run another program. croyde_sim_cycles and
+    croyde_sim_instret do not restart from zero: they keep counting
+    across resets, so take their difference to measure a run.
+*/
+void     croyde_sim_reset           (croyde_sim_t * s);
+
+//! Load an SREC file into memory. @returns 0 on success.
+int      croyde_sim_load_srec       (croyde_sim_t * s, const char * path);
+
+/*!
+@brief Run for up to n clock cycles.
+@details Stops early if the target exits through HTIF. Idle WFI cycles
+    may be fast-forwarded, where the top level supports it.
+@returns The number of cycles run.
+*/
+uint64_t croyde_sim_step            (croyde_sim_t * s, uint64_t n);
+
+/*!
+@brief Run until the instruction at pc retires, for at most max_cycles.
+@returns 1 if pc retired, 0 on running out of cycles, -1 if the target
+    exited through HTIF first.
+*/
+int      croyde_sim_run_until_pc    (
+    croyde_sim_t * s,
+    uint64_t       pc,
+    uint64_t       max_cycles
+);
+
+//! Read len bytes of target memory. @returns 0 on success.
+int      croyde_sim_read_mem        (
+    croyde_sim_t * s,
+    uint64_t       addr,
+    void         * buf,
+    size_t         len
+);
+
+//! Write len bytes of target memory. @returns 0 on success.
+int      croyde_sim_write_mem       (
+    croyde_sim_t * s,
+    uint64_t       addr,
+    void const   * buf,
+    size_t         len
+);
+
+//! Read GPR x<idx>. x0 and bad indexes read as zero.
+uint64_t croyde_sim_read_gpr        (croyde_sim_t * s, unsigned idx);
+
+/*!
+@brief Write GPR x<idx>. Writes to x0 and bad indexes are ignored.
+@details Only safe between steps, when no instruction in flight reads or
+    writes the same register. Usually, call it straight after reset or
+    croyde_sim_run_until_pc.
+*/
+void     croyde_sim_write_gpr       (
+    croyde_sim_t * s,
+    unsigned       idx,
+    uint64_t       value
+);
+
+//! Clock cycles simulated so far, including fast-forwarded ones.
+uint64_t croyde_sim_cycles          (croyde_sim_t * s);
+
+//! Instructions retired so far.
+uint64_t croyde_sim_instret         (croyde_sim_t * s);
+
+//! Has the target exited through HTIF? If so, and code is not NULL,
+//! write the exit code to it.
+int      croyde_sim_exited          (croyde_sim_t * s, uint64_t * code);
+
+//! Call fn for every retired instruction. fn = NULL removes it.
+void     croyde_sim_on_retire       (
+    croyde_sim_t         * s,
+    croyde_sim_retire_fn   fn,
+    void                 * ctx
+);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,471 @@
+
+#include <algorithm>
+#include <iomanip>
+#include <iostream>
+#include <queue>
+#include <string>
+#include <type_traits>
+
+#include "verilated.h"
+#include "verilated_vcd_c.h"
+
+#include "memory_bus.hpp"
+#include "tb_cpi_stack.hpp"
+#include "tb_pipeview.hpp"
+
+#ifndef DUT_WRAPPER_HPP
+#define DUT_WRAPPER_HPP
+
+//! A trace packet emitted by the core post-writeback.
+typedef struct dut_trace_pkt {
+    uint64_t program_counter;
+    uint32_t instr_word;
+} dut_trace_pkt_t;
+
+/*!
+@brief Memory agent settings taken from the command line.
+@details Each top level's agents use whichever of these apply to them.
+*/
+typedef struct dut_agent_cfg {
+    uint32_t imem_max_stall     = 0; //!< core_top instruction port.
+    uint32_t dmem_max_stall     = 0; //!< core_top data port.
+    uint32_t mem_max_stall      = 0; //!< ccx_top external memory port.
+    uint32_t axi_rd_latency     = 8; //!< ccx_top_axi4 slave model.
+    uint32_t axi_wr_latency     = 4; //!< ccx_top_axi4 slave model.
+    uint32_t axi_beat_interval  = 1; //!< ccx_top_axi4 slave model.
+} dut_agent_cfg_t;
+
+//! Machine mode trap CSRs, read back for hang diagnostics.
+typedef struct dut_csrs {
+    uint64_t mepc   = 0;
+    uint64_t mcause = 0;
+    uint64_t mtval  = 0;
+    uint64_t mtvec  = 0;
+} dut_csrs_t;
+
+/*!
+@brief Wraps around the design under test.
+@tparam TOP - Top level traits. Every Verilated top level has one, e.g.
+    verif/core/verilator/core_top_traits.hpp. It must provide:
+    - top_t: The Verilated model class.
+    - agents_t: The memory agents for the top's ports, built from a
+      (top_t*, memory_bus*) pair, with set_reset, clear_reset,
+      posedge_clk, drive_signals, configure(dut_agent_cfg_t),
+      print_stats(std::ostream&), max_wait() and
+      print_outstanding(std::ostream&) methods.
+    - trace_lanes, and trs_valid / trs_pc / trs_instr(top_t*, lane)
+      accessors for each instruction trace port, in program order.
+    - gpr(top_t*, idx) and csrs(top_t*), which read core state.
+    - clock_domains, and clock_name(i) / clock_en(top_t*, i) for each
+      gated clock domain.
+    - pipeview(top_t*), which samples the core pipeline for tb_pipeview
+      and tb_cpi_stack.
+    - has_timer. If true, mtime / mtimecmp / mcycle(top_t*) return
+      references to the counters used for WFI fast-forwarding.
+    All of these are resolved at compile time, so agents and trace
+    capture inline into dut_step_clk.
+*/
+template <class TOP>
+class dut_wrapper {
+
+public:
+
+    typedef typename TOP::top_t    top_t;
+    typedef typename TOP::agents_t agents_t;
+
+    //! Path to dump wave files too
+    bool         dump_waves        = false;
+
+    //! File path waves are dumped too.
+    std::string  vcd_wavefile_path = "waves.vcd";
+
+    //! If clear, waves are not dumped, e.g. outside a region of interest.
+    bool         waves_on          = true;
+
+    /*!
+    @brief Create a new dut_wrapper object
+    @param in mem - Memory bus the memory agents access.
+    @param in dump_waves - If true, write wave file.
+    @param in wavefile - Path of the wave file.
+    */
+    dut_wrapper (
+        memory_bus    * mem         ,
+        bool            dump_waves  ,
+        std::string     wavefile
+    );
+
+    //! Close the wave file and free the model.
+    ~dut_wrapper();
+
+
+    //! Put the dut in reset.
+    void dut_set_reset();
+
+    //! Take the DUT out of reset.
+    void dut_clear_reset();
+
+    //! Simulate the DUT for a single clock cycle
+    void dut_step_clk();
+
+    /*!
+    @brief If the core is asleep in WFI waiting for the timer, skip
+        straight to the cycle before the timer interrupt fires.
+    @details mtime and mcycle are advanced by the number of skipped
+        cycles, as if they had been simulated. Only call this between
+        calls to dut_step_clk. Always returns 0 for tops without a timer.
+    @param in max_ticks - Most simulation ticks to skip.
+    @return The number of clock cycles skipped.
+    */
+    uint64_t dut_wfi_fast_forward(uint64_t max_ticks) {
+        return this -> wfi_fast_forward_impl(
+            max_ticks, std::integral_constant<bool, TOP::has_timer>()
+        );
+    }
+
+    //! Return the number of simulation ticks so far.
+    uint64_t get_sim_time() {
+        return this -> sim_time;
+    }
+
+    //! Is the core asleep in WFI?
+    bool dut_wfi_sleep() {
+        return this -> dut -> wfi_sleep;
+    }
+
+    //! Pointer to general purpose register idx, or NULL for x0.
+    //! Needs TOP::gpr.
+    uint64_t * dut_gpr(unsigned idx) {
+        return TOP::gpr(this -> dut, idx);
+    }
+
+    //! Current trap CSR values. Needs TOP::csrs.
+    dut_csrs_t dut_csrs() {
+        return TOP::csrs(this -> dut);
+    }
+
+    //! Number of simulation ticks in one full clock cycle.
+    uint64_t ticks_per_cycle() {
+        return 2 * this -> evals_per_clock;
+    }
+
+    //! Handle to the VCD file for dumping waveforms.
+    VerilatedVcdC* trace_fh;
+
+    //! Trace of post-writeback PC and instructions.
+    std::queue<dut_trace_pkt_t> dut_trace;
+
+    //! Number of instructions retired so far.
+    uint64_t instrs_retired = 0;
+
+    //! Skip idle cycles spent asleep in WFI?
+    bool     wfi_fast_forward   = true;
+
+    //! Number of clock cycles skipped while asleep in WFI.
+    uint64_t wfi_cycles_skipped = 0;
+
+    //! Free-running clock cycles, including skipped ones.
+    uint64_t clock_cycles = 0;
+
+    //! Cycles each gated clock domain ticked, indexed as TOP::clock_name.
+    uint64_t clock_active[TOP::clock_domains] = {0};
+
+    //! Print how often each gated clock domain ticked.
+    void print_clock_activity(std::ostream & os);
+
+    //! Every clock cycle since reset, by what the pipeline did with it.
+    tb_cpi_stack cpi;
+
+    //! If set, sampled on every rising clock edge. Not owned.
+    tb_pipeview * pipeview = NULL;
+
+    //! The memory agents attached to the DUT's ports.
+    agents_t * agents;
+
+protected:
+
+    //! Set of available memories. Fed to memory agents.
+    memory_bus   * mem;
+
+    //! Number of model evaluations per clock cycle
+    const uint32_t  evals_per_clock = 10;
+
+    //! Simulation time, incremented with each tick.
+    uint64_t sim_time;
+
+    //! Cycles the core must sleep before skipping. Lets fetches drain.
+    const uint32_t  wfi_settle_cycles = 32;
+
+    //! Consecutive cycles the core has been idle in WFI.
+    uint32_t wfi_idle_cycles = 0;
+
+    //! mtime and mcycle at the previous rising clock edge.
+    uint64_t wfi_prev_mtime  = 0;
+    uint64_t wfi_prev_cycle  = 0;
+
+    //! The DUT object being wrapped.
+    top_t * dut;
+
+    //! Called on every rising edge of the main clock.
+    void posedge_gclk();
+
+    //! Count n free-running cycles, with the current clock enables.
+    void count_clocks(uint64_t n) {
+        this -> clock_cycles += n;
+        for(int i = 0; i < TOP::clock_domains; i ++) {
+            this -> clock_active[i] += TOP::clock_en(this -> dut, i) ? n : 0;
+        }
+    }
+
+    //! dut_wfi_fast_forward for tops with a timer.
+    uint64_t wfi_fast_forward_impl(uint64_t max_ticks, std::true_type);
+
+    //! dut_wfi_fast_forward for tops without a timer.
+    uint64_t wfi_fast_forward_impl(uint64_t max_ticks, std::false_type) {
+        return 0;
+    }
+
+};
+
+
+/*!
+*/
+template <class TOP>
+dut_wrapper<TOP>::dut_wrapper (
+    memory_bus    * mem         ,
+    bool            dump_waves  ,
+    std::string     wavefile
+){
+
+
+    this -> dut                    = new top_t();
+
+    this -> dump_waves             = dump_waves;
+    this -> vcd_wavefile_path      = wavefile;
+    this -> mem                    = mem;
+
+    this -> agents                 = new agents_t(this -> dut, mem);
+
+    Verilated::traceEverOn(this -> dump_waves);
+
+    if(this -> dump_waves){
+
+        this -> trace_fh = new VerilatedVcdC;
+
+        this -> dut      -> trace(this -> trace_fh, 99);
+
+        this -> trace_fh -> open(this ->vcd_wavefile_path.c_str());
+
+
+    }
+
+    this -> sim_time               = 0;
+
+}
+
+template <class TOP>
+dut_wrapper<TOP>::~dut_wrapper() {
+
+    if(this -> dump_waves) {
+        this -> trace_fh -> close();
+        delete this -> trace_fh;
+    }
+
+    delete this -> agents;
+    delete this -> dut;
+
+}
+
+//! Put the dut in reset.
+template <class TOP>
+void dut_wrapper<TOP>::dut_set_reset() {
+
+    // Put model in reset.
+    this -> dut -> g_resetn     = 0;
+    this -> dut -> f_clk        = 0;
+
+    this -> agents -> set_reset();
+
+}
+
+//! Take the DUT out of reset.
+template <class TOP>
+void dut_wrapper<TOP>::dut_clear_reset() {
+
+    this -> dut -> g_resetn = 1;
+
+    this -> agents -> clear_reset();
+
+}
+
+
+//! Simulate the DUT for a single clock cycle
+template <class TOP>
+void dut_wrapper<TOP>::dut_step_clk() {
+
+    for(uint32_t i = 0; i < this -> evals_per_clock; i++) {
+
+        if(i == this -> evals_per_clock / 2) {
+
+            this -> dut -> f_clk = !this -> dut -> f_clk;
+
+            if(this -> dut -> f_clk == 1){
+
+                this -> posedge_gclk();
+            }
+
+        }
+
+        this -> dut      -> eval();
+
+        // Drive interface agents
+        this -> agents -> drive_signals();
+
+        this -> dut -> eval();
+
+        this -> sim_time ++;
+
+        if(this -> dump_waves && this -> waves_on) {
+            this -> trace_fh -> dump(this -> sim_time);
+        }
+
+    }
+
+}
+
+
+//! Skip idle WFI cycles, up to the cycle before the timer interrupt.
+template <class TOP>
+uint64_t dut_wrapper<TOP>::wfi_fast_forward_impl (
+    uint64_t max_ticks,
+    std::true_type
+) {
+
+    // Only look at the counters just after a rising clock edge.
+    if(!this -> dut -> f_clk) {
+        return 0;
+    }
+
+    uint64_t mtime    = TOP::mtime   (this -> dut);
+    uint64_t mtimecmp = TOP::mtimecmp(this -> dut);
+    uint64_t mcycle   = TOP::mcycle  (this -> dut);
+
+    // The counters may be inhibited. Only advance those which are counting.
+    bool     mtime_on = mtime  == this -> wfi_prev_mtime + 1;
+    bool     mcycle_on= mcycle == this -> wfi_prev_cycle + 1;
+
+    this -> wfi_prev_mtime = mtime ;
+    this -> wfi_prev_cycle = mcycle;
+
+    bool     idle     = this -> wfi_fast_forward &&
+                        this -> dut -> wfi_sleep &&
+                        !this -> dut -> int_sw   &&
+                        !this -> dut -> int_ext  &&
+                        mtime_on;
+
+    if(!idle) {
+        this -> wfi_idle_cycles = 0;
+        return 0;
+    }
+
+    if(this -> wfi_idle_cycles < this -> wfi_settle_cycles) {
+        this -> wfi_idle_cycles ++;
+        return 0;
+    }
+
+    // Stop one cycle short of mtime == mtimecmp, so the RTL raises the
+    // timer interrupt itself.
+    if(mtime + 1 >= mtimecmp) {
+        return 0;
+    }
+
+    uint64_t ticks_per_cycle = 2 * this -> evals_per_clock;
+    uint64_t skip            = mtimecmp - mtime - 1;
+
+    skip = std::min(skip, max_ticks / ticks_per_cycle);
+
+    if(skip == 0) {
+        return 0;
+    }
+
+    TOP::mtime(this -> dut)  = mtime + skip;
+    this -> wfi_prev_mtime   = mtime + skip;
+
+    if(mcycle_on) {
+        TOP::mcycle(this -> dut) = mcycle + skip;
+        this -> wfi_prev_cycle   = mcycle + skip;
+    }
+
+    this -> count_clocks(skip);
+    this -> cpi.add_wfi(skip);
+
+    this -> dut -> eval();
+
+    this -> sim_time           += skip * ticks_per_cycle;
+    this -> wfi_cycles_skipped += skip;
+
+    if(this -> dump_waves && this -> waves_on) {
+        this -> trace_fh -> dump(this -> sim_time);
+    }
+
+    return skip;
+}
+
+
+template <class TOP>
+void dut_wrapper<TOP>::posedge_gclk () {
+
+    // Clock enables are sampled before the edge they gate.
+    this -> count_clocks(1);
+
+    this -> agents -> posedge_clk();
+
+    pv_sample_t pv = TOP::pipeview(this -> dut);
+
+    if(this -> dut -> g_resetn) {
+        this -> cpi.sample(pv, this -> dut -> wfi_sleep);
+    }
+
+    if(this -> pipeview) {
+        this -> pipeview -> sample(
+            this -> sim_time / this -> ticks_per_cycle(), pv
+        );
+    }
+
+    // Do we need to capture a trace item? Later lanes retire after
+    // earlier ones in program order.
+    for(int lane = 0; lane < TOP::trace_lanes; lane ++) {
+        if(TOP::trs_valid(this -> dut, lane)) {
+            this -> instrs_retired ++;
+            this -> dut_trace.push (
+                {
+                    TOP::trs_pc   (this -> dut, lane),
+                    TOP::trs_instr(this -> dut, lane)
+                }
+            );
+        }
+    }
+}
+
+
+
+//! Print how often each gated clock domain ticked.
+template <class TOP>
+void dut_wrapper<TOP>::print_clock_activity(std::ostream & os) {
+
+    for(int i = 0; i < TOP::clock_domains; i ++) {
+
+        double gated = this -> clock_cycles == 0 ? 0 :
+            100.0 * (this -> clock_cycles - this -> clock_active[i]) /
+                    this -> clock_cycles;
+
+        os << ">> Clock " << std::left << std::setw(10)
+           << TOP::clock_name(i) << std::right << std::dec
+           << ": ticked " << this -> clock_active[i] << " of "
+           << this -> clock_cycles << " cycles, gated "
+           << std::fixed << std::setprecision(2) << gated << "%"
+           << std::endl;
+    }
+
+}
+
+#endif
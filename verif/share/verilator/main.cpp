@@ -0,0 +1,558 @@
+
+#include <assert.h>
+
+#include <chrono>
+#include <map>
+#include <queue>
+#include <string>
+#include <vector>
+#include <iostream>
+#include <iomanip>
+#include <cstdlib>
+#include <cstdio>
+
+#include "srec.hpp"
+#include "memory_device.hpp"
+#include "memory_device_mmap.hpp"
+#include "dut_wrapper.hpp"
+#include "testbench.hpp"
+
+// Each top level's verilator directory has a tb_top.hpp, which picks the
+// top level traits used below. Its directory is on the include path.
+#include "tb_top.hpp"
+
+uint32_t    TB_PASS_ADDRESS     = -1;
+uint32_t    TB_FAIL_ADDRESS     = -1;
+
+bool        quiet               = false;
+
+bool        dump_waves          = false;
+std::string vcd_wavefile_path   = "waves.vcd";
+
+bool        dump_signature      = false;
+std::string sig_dump_path       = "signature.sig";
+uint32_t    SIG_START           = 0; //!< Base address of test signature.
+uint32_t    SIG_END             = 0; //!< End address of test signature.
+uint32_t    REG_ADDR            = 0; //!< Base address of register state.
+
+bool        verif_signature     = false;
+std::string sig_verif_path      = "";
+
+uint64_t    max_sim_time        = 10000;
+
+// SREC files to load before the simulation starts, in order.
+std::vector<std::string> srec_paths;
+
+// Host files to mmap into the address space. See memory_device_mmap.
+std::vector<std::string> mmap_args;
+
+// Memory agent stall / latency settings. Each top uses those that apply.
+dut_agent_cfg_t agent_cfg;
+
+// Skip idle cycles spent asleep in WFI waiting for the timer.
+bool        wfi_fast_forward    = true;
+
+// Hang watchdog limits, in clock cycles. 0 disables a check. -1 keeps the
+// default. See tb_watchdog.hpp
+int64_t     wdog_idle           = -1;
+int64_t     wdog_loop           = -1;
+int64_t     wdog_stall          = -1;
+
+// Konata pipeline trace, and the cycles to trace. See tb_pipeview.hpp
+std::string pipeview_path       = "";
+uint64_t    pipeview_start      = 0;
+uint64_t    pipeview_end        = -1;
+
+// Only dump waves / the pipeline view inside regions of interest. See
+// tb_roi.hpp
+bool        roi_waves           = false;
+bool        roi_trace           = false;
+
+// Instruction stream fuzzing. See fuzzer.hpp
+uint64_t    fuzz_iterations     = 0;
+uint32_t    fuzz_seed           = 1;
+size_t      fuzz_max_len        = 0;
+std::string fuzz_out_dir        = "";
+std::string fuzz_replay_path    = "";
+
+/*
+@brief Responsible for parsing all of the command line arguments.
+*/
+void process_arguments(int argc, char ** argv) {
+
+    for(int i =0; i < argc; i ++) {
+        std::string s (argv[i]);
+
+        if(s.find("+IMEM=") != std::string::npos) {
+            // Extract the file path.
+            srec_paths.push_back(s.substr(6));
+        }
+        else if(s.find("+WAVES=") != std::string::npos) {
+            std::string fpath = s.substr(7);
+            vcd_wavefile_path = fpath;
+            if(vcd_wavefile_path != "") {
+                dump_waves        = true;
+                if(!quiet){
+                std::cout << ">> Dumping waves to: " << vcd_wavefile_path
+                          << std::endl;
+                }
+            }
+        }
+        else if(s.find("+TIMEOUT=") != std::string::npos) {
+            std::string time = s.substr(9);
+            max_sim_time= std::stoul(time) * 10;
+            if(!quiet) {
+            std::cout << ">> Timeout after " << time <<" cycles."<<std::endl;
+            }
+        }
+        else if(s.find("+IMEM_MAX_STALL=") != std::string::npos) {
+            agent_cfg.imem_max_stall = std::stoul(s.substr(16));
+        }
+        else if(s.find("+DMEM_MAX_STALL=") != std::string::npos) {
+            agent_cfg.dmem_max_stall = std::stoul(s.substr(16));
+        }
+        else if(s.find("+MEM_MAX_STALL=") != std::string::npos) {
+            agent_cfg.mem_max_stall  = std::stoul(s.substr(15));
+        }
+        else if(s.find("+AXI_RD_LATENCY=") != std::string::npos) {
+            agent_cfg.axi_rd_latency = std::stoul(s.substr(16));
+        }
+        else if(s.find("+AXI_WR_LATENCY=") != std::string::npos) {
+            agent_cfg.axi_wr_latency = std::stoul(s.substr(16));
+        }
+        else if(s.find("+AXI_BEAT_INTERVAL=") != std::string::npos) {
+            agent_cfg.axi_beat_interval = std::stoul(s.substr(19));
+        }
+        else if(s.find("+PASS_ADDR=") != std::string::npos) {
+            std::string addr = s.substr(11);
+            TB_PASS_ADDRESS = std::stoul(addr,NULL,0) & 0xFFFFFFFF;
+            if(!quiet){
+            std::cout << ">> Pass Address: 0x" << std::hex << TB_PASS_ADDRESS
+                      << std::endl;
+            }
+        }
+        else if(s.find("+FAIL_ADDR=") != std::string::npos) {
+            std::string addr = s.substr(11);
+            TB_FAIL_ADDRESS = std::stoul(addr,NULL,0) & 0xFFFFFFFF;
+            if(!quiet){
+            std::cout << ">> Fail Address: 0x" << std::hex << TB_FAIL_ADDRESS
+                      << std::endl;
+            }
+        }
+        else if(s.find("+SIG_START=") != std::string::npos) {
+            std::string addr = s.substr(11);
+            SIG_START= std::stoul(addr,NULL,0) ;
+            if(!quiet){
+            std::cout << ">> Signature Start: 0x" << std::hex << SIG_START
+                      << std::endl;
+            }
+        }
+        else if(s.find("+SIG_END=") != std::string::npos) {
+            std::string addr = s.substr(9);
+            SIG_END = std::stoul(addr,NULL,0) ;
+            if(!quiet){
+            std::cout << ">> Signature End: 0x" << std::hex << SIG_END
+                      << std::endl;
+            }
+        }
+        else if(s.find("+REG_ADDR=") != std::string::npos) {
+            std::string addr = s.substr(10);
+            REG_ADDR = std::stoul(addr,NULL,0) ;
+            if(!quiet){
+            std::cout << ">> Regstate Address: 0x" << std::hex << REG_ADDR
+                      << std::endl;
+            }
+        }
+        else if(s.find("+SIG_PATH=") != std::string::npos) {
+            std::string fpath = s.substr(10);
+            sig_dump_path = fpath;
+            if(sig_dump_path != "") {
+                dump_signature = true;
+                if(!quiet){
+                std::cout << ">> Dumping signature to: " << sig_dump_path
+                          << std::endl;
+                }
+            }
+        }
+        else if(s.find("+SIG_VERIF=") != std::string::npos) {
+            std::string fpath = s.substr(11);
+            sig_verif_path = fpath;
+            if(sig_verif_path != "") {
+                verif_signature = true;
+                if(!quiet){
+                std::cout << ">> Verify against signature: " << sig_verif_path
+                          << std::endl;
+                }
+            }
+        }
+        else if(s == "+NO_WFI_SKIP") {
+            wfi_fast_forward = false;
+        }
+        else if(s.find("+WDOG_IDLE=") != std::string::npos) {
+            wdog_idle  = std::stoul(s.substr(11));
+        }
+        else if(s.find("+WDOG_LOOP=") != std::string::npos) {
+            wdog_loop  = std::stoul(s.substr(11));
+        }
+        else if(s.find("+WDOG_STALL=") != std::string::npos) {
+            wdog_stall = std::stoul(s.substr(12));
+        }
+        else if(s.find("+PIPEVIEW=") != std::string::npos) {
+            pipeview_path  = s.substr(10);
+        }
+        else if(s.find("+PIPEVIEW_START=") != std::string::npos) {
+            pipeview_start = std::stoul(s.substr(16));
+        }
+        else if(s.find("+PIPEVIEW_END=") != std::string::npos) {
+            pipeview_end   = std::stoul(s.substr(14));
+        }
+        else if(s == "+ROI_WAVES") {
+            roi_waves = true;
+        }
+        else if(s == "+ROI_TRACE") {
+            roi_trace = true;
+        }
+        else if(s.find("+MMAP=") != std::string::npos) {
+            mmap_args.push_back(s.substr(6));
+        }
+        else if(s.find("+FUZZ=") != std::string::npos) {
+            fuzz_iterations = std::stoul(s.substr(6));
+        }
+        else if(s.find("+FUZZ_SEED=") != std::string::npos) {
+            fuzz_seed = std::stoul(s.substr(11),NULL,0);
+        }
+        else if(s.find("+FUZZ_LEN=") != std::string::npos) {
+            fuzz_max_len = std::stoul(s.substr(10),NULL,0);
+        }
+        else if(s.find("+FUZZ_OUT=") != std::string::npos) {
+            fuzz_out_dir = s.substr(10);
+        }
+        else if(s.find("+FUZZ_REPLAY=") != std::string::npos) {
+            fuzz_replay_path = s.substr(13);
+        }
+        else if(s == "+q") {
+            quiet = true;
+        }
+        else if(s == "--help" || s == "-h") {
+            std::cout << argv[0] << " [arguments]" << std::endl
+            << "\t+q                            -" << std::endl
+            << "\t+IMEM=<srec input file path>  - May be repeated." << std::endl
+            << "\t+WAVES=<VCD dump file path>   -" << std::endl
+            << "\t+TIMEOUT=<timeout after N>    -" << std::endl
+            << "\t+PASS_ADDR=<hex number>       -" << std::endl
+            << "\t+FAIL_ADDR=<hex number>       -" << std::endl
+            << "\t+IMEM_MAX_STALL=<cycles>      - core_top only." << std::endl
+            << "\t+DMEM_MAX_STALL=<cycles>      - core_top only." << std::endl
+            << "\t+MEM_MAX_STALL=<cycles>       - ccx_top only." << std::endl
+            << "\t+AXI_RD_LATENCY=<cycles>      - ccx_top_axi4 only."<<std::endl
+            << "\t+AXI_WR_LATENCY=<cycles>      - ccx_top_axi4 only."<<std::endl
+            << "\t+AXI_BEAT_INTERVAL=<cycles>   - ccx_top_axi4 only."<<std::endl
+            << "\t+SIG_START=<hex number>       -" << std::endl
+            << "\t+SIG_END=<hex number>         -" << std::endl
+            << "\t+REG_ADDR=<hex number>        -" << std::endl
+            << "\t+SIG_PATH=<filepath>          -" << std::endl
+            << "\t+SIG_VERIF=<filepath>         -" << std::endl
+            << "\t+NO_WFI_SKIP                  -" << std::endl
+            << "\t+WDOG_IDLE=<cycles>           - 0 disables." << std::endl
+            << "\t+WDOG_LOOP=<cycles>           - 0 disables." << std::endl
+            << "\t+WDOG_STALL=<cycles>          - 0 disables." << std::endl
+            << "\t+PIPEVIEW=<Konata log path>   -" << std::endl
+            << "\t+PIPEVIEW_START=<cycle>       -" << std::endl
+            << "\t+PIPEVIEW_END=<cycle>         -" << std::endl
+            << "\t+ROI_WAVES                    -" << std::endl
+            << "\t+ROI_TRACE                    -" << std::endl
+            << "\t+MMAP=<base>,<file>[,ro|cow|wt[,<size>]] -" << std::endl
+#ifdef TB_FUZZER
+            << "\t+FUZZ=<iterations>            -" << std::endl
+            << "\t+FUZZ_SEED=<number>           -" << std::endl
+            << "\t+FUZZ_LEN=<max input bytes>   -" << std::endl
+            << "\t+FUZZ_OUT=<directory>         -" << std::endl
+            << "\t+FUZZ_REPLAY=<input file>     -" << std::endl
+#endif
+            ;
+            exit(0);
+        }
+    }
+}
+
+
+void load_srec_file (
+    memory_bus * mem,
+    std::string  srec_path
+) {
+    std::cout <<">> Loading srec: " << srec_path << std::endl;
+
+    srec::srec_file fh(srec_path);
+
+    for(auto it  = fh.data.begin();
+             it != fh.data.end();
+             it ++) {
+        mem -> write_byte(it -> first, it -> second);
+    }
+}
+
+//! Write out the memory signature, read straight from the testbench memory.
+void dump_signature_file (
+    memory_bus *mem
+) {
+    FILE * fh = fopen(sig_dump_path.c_str(),"w");
+
+    if(fh == NULL) {
+        std::cerr << ">> Cannot write signature to " << sig_dump_path
+                  << std::endl;
+        return;
+    }
+
+    for(uint32_t i = SIG_START; i < SIG_END; i+=4) {
+        fprintf(fh,"%02x", mem -> read_byte(i+3));
+        fprintf(fh,"%02x", mem -> read_byte(i+2));
+        fprintf(fh,"%02x", mem -> read_byte(i+1));
+        fprintf(fh,"%02x", mem -> read_byte(i+0));
+        fprintf(fh,"\n");
+    }
+
+    fclose(fh);
+}
+
+int a2h(char c)
+{
+    int num = (int) c;
+    if(num < 58 && num > 47){
+        return num - 48;
+    }
+    if(num < 103 && num > 96){
+        return num - 87;
+    }
+    return num;
+}
+
+//! Verify the in-memory signature against the supplied file
+bool verif_signature_file (
+    memory_bus *mem
+) {
+    std::cout << ">> Checking signature..." << std::endl;
+
+    FILE * fh = fopen(sig_verif_path.c_str(),"r");
+
+    bool result = true;
+
+    std::cout<<">> Address  Reference    Dut"<<std::endl;
+
+    for(uint32_t i = SIG_START; i < SIG_END; i+=4) {
+
+        uint8_t dut[4];
+        dut[3] = mem -> read_byte(i+3);
+        dut[2] = mem -> read_byte(i+2);
+        dut[1] = mem -> read_byte(i+1);
+        dut[0] = mem -> read_byte(i+0);
+
+        uint8_t sig[4];
+        sig[3] = (a2h(getc(fh)) << 4) | a2h(getc(fh)) ;
+        sig[2] = (a2h(getc(fh)) << 4) | a2h(getc(fh)) ;
+        sig[1] = (a2h(getc(fh)) << 4) | a2h(getc(fh)) ;
+        sig[0] = (a2h(getc(fh)) << 4) | a2h(getc(fh)) ;
+                 getc(fh); // Read to newline
+
+        printf(">> %08X ", i);
+        printf("%02X %02X %02X %02X, ", sig[3],sig[2],sig[1],sig[0]);
+        printf("%02X %02X %02X %02X\n", dut[3],dut[2],dut[1],dut[0]);
+        fflush(stdout);
+
+        for(int j = 0; j < 4; j++) {
+            if(dut[j] != sig[j]) {
+                std::cout << ">> Signature mismatch" <<std::endl;
+                result = false;
+            }
+        }
+
+    }
+
+    fclose(fh);
+
+    if(result) {
+        std::cout << ">> Signature check passed." << std::endl;
+    }
+
+    return result;
+}
+
+/*
+@brief Top level simulation function.
+*/
+int main(int argc, char** argv) {
+
+    printf("> ");
+    for(int i = 0; i < argc; i ++) {
+        printf("%s ",argv[i]);
+    }
+    printf("\n");
+
+    process_arguments(argc, argv);
+
+    // Lets the model see +verilator+ arguments, e.g. the PGO profile path.
+    Verilated::commandArgs(argc, argv);
+
+#ifdef TB_FUZZER
+    // Every forked fuzz child would write to the same wave file.
+    if(fuzz_iterations > 0 && fuzz_replay_path == "" && dump_waves) {
+        std::cout << ">> Ignoring +WAVES while fuzzing. Use +FUZZ_REPLAY "
+                  << "to dump waves for one input." << std::endl;
+        dump_waves = false;
+    }
+#endif
+
+    testbench<tb_top_traits> tb (vcd_wavefile_path, dump_waves);
+
+    for(auto const & arg : mmap_args) {
+        memory_device_mmap * d = memory_device_mmap::from_arg(arg);
+        if(d == NULL || !tb.bus -> add_device(d)) {
+            std::cerr << ">> Cannot map " << arg << std::endl;
+            return 1;
+        }
+        std::cout << ">> Mapped " << arg << std::endl;
+    }
+
+    for(auto const & path : srec_paths) {
+        load_srec_file(tb.bus, path);
+    }
+
+#ifdef TB_FUZZER
+    if(fuzz_iterations > 0 || fuzz_replay_path != "") {
+        fuzzer fz(&tb, fuzz_seed);
+        if(fuzz_max_len > 0) {
+            fz.max_input_len = fuzz_max_len;
+        }
+        if(fuzz_out_dir != "") {
+            fz.out_dir = fuzz_out_dir;
+        }
+        if(fuzz_replay_path != "") {
+            int rc = fz.replay(fuzz_replay_path);
+            if(dump_waves) {
+                tb.dut -> trace_fh -> close();
+            }
+            return rc;
+        }
+        return fz.run(fuzz_iterations);
+    }
+#endif
+
+    tb.pass_address = TB_PASS_ADDRESS;
+    tb.fail_address = TB_FAIL_ADDRESS;
+    tb.max_sim_time = max_sim_time;
+
+    tb.dut -> agents -> configure(agent_cfg);
+
+    tb.dut -> wfi_fast_forward = wfi_fast_forward;
+
+    if(wdog_idle  >= 0) {tb.wdog.idle_limit  = wdog_idle ;}
+    if(wdog_loop  >= 0) {tb.wdog.loop_limit  = wdog_loop ;}
+    if(wdog_stall >= 0) {tb.wdog.stall_limit = wdog_stall;}
+
+    tb.roi_waves = roi_waves;
+    tb.roi_trace = roi_trace;
+
+    tb_pipeview * pipeview = NULL;
+
+    if(pipeview_path != "") {
+        pipeview = new tb_pipeview(pipeview_path);
+        if(!pipeview -> is_open()) {
+            std::cerr << ">> Cannot write pipeline view to " << pipeview_path
+                      << std::endl;
+            return 1;
+        }
+        pipeview -> start_cycle = pipeview_start;
+        pipeview -> end_cycle   = pipeview_end;
+        tb.dut -> pipeview      = pipeview;
+        std::cout << ">> Writing pipeline view to: " << pipeview_path
+                  << std::endl;
+    }
+
+    auto t_start = std::chrono::steady_clock::now();
+
+    tb.run_simulation();
+
+    double secs = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - t_start
+    ).count();
+
+    if(pipeview != NULL) {
+        pipeview -> finish(tb.get_sim_time() / tb.dut -> ticks_per_cycle());
+        tb.dut -> pipeview = NULL;
+        delete pipeview;
+    }
+
+    std::cout << ">> Finished after "
+              << std::dec<<tb.get_sim_time()/10
+              << " simulated clock cycles" << std::endl;
+
+    // Each dut_step_clk is half a clock period. Rates use full cycles.
+    uint64_t cycles  = tb.get_sim_time() / tb.dut -> ticks_per_cycle();
+
+    if(secs > 0) {
+        std::cout << ">> Simulation speed: " << (uint64_t)(cycles / secs)
+                  << " cycles/s" << std::endl;
+    }
+
+    uint64_t retired = tb.dut -> instrs_retired;
+
+    std::cout << ">> Retired " << retired << " instructions";
+    if(retired > 0) {
+        std::cout << ", CPI " << std::fixed << std::setprecision(3)
+                  << (double)cycles / (double)retired;
+    }
+    std::cout << std::endl;
+
+    if(tb.dut -> wfi_cycles_skipped > 0) {
+        std::cout << ">> Skipped " << tb.dut -> wfi_cycles_skipped
+                  << " idle WFI cycles" << std::endl;
+    }
+
+    tb.dut -> agents -> print_stats(std::cout);
+
+    tb.dut -> cpi.print(std::cout, "run");
+
+    if(!tb.roi.empty()) {
+        tb.roi.print(std::cout);
+    }
+
+    tb.dut -> print_clock_activity(std::cout);
+
+    if(dump_signature) {
+        dump_signature_file(tb.bus);
+    }
+
+    bool verif_result = true;
+
+    if(verif_signature) {
+        verif_result = verif_signature_file(tb.bus);
+        tb.sim_passed &= verif_result;
+    }
+
+    if(tb.sim_hung) {
+
+        std::cout << ">> HANG" << std::endl;
+        return 4;
+
+    } else if(tb.get_sim_time() >= max_sim_time) {
+
+        std::cout << ">> TIMEOUT" << std::endl;
+        return 1;
+
+    } else if(tb.sim_passed) {
+
+        std::cout << ">> SIM PASS" << std::endl;
+        return 0;
+
+    } else if(!verif_result) {
+
+        std::cout << ">> SIG FAIL" << std::endl;
+        return 3;
+
+    } else {
+
+        std::cout << ">> SIM FAIL" << std::endl;
+        return 2;
+
+    }
+
+}
@@ -1,6 +1,15 @@
 
+#include <memory>
+
 #include "memory_bus.hpp"
     
+
+memory_bus::~memory_bus () {
+    for(auto const &it : this -> devices) {
+        delete it;
+    }
+}
+
 /*!
 @brief Connect a new device to the bus.
 @returns True if the device was added successfully, or False if
@@ -107,3 +116,51 @@ memory_rsp_txn * memory_bus::request (
     return rsp;
 
 }
+
+
+//! Is the range wholly inside one device?
+bool memory_bus::range_mapped (
+    memory_address addr,
+    size_t         size
+) {
+    memory_device * device = this -> get_device_at(addr);
+
+    return device != NULL && size <= device -> get_top() - addr;
+}
+
+
+//! Read a range of bytes from the bus in one go.
+bool memory_bus::read_range (
+    memory_address addr,
+    size_t         size,
+    uint8_t      * rdata
+) {
+    memory_device * device = this -> get_device_at(addr);
+
+    if(device == NULL || !device -> in_range(addr, size)) {
+        return false;
+    }
+
+    return device -> read_range(addr, size, rdata);
+}
+
+
+//! Write a range of bytes to the bus in one go.
+bool memory_bus::write_range (
+    memory_address addr,
+    size_t         size,
+    uint8_t      * wdata
+) {
+    memory_device * device = this -> get_device_at(addr);
+
+    if(device == NULL || !device -> in_range(addr, size)) {
+        return false;
+    }
+
+    std::unique_ptr<bool[]> s(new bool[size]);
+    for(size_t i = 0; i < size; i ++) {
+        s[i] = true;
+    }
+
+    return device -> write_range(addr, size, wdata, s.get());
+}
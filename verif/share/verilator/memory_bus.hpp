@@ -22,6 +22,9 @@ public:
         
     }
 
+    //! Delete every device on the bus. The bus owns its devices.
+    ~memory_bus ();
+
     /*
         this -> bus,
         this -> dump_waves,
@@ -86,6 +89,35 @@ public:
 
     };
 
+    /*!
+    @brief Is the range wholly inside one device? Safe for any size, so
+        target supplied lengths can be checked before they are used.
+    */
+    bool range_mapped (
+        memory_address addr,
+        size_t         size
+    );
+
+    /*!
+    @brief Read a range of bytes from the bus in one go.
+    @returns false if the range is not wholly inside one device.
+    */
+    bool read_range (
+        memory_address addr,
+        size_t         size,
+        uint8_t      * rdata
+    );
+
+    /*!
+    @brief Write a range of bytes to the bus in one go.
+    @returns false if the range is not wholly inside one device.
+    */
+    bool write_range (
+        memory_address addr,
+        size_t         size,
+        uint8_t      * wdata
+    );
+
 protected:
     
     //! The list of devices connected to the bus.
@@ -18,7 +18,7 @@ public:
         size_t         range
     );
 
-    ~memory_device();
+    virtual ~memory_device();
 
     memory_address get_base (){return this -> addr_base ;}
     size_t         get_range(){return this -> addr_range;}
@@ -85,7 +85,7 @@ public:
     /*!
     @brief Read a range of bytes from the device
     */
-    bool    read_range (
+    virtual bool read_range (
         memory_address addr,
         size_t         size,
         uint8_t      * rdata
@@ -106,7 +106,7 @@ public:
     /*!
     @brief Write a range of bytes from the device
     */
-    bool    write_range (
+    virtual bool write_range (
         memory_address addr,
         size_t         size,
         uint8_t      * wdata,
@@ -0,0 +1,292 @@
+
+#include <cerrno>
+#include <cstring>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "memory_device_htif.hpp"
+
+// Syscall numbers, as used by the RISC-V proxy kernel.
+#define HTIF_SYS_OPENAT     56
+#define HTIF_SYS_CLOSE      57
+#define HTIF_SYS_LSEEK      62
+#define HTIF_SYS_READ       63
+#define HTIF_SYS_WRITE      64
+#define HTIF_SYS_EXIT       93
+#define HTIF_SYS_OPEN     1024
+
+// Target open() flags. These are the RISC-V Linux values.
+#define HTIF_O_ACCMODE  0x003
+#define HTIF_O_CREAT    0x040
+#define HTIF_O_EXCL     0x080
+#define HTIF_O_TRUNC    0x200
+#define HTIF_O_APPEND   0x400
+
+// Longest path name accepted from the target.
+#define HTIF_PATH_MAX   4096
+
+
+memory_device_htif::~memory_device_htif() {
+    for(auto const & it : this -> fds) {
+        close(it.second);
+    }
+}
+
+
+//! Forget any exit request, and close every file the target opened.
+void memory_device_htif::reset() {
+    for(auto const & it : this -> fds) {
+        close(it.second);
+    }
+    this -> fds.clear();
+    this -> next_fd        = 3;
+    this -> exit_requested = false;
+    this -> exit_value     = 0;
+    memset(this -> regs, 0, sizeof(this -> regs));
+}
+
+
+/*!
+*/
+bool memory_device_htif::read_word (
+    memory_address addr,
+    uint32_t     * dout
+){
+    if(!this -> in_range(addr, 4)) {
+        return false;
+    }
+    memcpy(dout, this -> regs + (addr - this -> addr_base), 4);
+    return true;
+}
+
+
+/*!
+*/
+bool memory_device_htif::write_byte (
+    memory_address addr,
+    uint8_t        data
+){
+    if(!this -> in_range(addr)) {
+        return false;
+    }
+    this -> regs[addr - this -> addr_base] = data;
+    return true;
+}
+
+
+/*!
+@brief Return a single byte from the device.
+*/
+uint8_t memory_device_htif::read_byte (
+    memory_address addr
+){
+    return this -> regs[addr - this -> addr_base];
+}
+
+
+/*!
+*/
+bool memory_device_htif::write_range (
+    memory_address addr,
+    size_t         size,
+    uint8_t      * wdata,
+    bool         * strb
+) {
+    if(!memory_device::write_range(addr, size, wdata, strb)) {
+        return false;
+    }
+
+    bool touched_tohost = addr       < this -> addr_tohost + 8 &&
+                          addr + size > this -> addr_tohost;
+
+    uint64_t tohost = this -> get_reg(this -> addr_tohost);
+
+    if(touched_tohost && tohost != 0) {
+        this -> handle_tohost(tohost);
+    }
+
+    return true;
+}
+
+
+uint64_t memory_device_htif::get_reg(memory_address addr) {
+    uint64_t v;
+    memcpy(&v, this -> regs + (addr - this -> addr_base), 8);
+    return v;
+}
+
+
+void memory_device_htif::set_reg(memory_address addr, uint64_t value) {
+    memcpy(this -> regs + (addr - this -> addr_base), &value, 8);
+}
+
+
+//! Handle a non-zero write to TOHOST.
+void memory_device_htif::handle_tohost(uint64_t value) {
+
+    if(value & 0x1) {
+        this -> exit_requested = true;
+        this -> exit_value     = value >> 1;
+        return;
+    }
+
+    if(!this -> syscalls_enabled) {
+        uint64_t result = -ENOSYS;
+        this -> bus -> write_range(value, sizeof(result), (uint8_t*)&result);
+        this -> set_reg(this -> addr_tohost  , 0);
+        this -> set_reg(this -> addr_fromhost, 1);
+        return;
+    }
+
+    uint64_t args[8];
+
+    if(!this -> bus -> read_range(value, sizeof(args), (uint8_t*)args)) {
+        std::cerr << "HTIF: Bad syscall block address 0x" << std::hex
+                  << value << std::endl;
+        this -> exit_requested = true;
+        this -> exit_value     = -1;
+        return;
+    }
+
+    uint64_t result = this -> do_syscall(args[0], args + 1);
+
+    this -> bus -> write_range(value, sizeof(result), (uint8_t*)&result);
+
+    this -> set_reg(this -> addr_tohost  , 0);
+    this -> set_reg(this -> addr_fromhost, 1);
+}
+
+
+//! Map a target fd to a host fd, or -1.
+int memory_device_htif::host_fd(int64_t fd) {
+    if(fd >= 0 && fd <= 2) {
+        return fd;
+    }
+    auto it = this -> fds.find(fd);
+    return it == this -> fds.end() ? -1 : it -> second;
+}
+
+
+//! Read a NUL terminated string from target memory.
+bool memory_device_htif::read_string(memory_address addr, std::string & out) {
+    out.clear();
+    for(size_t i = 0; i < HTIF_PATH_MAX; i ++) {
+        uint8_t c;
+        if(!this -> bus -> read_range(addr + i, 1, &c)) {
+            return false;
+        }
+        if(c == 0) {
+            return true;
+        }
+        out.push_back(c);
+    }
+    return false;
+}
+
+
+//! Run one syscall and return its result.
+int64_t memory_device_htif::do_syscall(uint64_t n, uint64_t * a) {
+
+    switch(n) {
+
+        case HTIF_SYS_EXIT: {
+            this -> exit_requested = true;
+            this -> exit_value     = a[0];
+            return 0;
+        }
+
+        case HTIF_SYS_WRITE: {
+            int fd = this -> host_fd(a[0]);
+            if(fd < 0) {
+                return -EBADF;
+            }
+            // Check the length before trusting it with an allocation.
+            if(!this -> bus -> range_mapped(a[1], a[2])) {
+                return -EFAULT;
+            }
+            std::vector<uint8_t> buf(a[2]);
+            if(!this -> bus -> read_range(a[1], a[2], buf.data())) {
+                return -EFAULT;
+            }
+            if(fd == 1 || fd == 2) {
+                // Keep ordering with the testbench's own output.
+                std::ostream & os = fd == 1 ? std::cout : std::cerr;
+                os.write((const char*)buf.data(), buf.size());
+                return buf.size();
+            }
+            ssize_t r = write(fd, buf.data(), buf.size());
+            return r < 0 ? -errno : r;
+        }
+
+        case HTIF_SYS_READ: {
+            int fd = this -> host_fd(a[0]);
+            if(fd < 0 || fd == 1 || fd == 2) {
+                return -EBADF;
+            }
+            // Check the destination first, so no host data is lost.
+            if(!this -> bus -> range_mapped(a[1], a[2])) {
+                return -EFAULT;
+            }
+            std::vector<uint8_t> buf(a[2]);
+            ssize_t r = read(fd, buf.data(), buf.size());
+            if(r < 0) {
+                return -errno;
+            }
+            if(!this -> bus -> write_range(a[1], r, buf.data())) {
+                return -EFAULT;
+            }
+            return r;
+        }
+
+        case HTIF_SYS_OPENAT:
+        case HTIF_SYS_OPEN: {
+            // openat ignores its directory argument, and is relative to
+            // the simulator's working directory, like open.
+            uint64_t * oa = n == HTIF_SYS_OPENAT ? a + 1 : a;
+            std::string path;
+            if(!this -> read_string(oa[0], path)) {
+                return -EFAULT;
+            }
+            int flags = oa[1] & HTIF_O_ACCMODE;
+            if(oa[1] & HTIF_O_CREAT ) { flags |= O_CREAT ; }
+            if(oa[1] & HTIF_O_EXCL  ) { flags |= O_EXCL  ; }
+            if(oa[1] & HTIF_O_TRUNC ) { flags |= O_TRUNC ; }
+            if(oa[1] & HTIF_O_APPEND) { flags |= O_APPEND; }
+            int fd = open(path.c_str(), flags, (mode_t)oa[2]);
+            if(fd < 0) {
+                return -errno;
+            }
+            int64_t tfd = this -> next_fd ++;
+            this -> fds[tfd] = fd;
+            return tfd;
+        }
+
+        case HTIF_SYS_CLOSE: {
+            auto it = this -> fds.find(a[0]);
+            if(it == this -> fds.end()) {
+                return a[0] <= 2 ? 0 : -EBADF;
+            }
+            close(it -> second);
+            this -> fds.erase(it);
+            return 0;
+        }
+
+        case HTIF_SYS_LSEEK: {
+            int fd = this -> host_fd(a[0]);
+            if(fd < 3) {
+                return -ESPIPE;
+            }
+            off_t r = lseek(fd, a[1], a[2]);
+            return r < 0 ? -errno : r;
+        }
+
+        default:
+            std::cerr << "HTIF: Unsupported syscall " << std::dec << n
+                      << std::endl;
+            return -ENOSYS;
+    }
+}
@@ -0,0 +1,133 @@
+
+#include <map>
+
+#include "memory_device.hpp"
+#include "memory_bus.hpp"
+
+#ifndef MEMORY_DEVICE_HTIF_HPP
+#define MEMORY_DEVICE_HTIF_HPP
+
+#define MEMORY_DEVICE_HTIF_RANGE 0x80
+
+/*!
+@brief A tohost / fromhost host interface device, for exiting the
+    simulation and for host file I/O.
+@details:
+Register Map:
+Offset  |  Register
+--------|----------------------
+0x00    | TOHOST
+0x08    | FROMHOST
+0x40    | ARGS[0..7] - Syscall argument block.
+
+Writing TOHOST with bit 0 set ends the simulation, with exit code
+TOHOST >> 1. Writing any other non-zero value starts a syscall. The value
+is the address of an 8 double-word block {n, a0, a1, ... a6}, usually
+ARGS. When the syscall is finished, its return value is written to the
+first double-word of the block, TOHOST is cleared and FROMHOST is set
+to 1. Syscall buffers must be visible on the memory bus.
+
+Supported syscalls use the RISC-V Linux / proxy kernel numbers: openat,
+open, close, lseek, read, write and exit.
+*/
+class memory_device_htif : public memory_device {
+
+public:
+
+    memory_device_htif (
+        memory_address base,
+        memory_bus   * bus
+    ) : memory_device(base,MEMORY_DEVICE_HTIF_RANGE) {
+        this -> bus         = bus;
+        addr_tohost         = addr_base + 0x00;
+        addr_fromhost       = addr_base + 0x08;
+        addr_args           = addr_base + 0x40;
+    }
+
+    ~memory_device_htif();
+
+    /*!
+    @brief Read a word from the address given.
+    @returns true if the read succeeds. False otherwise.
+    */
+    bool read_word (
+        memory_address addr,
+        uint32_t     * dout
+    );
+
+    /*!
+    @brief Write a single byte to the device.
+    @return true if the write is in range, else false.
+    */
+    bool write_byte (
+        memory_address addr,
+        uint8_t        data
+    );
+
+    /*!
+    @brief Return a single byte from the device.
+    */
+    uint8_t read_byte (
+        memory_address addr
+    );
+
+    //! Write a range of bytes, then act on any write to TOHOST.
+    bool    write_range (
+        memory_address addr,
+        size_t         size,
+        uint8_t      * wdata,
+        bool         * strb
+    );
+
+    //! Forget any exit request, clear the registers and close every file
+    //! the target opened. For when the target is reset.
+    void     reset();
+
+    //! Has the target asked to exit?
+    bool     exited   () {return this -> exit_requested;}
+
+    //! Exit code given by the target.
+    uint64_t exit_code() {return this -> exit_value;}
+
+    //! If false, syscalls fail with -ENOSYS. Exit requests still work.
+    bool     syscalls_enabled = true;
+
+protected:
+
+    //! Bus used to reach syscall buffers in target memory.
+    memory_bus   * bus;
+
+    // Addresses of each register, calculated at instantiation.
+    memory_address addr_tohost;
+    memory_address addr_fromhost;
+    memory_address addr_args;
+
+    //! Contents of all registers.
+    uint8_t  regs[MEMORY_DEVICE_HTIF_RANGE] = {0};
+
+    bool     exit_requested = false;
+    uint64_t exit_value     = 0;
+
+    //! Target file descriptors (3 upwards) to host file descriptors.
+    std::map<int64_t, int> fds;
+    int64_t  next_fd        = 3;
+
+    //! Read / write a little endian double-word register.
+    uint64_t get_reg(memory_address addr);
+    void     set_reg(memory_address addr, uint64_t value);
+
+    //! Handle a non-zero write to TOHOST.
+    void     handle_tohost(uint64_t value);
+
+    //! Run one syscall and return its result.
+    int64_t  do_syscall(uint64_t n, uint64_t * a);
+
+    //! Map a target fd to a host fd, or -1.
+    int      host_fd(int64_t fd);
+
+    //! Read a NUL terminated string from target memory.
+    bool     read_string(memory_address addr, std::string & out);
+
+};
+
+#endif
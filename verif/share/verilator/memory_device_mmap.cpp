@@ -0,0 +1,240 @@
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <sstream>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "memory_device_mmap.hpp"
+
+//! Return the size of a host file in bytes, or 0 if it cannot be read.
+static size_t host_file_size (
+    std::string path
+) {
+    struct stat st;
+    if(stat(path.c_str(), &st) != 0) {
+        return 0;
+    }
+    return st.st_size;
+}
+
+
+//! Parse a decimal, hex or octal number into out.
+//! @returns false unless the whole of s is a number which fits.
+static bool parse_number (
+    std::string const & s  ,
+    uint64_t          & out
+) {
+    if(s.empty() || s[0] == '-' || s[0] == '+' || isspace((unsigned char)s[0])) {
+        return false;
+    }
+    char * end = NULL;
+    errno = 0;
+    unsigned long long v = strtoull(s.c_str(), &end, 0);
+    if(errno != 0 || *end != '\0') {
+        return false;
+    }
+    out = v;
+    return true;
+}
+
+
+/*!
+*/
+memory_device_mmap::memory_device_mmap (
+    memory_address base ,
+    std::string    path ,
+    mmap_mode_t    mode ,
+    size_t         range
+) : memory_device(base, range ? range : host_file_size(path)) {
+
+    this -> mode = mode;
+    this -> path = path;
+
+    if(this -> addr_range == 0) {
+        std::cerr << "Cannot map empty or missing file: " << path
+                  << std::endl;
+        return;
+    }
+
+    int fd = open(path.c_str(), mode == MMAP_WT ? O_RDWR : O_RDONLY);
+
+    if(fd < 0) {
+        std::cerr << "Cannot open " << path << ": " << strerror(errno)
+                  << std::endl;
+        return;
+    }
+
+    int    prot  = mode == MMAP_RO ? PROT_READ : PROT_READ | PROT_WRITE;
+    size_t flen  = std::min((size_t)this -> addr_range,host_file_size(path));
+
+    // Reserve the whole window as zeros, then map the file over the
+    // start of it. Accesses past the end of the file then read as zero
+    // rather than faulting.
+    void * win   = mmap(NULL, this -> addr_range, prot,
+                        MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+
+    if(win != MAP_FAILED && flen > 0) {
+        int  flags = (mode == MMAP_WT ? MAP_SHARED : MAP_PRIVATE) | MAP_FIXED;
+        if(mmap(win, flen, prot, flags, fd, 0) == MAP_FAILED) {
+            munmap(win, this -> addr_range);
+            win = MAP_FAILED;
+        }
+    }
+
+    close(fd);
+
+    if(win == MAP_FAILED) {
+        std::cerr << "Cannot mmap " << path << ": " << strerror(errno)
+                  << std::endl;
+        return;
+    }
+
+    this -> data = (uint8_t*)win;
+
+}
+
+
+memory_device_mmap::~memory_device_mmap() {
+    if(this -> data != NULL) {
+        munmap(this -> data, this -> addr_range);
+    }
+}
+
+
+/*!
+*/
+memory_device_mmap * memory_device_mmap::from_arg (
+    std::string arg
+) {
+    std::vector<std::string> fields;
+    std::stringstream        ss(arg);
+    std::string              f;
+
+    while(std::getline(ss, f, ',')) {
+        fields.push_back(f);
+    }
+
+    if(fields.size() < 2 || fields.size() > 4) {
+        std::cerr << "Bad mmap argument: " << arg << std::endl;
+        return NULL;
+    }
+
+    mmap_mode_t mode  = MMAP_COW;
+    uint64_t    base  = 0;
+    uint64_t    range = 0;
+
+    if(!parse_number(fields[0], base)) {
+        std::cerr << "Bad mmap base: " << fields[0] << std::endl;
+        return NULL;
+    }
+
+    if(fields.size() > 2) {
+        if     (fields[2] == "ro" ) { mode = MMAP_RO ; }
+        else if(fields[2] == "cow") { mode = MMAP_COW; }
+        else if(fields[2] == "wt" ) { mode = MMAP_WT ; }
+        else {
+            std::cerr << "Bad mmap mode: " << fields[2] << std::endl;
+            return NULL;
+        }
+    }
+
+    if(fields.size() > 3 && !parse_number(fields[3], range)) {
+        std::cerr << "Bad mmap size: " << fields[3] << std::endl;
+        return NULL;
+    }
+
+    memory_device_mmap * d = new memory_device_mmap(
+        base, fields[1], mode, range
+    );
+
+    if(!d -> is_mapped()) {
+        delete d;
+        return NULL;
+    }
+
+    return d;
+}
+
+
+/*!
+*/
+bool memory_device_mmap::read_word (
+    memory_address addr,
+    uint32_t     * dout
+){
+    if(this -> in_range(addr, 4)) {
+        memcpy(dout, this -> data + (addr - this -> addr_base), 4);
+        return true;
+    } else {
+        return false;
+    }
+}
+
+
+/*!
+@brief Return a single byte from the device.
+*/
+uint8_t memory_device_mmap::read_byte (
+    memory_address addr
+) {
+    return this -> data[addr - this -> addr_base];
+}
+
+
+/*!
+*/
+bool memory_device_mmap::write_byte (
+    memory_address addr,
+    uint8_t        data
+){
+    if(this -> mode != MMAP_RO && this -> in_range(addr)) {
+        this -> data[addr - this -> addr_base] = data;
+        return true;
+    } else {
+        return false;
+    }
+}
+
+
+/*!
+*/
+bool memory_device_mmap::read_range (
+    memory_address addr,
+    size_t         size,
+    uint8_t      * rdata
+) {
+    if(!this -> in_range(addr, size)) {
+        return false;
+    }
+    memcpy(rdata, this -> data + (addr - this -> addr_base), size);
+    return true;
+}
+
+
+/*!
+*/
+bool memory_device_mmap::write_range (
+    memory_address addr,
+    size_t         size,
+    uint8_t      * wdata,
+    bool         * strb
+) {
+    if(this -> mode == MMAP_RO || !this -> in_range(addr, size)) {
+        return false;
+    }
+    uint8_t * p = this -> data + (addr - this -> addr_base);
+    for(size_t i = 0; i < size; i ++) {
+        if(strb[i]) {
+            p[i] = wdata[i];
+        }
+    }
+    return true;
+}
@@ -0,0 +1,108 @@
+
+#include <string>
+
+#include "memory_device.hpp"
+
+#ifndef MEMORY_DEVICE_MMAP_HPP
+#define MEMORY_DEVICE_MMAP_HPP
+
+/*!
+@brief A memory device backed by a host file, mapped with mmap.
+@details The file appears in the address window instantly, without being
+    parsed or copied. Bytes of the window past the end of the file read
+    as zero.
+*/
+class memory_device_mmap : public memory_device {
+
+public:
+
+    //! How writes to the device are handled.
+    typedef enum mmap_mode {
+        MMAP_RO  = 0, //!< Read-only. Writes return an error.
+        MMAP_COW = 1, //!< Copy-on-write. Writes are private to the sim.
+        MMAP_WT  = 2  //!< Write-through. Writes update the host file.
+    } mmap_mode_t;
+
+    /*!
+    @brief Map a host file into the address window starting at base.
+    @param in base  - Base address of the window.
+    @param in path  - Host file to map.
+    @param in mode  - How writes are handled.
+    @param in range - Size of the window. 0 means the size of the file.
+    @details Check is_mapped() afterwards to see if the map succeeded.
+    */
+    memory_device_mmap (
+        memory_address base ,
+        std::string    path ,
+        mmap_mode_t    mode ,
+        size_t         range = 0
+    );
+
+    ~memory_device_mmap();
+
+    /*!
+    @brief Create a device from a "<base>,<path>[,ro|cow|wt[,<size>]]"
+        command line argument. Defaults to copy-on-write.
+    @returns The new device, or NULL if the argument or map is bad.
+    */
+    static memory_device_mmap * from_arg (
+        std::string arg
+    );
+
+    //! Did the file get mapped successfully?
+    bool is_mapped() {return this -> data != NULL;}
+
+    /*!
+    @brief Read a word from the address given.
+    @returns true if the read succeeds. False otherwise.
+    */
+    bool read_word (
+        memory_address addr,
+        uint32_t     * dout
+    );
+
+    /*!
+    @brief Write a single byte to the device.
+    @return true if the write is in range and the device is writable.
+    */
+    bool write_byte (
+        memory_address addr,
+        uint8_t        data
+    );
+
+    /*!
+    @brief Return a single byte from the device.
+    */
+    uint8_t read_byte (
+        memory_address addr
+    );
+
+    //! Read a range of bytes straight from the mapping.
+    bool    read_range (
+        memory_address addr,
+        size_t         size,
+        uint8_t      * rdata
+    );
+
+    //! Write a range of bytes straight into the mapping.
+    bool    write_range (
+        memory_address addr,
+        size_t         size,
+        uint8_t      * wdata,
+        bool         * strb
+    );
+
+protected:
+
+    //! Start of the mapped window in host memory.
+    uint8_t   * data      = NULL;
+
+    //! Write handling mode.
+    mmap_mode_t mode;
+
+    //! Host file path, for messages.
+    std::string path;
+
+};
+
+#endif
@@ -1,6 +1,48 @@
 
+#include <algorithm>
+#include <cstring>
+
 #include "memory_device_ram.hpp"
 
+#define PAGE_OFFSET(A) ((A) & (MEMORY_DEVICE_RAM_PAGE_SIZE - 1))
+
+memory_device_ram::~memory_device_ram() {
+    for(auto const & it : this -> pages) {
+        delete [] it.second;
+    }
+}
+
+
+/*!
+*/
+uint8_t * memory_device_ram::get_page (
+    memory_address addr,
+    bool           create
+) {
+    memory_address num = addr >> MEMORY_DEVICE_RAM_PAGE_BITS;
+
+    if(num == this -> last_page_num) {
+        return this -> last_page;
+    }
+
+    auto it = this -> pages.find(num);
+
+    if(it != this -> pages.end()) {
+        this -> last_page_num = num;
+        this -> last_page     = it -> second;
+        return it -> second;
+    } else if(!create) {
+        return NULL;
+    }
+
+    uint8_t * page = new uint8_t[MEMORY_DEVICE_RAM_PAGE_SIZE]();
+    this -> pages[num]    = page;
+    this -> last_page_num = num;
+    this -> last_page     = page;
+    return page;
+}
+
+
 /*!
 */
 bool memory_device_ram::read_word (
@@ -11,10 +53,10 @@ bool memory_device_ram::read_word (
     if(this -> in_range(addr, 3)) {
         
         *dout = 
-            (uint32_t)this -> memory[addr+3] << 24 |
-            (uint32_t)this -> memory[addr+2] << 16 |
-            (uint32_t)this -> memory[addr+1] <<  8 |
-            (uint32_t)this -> memory[addr+0] <<  0 ;
+            (uint32_t)this -> read_byte(addr+3) << 24 |
+            (uint32_t)this -> read_byte(addr+2) << 16 |
+            (uint32_t)this -> read_byte(addr+1) <<  8 |
+            (uint32_t)this -> read_byte(addr+0) <<  0 ;
 
         return true;
 
@@ -31,7 +73,8 @@ bool memory_device_ram::read_word (
 uint8_t memory_device_ram::read_byte (
     memory_address addr
 ) {
-    return memory[addr];
+    uint8_t * page = this -> get_page(addr, false);
+    return page == NULL ? 0 : page[PAGE_OFFSET(addr)];
 }
 
 /*!
@@ -42,7 +85,7 @@ bool memory_device_ram::write_byte (
 ){
     if(this -> in_range(addr, 0)) {
         
-        this -> memory[addr] = data;
+        this -> get_page(addr, true)[PAGE_OFFSET(addr)] = data;
 
         return true;
 
@@ -50,3 +93,67 @@ bool memory_device_ram::write_byte (
         return false;
     }
 }
+
+
+/*!
+*/
+bool memory_device_ram::read_range (
+    memory_address addr,
+    size_t         size,
+    uint8_t      * rdata
+) {
+    if(!this -> in_range(addr, size)) {
+        return false;
+    }
+
+    while(size > 0) {
+        size_t    off  = PAGE_OFFSET(addr);
+        size_t    n    = std::min(size, MEMORY_DEVICE_RAM_PAGE_SIZE - off);
+        uint8_t * page = this -> get_page(addr, false);
+
+        if(page == NULL) {
+            memset(rdata, 0, n);
+        } else {
+            memcpy(rdata, page + off, n);
+        }
+
+        addr  += n;
+        rdata += n;
+        size  -= n;
+    }
+
+    return true;
+}
+
+
+/*!
+*/
+bool memory_device_ram::write_range (
+    memory_address addr,
+    size_t         size,
+    uint8_t      * wdata,
+    bool         * strb
+) {
+    if(!this -> in_range(addr, size)) {
+        return false;
+    }
+
+    while(size > 0) {
+        size_t    off  = PAGE_OFFSET(addr);
+        size_t    n    = std::min(size, MEMORY_DEVICE_RAM_PAGE_SIZE - off);
+        uint8_t * page = this -> get_page(addr, true) + off;
+
+        for(size_t i = 0; i < n; i ++) {
+            if(strb[i]) {
+                page[i] = wdata[i];
+            }
+        }
+
+        addr  += n;
+        wdata += n;
+        strb  += n;
+        size  -= n;
+    }
+
+    return true;
+}
@@ -1,9 +1,19 @@
+#include <unordered_map>
 
 #include "memory_device.hpp"
 
 #ifndef MEMORY_DEVICE_RAM_HPP
 #define MEMORY_DEVICE_RAM_HPP
 
+//! Size of each lazily allocated page of RAM storage.
+#define MEMORY_DEVICE_RAM_PAGE_BITS 12
+#define MEMORY_DEVICE_RAM_PAGE_SIZE (1 << MEMORY_DEVICE_RAM_PAGE_BITS)
+
+/*!
+@brief A sparse RAM device.
+@details Storage is allocated in pages on the first write to them.
+    Unwritten bytes read as zero.
+*/
 class memory_device_ram : public memory_device {
 
 public:
@@ -13,6 +23,8 @@ public:
         size_t         range
     ) : memory_device(base,range) {}
 
+    ~memory_device_ram();
+
     /*!
     @brief Read a word from the address given.
     @returns true if the read succeeds. False otherwise.
@@ -38,12 +50,41 @@ public:
     uint8_t read_byte (
         memory_address addr
     );
+
+    //! Read a range of bytes, a page at a time.
+    bool    read_range (
+        memory_address addr,
+        size_t         size,
+        uint8_t      * rdata
+    );
+
+    //! Write a range of bytes, a page at a time.
+    bool    write_range (
+        memory_address addr,
+        size_t         size,
+        uint8_t      * wdata,
+        bool         * strb
+    );
     
 
 protected:
 
-    //! The underlying memory.
-    std::map<memory_address, uint8_t> memory;   
+    /*!
+    @brief Return the page holding addr.
+    @param in create - Allocate the page if it does not exist yet.
+    @returns NULL if the page does not exist and create is false.
+    */
+    uint8_t * get_page (
+        memory_address addr,
+        bool           create
+    );
+
+    //! The underlying memory, indexed by page number.
+    std::unordered_map<memory_address, uint8_t*> pages;
+
+    //! The most recently used page, since accesses are mostly local.
+    memory_address last_page_num = -1;
+    uint8_t      * last_page     = NULL;
 
 };
 
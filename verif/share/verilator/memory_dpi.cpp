@@ -0,0 +1,70 @@
+
+#include <iostream>
+
+#include "memory_dpi.hpp"
+
+//! Bus which all DPI accesses go to.
+static memory_bus    * dpi_bus    = NULL;
+
+//! Device used by the last access. Nearly every access hits it again.
+static memory_device * dpi_device = NULL;
+
+
+//! Return the device covering the 8 bytes at addr, or NULL.
+static memory_device * dpi_device_at (
+    memory_address addr
+) {
+    if(dpi_device != NULL && dpi_device -> in_range(addr, 8)) {
+        return dpi_device;
+    }
+
+    dpi_device = dpi_bus == NULL ? NULL : dpi_bus -> get_device_at(addr);
+
+    if(dpi_device == NULL || !dpi_device -> in_range(addr, 8)) {
+        std::cerr << "mem_dpi: No memory at 0x" << std::hex << addr
+                  << std::endl;
+        dpi_device = NULL;
+    }
+
+    return dpi_device;
+}
+
+
+void memory_dpi_set_bus (
+    memory_bus * bus
+) {
+    dpi_bus    = bus;
+    dpi_device = NULL;
+}
+
+
+long long mem_dpi_read (
+    long long addr
+) {
+    uint64_t        data = 0;
+    memory_device * d    = dpi_device_at(addr);
+
+    if(d != NULL) {
+        d -> read_range(addr, 8, (uint8_t*)&data);
+    }
+
+    return data;
+}
+
+
+void mem_dpi_write (
+    long long addr,
+    long long data,
+    char      strb
+) {
+    memory_device * d    = dpi_device_at(addr);
+    bool            s[8];
+
+    for(int i = 0; i < 8; i ++) {
+        s[i] = (strb >> i) & 0x1;
+    }
+
+    if(d != NULL) {
+        d -> write_range(addr, 8, (uint8_t*)&data, s);
+    }
+}
@@ -0,0 +1,34 @@
+
+#include "memory_bus.hpp"
+
+#ifndef MEMORY_DPI_HPP
+#define MEMORY_DPI_HPP
+
+/*!
+@brief Route the accesses made by mem_dpi_wxd RTL instances onto a bus.
+@details mem_dpi_wxd keeps no storage of its own. Each access becomes a
+    call to mem_dpi_read / mem_dpi_write, which read and write whichever
+    memory_device on this bus covers the address. Programs can then be
+    loaded, and results read, straight through the bus.
+*/
+void memory_dpi_set_bus (
+    memory_bus * bus
+);
+
+extern "C" {
+
+//! DPI import. Read the 64-bit word at addr.
+long long mem_dpi_read (
+    long long addr
+);
+
+//! DPI import. Write the strobed bytes of data to the word at addr.
+void      mem_dpi_write (
+    long long addr,
+    long long data,
+    char      strb
+);
+
+}
+
+#endif
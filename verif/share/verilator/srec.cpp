@@ -111,7 +111,7 @@ bool srec_file::dump_readmemh(
     long unsigned base_address = 0;
     long unsigned prev_address = 0;
 
-    fh << "@" << std::hex << base_address << std::endl;
+    fh << "@" << std::hex << base_address << "\n";
     prev_address = base_address;
 
     for(auto it = this -> data.begin();
@@ -124,11 +124,11 @@ bool srec_file::dump_readmemh(
 
         if(prev_address + 1 != base_address + offset) {
             long unsigned addr_to_write = (base_address + offset) & 0xFFFF;
-            fh << "@" << std::hex << addr_to_write << std::endl;
+            fh << "@" << std::hex << addr_to_write << "\n";
         }
         prev_address = base_address + offset;
         
-        fh << std::hex << (int)data << std::endl;
+        fh << std::hex << (int)data << "\n";
 
     }
 
@@ -0,0 +1,110 @@
+
+#include <iomanip>
+
+#include "tb_cpi_stack.hpp"
+
+//! Name of category i.
+const char * tb_cpi_stack::cat_name(int i) {
+    static const char * names[CPI_NUM] = {
+        "retiring", "fetch", "flush", "lsu", "mdu", "crypto", "trap", "wfi"
+    };
+    return names[i];
+}
+
+
+/*!
+@details A stall because writeback is not ready can only be writeback
+    waiting on its own control flow change, so it counts as a trap.
+*/
+void tb_cpi_stack::sample (
+    pv_sample_t const & s,
+    bool                wfi_sleep
+) {
+
+    cpi_cat_t cat;
+
+    if(wfi_sleep) {
+        cat = CPI_WFI;
+    } else if(!s.s2_valid) {
+        cat = this -> refill;
+    } else if(s.s2_ready) {
+        cat = s.s2_flush ? CPI_TRAP : CPI_RETIRING;
+    } else {
+        switch(s.stall) {
+            case PV_STALL_LSU: cat = CPI_LSU    ; break;
+            case PV_STALL_MDU: cat = CPI_MDU    ; break;
+            case PV_STALL_CRY: cat = CPI_CRYPTO ; break;
+            case PV_STALL_WB : cat = CPI_TRAP   ; break;
+            default          : cat = CPI_FLUSH  ; break;
+        }
+    }
+
+    this -> cycles[cat] ++;
+    this -> instrs += s.ret + s.ret_b;
+
+    if(s.cf_change) {
+        this -> refill = s.s2_flush ? CPI_TRAP : CPI_FLUSH;
+    } else if(s.s2_valid && s.s2_ready) {
+        this -> refill = CPI_FETCH;
+    }
+}
+
+
+//! Total cycles accounted for.
+uint64_t tb_cpi_stack::total() const {
+    uint64_t n = 0;
+    for(int i = 0; i < CPI_NUM; i ++) {
+        n += this -> cycles[i];
+    }
+    return n;
+}
+
+
+//! The stack of the cycles between snapshot rhs and this one.
+tb_cpi_stack tb_cpi_stack::operator - (tb_cpi_stack const & rhs) const {
+    tb_cpi_stack r;
+    for(int i = 0; i < CPI_NUM; i ++) {
+        r.cycles[i] = this -> cycles[i] - rhs.cycles[i];
+    }
+    r.instrs = this -> instrs - rhs.instrs;
+    return r;
+}
+
+
+//! Add the cycles and instructions of rhs to this stack.
+tb_cpi_stack & tb_cpi_stack::operator += (tb_cpi_stack const & rhs) {
+    for(int i = 0; i < CPI_NUM; i ++) {
+        this -> cycles[i] += rhs.cycles[i];
+    }
+    this -> instrs += rhs.instrs;
+    return *this;
+}
+
+
+/*!
+@details One header line, then one line per category with its cycles,
+    share of all cycles, and contribution to the CPI.
+*/
+void tb_cpi_stack::print(std::ostream & os, std::string const & name) const {
+
+    uint64_t n = this -> total();
+
+    os << std::dec << std::fixed << std::setprecision(3)
+       << ">> CPI stack [" << name << "] " << n << " cycles, "
+       << instrs << " instructions";
+
+    if(instrs > 0) {
+        os << ", CPI " << (double)n / instrs;
+    }
+
+    os << std::endl;
+
+    for(int i = 0; i < CPI_NUM; i ++) {
+        double pct = n      ? 100.0 * cycles[i] / n : 0;
+        double cpi = instrs ? (double)cycles[i] / instrs : 0;
+        os << ">>   " << std::left << std::setw(10) << cat_name(i)
+           << std::right << std::setw(12) << cycles[i] << " cycles "
+           << std::setprecision(2) << std::setw(6) << pct << "% CPI "
+           << std::setprecision(3) << cpi << std::endl;
+    }
+}
@@ -0,0 +1,76 @@
+
+#include <iostream>
+#include <string>
+
+#include <stdint.h>
+
+#include "tb_pipeview.hpp"
+
+#ifndef TB_CPI_STACK_HPP
+#define TB_CPI_STACK_HPP
+
+//! What the decode / execute issue slot did with one clock cycle.
+typedef enum cpi_cat {
+    CPI_RETIRING = 0, //!< Issued an instruction.
+    CPI_FETCH    = 1, //!< Fetch buffer empty: instruction memory too slow.
+    CPI_FLUSH    = 2, //!< Waiting on, or refilling after, a branch / jump.
+    CPI_LSU      = 3, //!< Load / store waiting on the data memory.
+    CPI_MDU      = 4, //!< Multi-cycle multiply / divide.
+    CPI_CRYPTO   = 5, //!< Multi-cycle crypto instruction.
+    CPI_TRAP     = 6, //!< CSR / trap / mret / interrupt in writeback.
+    CPI_WFI      = 7, //!< Asleep in WFI.
+    CPI_NUM      = 8
+} cpi_cat_t;
+
+/*!
+@brief Accounts for every clock cycle in a top-down CPI stack.
+@details Each cycle is put in exactly one cpi_cat_t, by looking at the
+    decode / execute stage: either it issued an instruction, or the
+    reason it did not. So the categories add up to the number of cycles,
+    and retiring cycles over instructions is the best possible CPI with
+    dual issue. An empty fetch buffer is put down to whatever last
+    flushed it, until the next instruction issues.
+    Stacks can be subtracted, to find the stack of a region of a run,
+    and added, to total up many entries into a region.
+*/
+class tb_cpi_stack {
+
+public:
+
+    //! Cycles in each category.
+    uint64_t cycles[CPI_NUM] = {0};
+
+    //! Instructions retired.
+    uint64_t instrs = 0;
+
+    //! Account for one cycle of pipeline state, sampled as for tb_pipeview.
+    void sample(pv_sample_t const & s, bool wfi_sleep);
+
+    //! Account for n cycles asleep in WFI, e.g. fast-forwarded ones.
+    void add_wfi(uint64_t n) {
+        this -> cycles[CPI_WFI] += n;
+    }
+
+    //! Total cycles accounted for.
+    uint64_t total() const;
+
+    //! The stack of the cycles between snapshot rhs and this one.
+    tb_cpi_stack operator - (tb_cpi_stack const & rhs) const;
+
+    //! Add the cycles and instructions of rhs to this stack.
+    tb_cpi_stack & operator += (tb_cpi_stack const & rhs);
+
+    //! Print the stack, labelled with name.
+    void print(std::ostream & os, std::string const & name) const;
+
+    //! Name of category i.
+    static const char * cat_name(int i);
+
+protected:
+
+    //! What an empty fetch buffer is waiting on.
+    cpi_cat_t refill = CPI_FETCH;
+
+};
+
+#endif
@@ -0,0 +1,322 @@
+
+#include <algorithm>
+#include <cstdio>
+
+#include "tb_pipeview.hpp"
+
+//! Open path for writing. Check is_open() afterwards.
+tb_pipeview::tb_pipeview (
+    std::string path
+) {
+    this -> fh.open(path);
+}
+
+
+//! Calls finish() if it has not been already.
+tb_pipeview::~tb_pipeview() {
+    this -> finish(this -> last_cycle);
+}
+
+
+//! Name of stall reason i, as used in stage names.
+const char * tb_pipeview::stall_name(int i) {
+    static const char * names[PV_STALL_NUM] = {
+        "", "wb", "lsu", "mdu", "cry", "cf"
+    };
+    return names[i];
+}
+
+
+/*!
+@details Writeback is updated first, so an instruction issuing into it
+    on the same edge as the last one leaves is not retired early. The
+    fetch buffer model then drains what issued, and fills what arrived.
+*/
+void tb_pipeview::sample (
+    uint64_t            cycle,
+    pv_sample_t const & s
+) {
+
+    if(this -> finished) {
+        return;
+    }
+
+    // Writeback. The second lane only retires alongside the first.
+    if(s.ret && !w.empty()) {
+        this -> end(w.front(), cycle + 1, false);
+        w.pop_front();
+        if(s.ret_b && !w.empty()) {
+            this -> end(w.front(), cycle + 1, false);
+            w.pop_front();
+        }
+    }
+
+    if(s.s2_flush) {
+        while(!w.empty()) {
+            this -> end(w.front(), cycle + 1, true);
+            w.pop_front();
+        }
+    }
+
+    // Decode / execute.
+    if(s.s2_valid && x_valid && x.pc != s.s2_pc) {
+        this -> end(x, cycle, true);
+        x_valid = false;
+    }
+
+    if(s.s2_valid && !x_valid && cycle < end_cycle) {
+        this -> begin(x, cycle, s.s2_pc, s.s2_instr, 0);
+        x_valid = true;
+    }
+
+    size_t eaten = 0;
+
+    if(s.s2_valid && s.s2_ready) {
+
+        eaten += halfwords(s.s2_instr);
+
+        if(x_valid) {
+            this -> issue(x, cycle, s.s2_flush);
+            x_valid = false;
+        }
+
+        if(s.s2_b_valid) {
+            if(cycle < end_cycle) {
+                pv_instr_t b;
+                this -> begin(b, cycle, s.s2_b_pc, s.s2_b_instr, eaten);
+                this -> issue(b, cycle, s.s2_flush);
+            }
+            eaten += halfwords(s.s2_b_instr);
+        }
+
+    } else if(s.s2_valid && x_valid) {
+
+        x.stalls[s.stall] ++;
+
+        std::string name = std::string("X.") + stall_name(s.stall);
+
+        if(x.stage != name) {
+            this -> stage(x, cycle, name);
+        }
+
+    }
+
+    // Fetch buffer. A flush wins over anything filled on the same edge.
+    if(s.cf_change) {
+        fetched.clear();
+        if(x_valid) {
+            this -> end(x, cycle + 1, true);
+            x_valid = false;
+        }
+    } else {
+        this -> drain(eaten);
+        for(unsigned i = 0; i < s.fill; i ++) {
+            fetched.push_back(cycle);
+        }
+    }
+
+    this -> last_cycle = cycle;
+
+    if(pending.empty()) {
+        return;
+    }
+
+    // Nothing still in flight, or yet to issue, can start before this.
+    uint64_t safe = cycle;
+
+    if(!fetched.empty()) {
+        safe = std::min(safe, fetched.front());
+    }
+    if(x_valid) {
+        safe = std::min(safe, x.first);
+    }
+    for(auto const & r : w) {
+        safe = std::min(safe, r.first);
+    }
+
+    this -> write(safe);
+}
+
+
+//! Flush anything still in the pipeline, and close the log.
+void tb_pipeview::finish(uint64_t cycle) {
+
+    if(this -> finished) {
+        return;
+    }
+
+    while(!w.empty()) {
+        this -> end(w.front(), cycle, true);
+        w.pop_front();
+    }
+
+    if(x_valid) {
+        this -> end(x, cycle, true);
+        x_valid = false;
+    }
+
+    this -> write(-1);
+
+    if(!this -> started && this -> fh.is_open()) {
+        fh << "Kanata\t0004\n"
+           << "C=\t" << start_cycle << "\n";
+    }
+
+    this -> fh.close();
+    this -> finished = true;
+}
+
+
+//! Start tracking the instruction at halfword offset hw of the buffer.
+void tb_pipeview::begin (
+    pv_instr_t & r      ,
+    uint64_t     cycle  ,
+    uint64_t     pc     ,
+    uint32_t     instr  ,
+    size_t       hw
+) {
+
+    char label[40];
+    snprintf(label, sizeof(label), "%016lx: %08x",
+             (unsigned long)pc, (unsigned)instr);
+
+    r.pc      = pc;
+    r.instr   = instr;
+    r.first   = hw < fetched.size() ? fetched[hw] : cycle;
+    r.x_start = cycle;
+    r.log     = active && cycle >= start_cycle && cycle < end_cycle;
+    r.stage   = "";
+    r.events.clear();
+
+    for(int i = 0; i < PV_STALL_NUM; i ++) {
+        r.stalls[i] = 0;
+    }
+
+    r.events.push_back({r.first, "I"});
+    r.events.push_back({r.first, "L\t0\t" + std::string(label)});
+
+    if(r.first < cycle) {
+        this -> stage(r, r.first, "F");
+    }
+
+    this -> stage(r, cycle, "X");
+}
+
+
+//! Move r to a new stage.
+void tb_pipeview::stage (
+    pv_instr_t & r      ,
+    uint64_t     cycle  ,
+    std::string  name
+) {
+    // Rename a stage which started this cycle, rather than log it with no
+    // length.
+    if(!r.events.empty() && r.events.back().first == cycle &&
+        r.events.back().second == "S\t0\t" + r.stage) {
+        r.events.back().second = "S\t0\t" + name;
+        r.stage = name;
+        return;
+    }
+
+    if(!r.stage.empty()) {
+        r.events.push_back({cycle, "E\t0\t" + r.stage});
+    }
+    r.events.push_back({cycle, "S\t0\t" + name});
+    r.stage = name;
+}
+
+
+//! Issue r from execute into writeback, or flush it.
+void tb_pipeview::issue (
+    pv_instr_t & r      ,
+    uint64_t     cycle  ,
+    bool         flushed
+) {
+    if(flushed) {
+        this -> end(r, cycle + 1, true);
+    } else {
+        this -> stage(r, cycle + 1, "W");
+        this -> w.push_back(r);
+    }
+}
+
+
+/*!
+@details Instructions are given IDs as they finish, so the IDs in the log
+    are in program order and have no gaps, even with a cycle window.
+*/
+void tb_pipeview::end (
+    pv_instr_t & r      ,
+    uint64_t     cycle  ,
+    bool         flushed
+) {
+
+    if(!r.log) {
+        return;
+    }
+
+    std::string id = std::to_string(this -> next_id ++);
+
+    r.events.push_back({cycle, "E\t0\t" + r.stage});
+
+    std::string detail;
+
+    for(int i = 1; i < PV_STALL_NUM; i ++) {
+        if(r.stalls[i]) {
+            detail += std::string(detail.empty() ? "" : ", ") +
+                      stall_name(i) + " " + std::to_string(r.stalls[i]);
+        }
+    }
+
+    if(!detail.empty()) {
+        r.events.push_back({cycle, "L\t1\tstalled: " + detail});
+    }
+
+    std::string rid = flushed ? id : std::to_string(this -> next_retire ++);
+
+    r.events.push_back({cycle, "R\t" + rid + "\t" + (flushed ? "1" : "0")});
+
+    for(auto const & e : r.events) {
+        std::string line = e.second.substr(0, 1) + "\t" + id;
+        if(e.second == "I") {
+            line += "\t" + id + "\t0";
+        } else {
+            line += e.second.substr(1);
+        }
+        this -> pending.insert({e.first, line});
+    }
+
+    r.events.clear();
+}
+
+
+//! Write out every pending line before cycle.
+void tb_pipeview::write(uint64_t cycle) {
+
+    auto it = pending.begin();
+
+    while(it != pending.end() && it -> first < cycle) {
+
+        if(!this -> started) {
+            fh << "Kanata\t0004\n"
+               << "C=\t" << it -> first << "\n";
+            this -> started    = true;
+            this -> last_write = it -> first;
+        } else if(it -> first > this -> last_write) {
+            fh << "C\t" << it -> first - this -> last_write << "\n";
+            this -> last_write = it -> first;
+        }
+
+        fh << it -> second << "\n";
+
+        it = pending.erase(it);
+    }
+}
+
+
+//! Drop n halfwords from the front of the fetch buffer model.
+void tb_pipeview::drain(size_t n) {
+    while(n -- > 0 && !fetched.empty()) {
+        fetched.pop_front();
+    }
+}
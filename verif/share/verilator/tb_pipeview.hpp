@@ -0,0 +1,143 @@
+
+#include <deque>
+#include <fstream>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <stdint.h>
+
+#ifndef TB_PIPEVIEW_HPP
+#define TB_PIPEVIEW_HPP
+
+//! Why the instruction in decode / execute did not issue. See core_top.
+typedef enum pv_stall {
+    PV_STALL_NONE = 0, //!< It issued.
+    PV_STALL_WB   = 1, //!< Writeback was not ready.
+    PV_STALL_LSU  = 2, //!< Waiting on lsu_ready.
+    PV_STALL_MDU  = 3, //!< Waiting on mdu_ready.
+    PV_STALL_CRY  = 4, //!< Waiting on cry_ready.
+    PV_STALL_CF   = 5, //!< Waiting on a control flow change, or WFI.
+    PV_STALL_NUM  = 6
+} pv_stall_t;
+
+//! Core pipeline state, sampled just before a rising clock edge.
+typedef struct pv_sample {
+    bool       s2_valid   = false; //!< Instruction in decode / execute.
+    bool       s2_ready   = false; //!< It issues on this edge.
+    bool       s2_b_valid = false; //!< The second lane issues with it.
+    bool       s2_flush   = false; //!< Issuing instructions are flushed.
+    bool       cf_change  = false; //!< The fetch buffer is flushed.
+    bool       ret        = false; //!< Writeback retires lane 0.
+    bool       ret_b      = false; //!< Writeback retires lane 1.
+    pv_stall_t stall      = PV_STALL_NONE;
+    unsigned   fill       = 0;     //!< Halfwords filled into the buffer.
+    uint64_t   s2_pc      = 0;
+    uint32_t   s2_instr   = 0;
+    uint64_t   s2_b_pc    = 0;
+    uint32_t   s2_b_instr = 0;
+} pv_sample_t;
+
+/*!
+@brief Writes a per-instruction pipeline trace, which Konata can open.
+@details Each instruction goes through these stages:
+    - F: In the fetch buffer, from the cycle its first halfword arrived.
+    - X: Decode / execute.
+    - X.wb, X.lsu, X.mdu, X.cry, X.cf: Decode / execute, stalled for the
+      given reason. See pv_stall_t.
+    - W: Writeback.
+    It then retires, or is flushed by a control flow change. Cycles are
+    full clock cycles. The log is in the Kanata 0004 format.
+*/
+class tb_pipeview {
+
+public:
+
+    //! Open path for writing. Check is_open() afterwards.
+    tb_pipeview(std::string path);
+
+    //! Calls finish() if it has not been already.
+    ~tb_pipeview();
+
+    //! Did the log file open?
+    bool is_open() {return this -> fh.is_open();}
+
+    //! Only instructions which start executing in [start, end) are logged.
+    uint64_t start_cycle    = 0;
+    uint64_t end_cycle      = -1;
+
+    //! If clear, instructions which start executing are not logged.
+    bool     active         = true;
+
+    //! Record the pipeline state for one cycle. Call once per cycle.
+    void sample(uint64_t cycle, pv_sample_t const & s);
+
+    //! Flush anything still in the pipeline, and close the log.
+    void finish(uint64_t cycle);
+
+    //! Name of stall reason i, as used in stage names.
+    static const char * stall_name(int i);
+
+protected:
+
+    //! One instruction, with its events so far.
+    typedef struct pv_instr {
+        uint64_t    pc;
+        uint32_t    instr;
+        uint64_t    first;                  //!< Cycle of its first event.
+        uint64_t    x_start;                //!< Cycle it reached execute.
+        bool        log;                    //!< Write it out when it ends.
+        uint64_t    stalls[PV_STALL_NUM];   //!< Stall cycles by reason.
+        std::string stage;                  //!< Current stage name.
+        std::vector<std::pair<uint64_t, std::string>> events;
+    } pv_instr_t;
+
+    std::ofstream fh;
+
+    //! Arrival cycle of each halfword in the fetch buffer, oldest first.
+    std::deque<uint64_t> fetched;
+
+    //! Instruction in decode / execute.
+    pv_instr_t  x;
+    bool        x_valid     = false;
+
+    //! Instructions in writeback, in program order.
+    std::deque<pv_instr_t> w;
+
+    //! Finished instruction log lines, waiting to be written in order.
+    std::multimap<uint64_t, std::string> pending;
+
+    uint64_t    next_id     = 0;
+    uint64_t    next_retire = 0;
+    uint64_t    last_cycle  = 0;    //!< Last cycle sampled.
+    uint64_t    last_write  = 0;    //!< Cycle of the last line written.
+    bool        started     = false;
+    bool        finished    = false;
+
+    //! Start tracking the instruction at halfword offset hw of the buffer.
+    void begin(pv_instr_t & r, uint64_t cycle, uint64_t pc, uint32_t instr,
+               size_t hw);
+
+    //! Move r to a new stage.
+    void stage(pv_instr_t & r, uint64_t cycle, std::string name);
+
+    //! r leaves the pipeline, at the start of cycle.
+    void end(pv_instr_t & r, uint64_t cycle, bool flushed);
+
+    //! Issue r from execute into writeback, or flush it.
+    void issue(pv_instr_t & r, uint64_t cycle, bool flushed);
+
+    //! Write out every pending line before cycle.
+    void write(uint64_t cycle);
+
+    //! Drop n halfwords from the front of the fetch buffer model.
+    void drain(size_t n);
+
+    //! Size of an instruction, in halfwords.
+    static size_t halfwords(uint32_t instr) {
+        return (instr & 0x3) == 0x3 ? 2 : 1;
+    }
+
+};
+
+#endif
@@ -0,0 +1,84 @@
+
+#include <iomanip>
+
+#include "tb_roi.hpp"
+
+/*!
+@details Beginning a region which is already active does nothing, so
+    a marker in a recursive function counts each cycle only once.
+*/
+void tb_roi::begin (
+    unsigned             id     ,
+    std::string const &  name   ,
+    uint64_t             cycle  ,
+    tb_cpi_stack const & now
+) {
+
+    roi_region_t & r = this -> regions[id];
+
+    if(r.active) {
+        return;
+    }
+
+    if(r.entries == 0) {
+        r.name  = name != "" ? name : "roi" + std::to_string(id);
+        r.first = cycle;
+    }
+
+    r.entries ++;
+    r.active = true;
+    r.start  = now;
+
+    this -> n_active ++;
+}
+
+
+//! Leave region id at cycle. Does nothing if it is not active.
+void tb_roi::end (
+    unsigned             id     ,
+    uint64_t             cycle  ,
+    tb_cpi_stack const & now
+) {
+
+    auto it = this -> regions.find(id);
+
+    if(it == this -> regions.end() || !it -> second.active) {
+        return;
+    }
+
+    roi_region_t & r = it -> second;
+
+    r.total += now - r.start;
+    r.last   = cycle;
+    r.active = false;
+
+    this -> n_active --;
+}
+
+
+//! Leave every region still active. Call at the end of the run.
+void tb_roi::finish(uint64_t cycle, tb_cpi_stack const & now) {
+    for(auto & it : this -> regions) {
+        this -> end(it.first, cycle, now);
+    }
+}
+
+
+/*!
+@details One line per region, followed by its CPI stack, labelled with
+    the region name.
+*/
+void tb_roi::print(std::ostream & os) const {
+
+    for(auto const & it : this -> regions) {
+
+        roi_region_t const & r = it.second;
+
+        os << std::dec << ">> ROI " << it.first << " [" << r.name << "] "
+           << "entered " << r.entries << " times, cycles "
+           << r.first << " to " << r.last << std::endl;
+
+        r.total.print(os, r.name);
+    }
+
+}
@@ -0,0 +1,90 @@
+
+#include <iostream>
+#include <map>
+#include <string>
+
+#include <stdint.h>
+
+#include "tb_cpi_stack.hpp"
+
+#ifndef TB_ROI_HPP
+#define TB_ROI_HPP
+
+/*!
+@brief Tracks regions of interest, marked out by the program being run.
+@details A region is begun or ended by retiring the HINT instruction
+    slti x0, rs1, imm. imm[10:1] is the region ID, and imm[0] is 0 to
+    begin it or 1 to end it. When beginning a region, rs1 may point at
+    a NUL terminated name for it. Otherwise it is called roi<ID>.
+    See CROYDE_CSP_ROI_BEGIN / CROYDE_CSP_ROI_END in croyde_csp.h.
+    Regions may overlap or nest, and be entered many times. Each one
+    accumulates the CPI stack of every cycle spent inside it.
+*/
+class tb_roi {
+
+public:
+
+    //! Is instr a region marker?
+    static bool is_marker(uint32_t instr) {
+        return (instr & 0x7FFF) == 0x2013;
+    }
+
+    //! Region ID of a marker.
+    static unsigned marker_id(uint32_t instr) {
+        return (instr >> 21) & 0x3FF;
+    }
+
+    //! Does a marker end its region, rather than begin it?
+    static bool marker_end(uint32_t instr) {
+        return (instr >> 20) & 0x1;
+    }
+
+    //! Register holding a marker's region name, or 0 if it has none.
+    static unsigned marker_rs1(uint32_t instr) {
+        return (instr >> 15) & 0x1F;
+    }
+
+    //! Enter region id at cycle. Name it, if this is the first entry.
+    void begin(unsigned id, std::string const & name, uint64_t cycle,
+               tb_cpi_stack const & now);
+
+    //! Leave region id at cycle.
+    void end(unsigned id, uint64_t cycle, tb_cpi_stack const & now);
+
+    //! Leave every region still active. Call at the end of the run.
+    void finish(uint64_t cycle, tb_cpi_stack const & now);
+
+    //! Number of regions currently active.
+    unsigned active() const {
+        return this -> n_active;
+    }
+
+    //! Have any regions been entered?
+    bool empty() const {
+        return this -> regions.empty();
+    }
+
+    //! Print every region's entries, cycles and CPI stack.
+    void print(std::ostream & os) const;
+
+protected:
+
+    //! One region, with its totals so far.
+    typedef struct roi_region {
+        std::string  name;
+        uint64_t     entries    = 0;
+        uint64_t     first      = 0;    //!< Cycle it was first entered.
+        uint64_t     last       = 0;    //!< Cycle it was last left.
+        bool         active     = false;
+        tb_cpi_stack start;             //!< Stack when last entered.
+        tb_cpi_stack total;             //!< Stack of every entry so far.
+    } roi_region_t;
+
+    //! Every region entered so far, by ID.
+    std::map<unsigned, roi_region_t> regions;
+
+    unsigned n_active = 0;
+
+};
+
+#endif
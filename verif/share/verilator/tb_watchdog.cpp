@@ -0,0 +1,155 @@
+
+#include <iomanip>
+
+#include "tb_watchdog.hpp"
+
+//! Start watching from the given cycle, e.g. just after reset.
+void tb_watchdog::reset (
+    uint64_t cycle
+) {
+    this -> reason       = WDOG_NONE;
+    this -> last_retire  = cycle;
+    this -> prev_valid   = false;
+    this -> loop_valid   = false;
+    this -> loop_len     = 0;
+    this -> history_next = 0;
+    this -> history.clear();
+}
+
+
+/*!
+*/
+bool tb_watchdog::retire (
+    uint64_t cycle,
+    uint64_t pc,
+    uint32_t instr
+) {
+
+    if(this -> history.size() < history_len) {
+        this -> history.push_back({cycle, pc, instr});
+    } else {
+        this -> history[this -> history_next] = {cycle, pc, instr};
+    }
+
+    this -> history_next = (this -> history_next + 1) % history_len;
+
+    bool backwards = this -> prev_valid && pc <= this -> prev_pc;
+
+    this -> last_retire = cycle;
+    this -> prev_pc     = pc;
+    this -> prev_valid  = true;
+    this -> loop_len   ++;
+
+    return backwards && this -> loop_limit > 0;
+}
+
+
+/*!
+@details The same head must come round again with the same GPR values,
+    within loop_max_len instructions, for the loop to keep being watched.
+    Anything else starts watching a new loop.
+*/
+void tb_watchdog::loop_iteration (
+    uint64_t cycle,
+    uint64_t pc,
+    uint64_t state
+) {
+
+    bool same = this -> loop_valid              &&
+                this -> loop_pc     == pc       &&
+                this -> loop_state  == state    &&
+                this -> loop_len    <= this -> loop_max_len;
+
+    this -> loop_len = 0;
+
+    if(!same) {
+        this -> loop_pc     = pc;
+        this -> loop_state  = state;
+        this -> loop_start  = cycle;
+        this -> loop_valid  = this -> loop_ignore.count(pc) == 0;
+        return;
+    }
+
+    if(this -> reason == WDOG_NONE &&
+       cycle - this -> loop_start >= this -> loop_limit) {
+        this -> reason      = WDOG_LOOP;
+        this -> fired_cycle = cycle;
+    }
+}
+
+
+/*!
+*/
+bool tb_watchdog::check (
+    uint64_t cycle,
+    bool     asleep,
+    uint64_t bus_wait
+) {
+
+    if(this -> reason != WDOG_NONE) {
+        return true;
+    }
+
+    if(asleep) {
+        this -> last_retire = cycle;
+    }
+
+    if(this -> idle_limit > 0 &&
+       cycle - this -> last_retire >= this -> idle_limit) {
+        this -> reason = WDOG_IDLE;
+
+    } else if(this -> stall_limit > 0 && bus_wait >= this -> stall_limit) {
+        this -> reason = WDOG_STALL;
+        this -> fired_wait = bus_wait;
+
+    } else {
+        return false;
+    }
+
+    this -> fired_cycle = cycle;
+
+    return true;
+}
+
+
+//! Print why the watchdog fired, and the last retired instructions.
+void tb_watchdog::print_report(std::ostream & os) {
+
+    os << std::dec << ">> Watchdog fired at cycle " << fired_cycle << ": ";
+
+    switch(this -> reason) {
+        case WDOG_IDLE:
+            os << "nothing retired for " << fired_cycle - last_retire
+               << " cycles";
+            break;
+        case WDOG_LOOP:
+            os << "loop at 0x" << std::hex << loop_pc << std::dec
+               << " has not changed any GPRs for "
+               << fired_cycle - loop_start << " cycles";
+            break;
+        case WDOG_STALL:
+            os << "memory transaction outstanding for " << fired_wait
+               << " cycles";
+            break;
+        default:
+            os << "no hang";
+            break;
+    }
+
+    os << std::endl;
+
+    os << ">> Last " << history.size() << " retired instructions:"
+       << std::endl;
+
+    size_t first = history.size() < history_len ? 0 : history_next;
+
+    for(size_t i = 0; i < history.size(); i ++) {
+        wdog_retired_t & r = history[(first + i) % history_len];
+        os << ">>   " << std::dec << std::setw(10) << std::setfill(' ')
+           << r.cycle << "  0x" << std::hex << std::setw(16)
+           << std::setfill('0') << r.pc << "  "  << std::setw(8)
+           << r.instr << std::endl;
+    }
+
+    os << std::dec << std::setfill(' ');
+}
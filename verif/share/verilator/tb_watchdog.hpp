@@ -0,0 +1,140 @@
+
+#include <iostream>
+#include <set>
+#include <vector>
+
+#include <stdint.h>
+
+#ifndef TB_WATCHDOG_HPP
+#define TB_WATCHDOG_HPP
+
+/*!
+@brief Spots a hung simulation early, so it ends with a diagnosis rather
+    than running on to the timeout.
+@details There are three checks. A limit of 0 turns a check off.
+    - idle:  Nothing has retired for idle_limit cycles, and the core is
+      not asleep in WFI.
+    - loop:  The core has gone round the same short loop for loop_limit
+      cycles, with the same GPR values at the top of every iteration.
+      Only something outside the core, like an interrupt, can get it
+      out.
+    - stall: A memory transaction has been outstanding for stall_limit
+      cycles.
+    All cycle counts are full clock cycles.
+*/
+class tb_watchdog {
+
+public:
+
+    //! Why the watchdog fired.
+    typedef enum wdog_reason {
+        WDOG_NONE  = 0, //!< It has not fired.
+        WDOG_IDLE  = 1, //!< No instructions retired.
+        WDOG_LOOP  = 2, //!< Spinning in a loop which changes nothing.
+        WDOG_STALL = 3  //!< A memory transaction never completed.
+    } wdog_reason_t;
+
+    //! Cycles without a retirement before firing.
+    uint64_t idle_limit     = 100000;
+
+    //! Cycles spent in an unchanging loop before firing.
+    uint64_t loop_limit     = 1000000;
+
+    //! Cycles a memory transaction may be outstanding before firing.
+    uint64_t stall_limit    = 10000;
+
+    //! Longest loop body, in instructions, checked by the loop check.
+    uint32_t loop_max_len   = 64;
+
+    //! Loop heads the loop check ignores, e.g. the pass / fail address.
+    std::set<uint64_t> loop_ignore;
+
+    //! Why the watchdog fired, or WDOG_NONE.
+    wdog_reason_t reason    = WDOG_NONE;
+
+    //! Start watching from the given cycle, e.g. just after reset.
+    void reset(uint64_t cycle);
+
+    /*!
+    @brief Record a retired instruction.
+    @returns true if pc is the target of a backwards jump, and so may be
+        the top of a loop. The caller should then pass a hash of the GPRs
+        to loop_iteration.
+    */
+    bool retire (
+        uint64_t cycle,
+        uint64_t pc,
+        uint32_t instr
+    );
+
+    //! Note the top of a loop iteration at pc, with GPR hash state.
+    void loop_iteration (
+        uint64_t cycle,
+        uint64_t pc,
+        uint64_t state
+    );
+
+    /*!
+    @brief Run the idle and stall checks. Call once per clock cycle.
+    @param in asleep   - Is the core asleep in WFI?
+    @param in bus_wait - Cycles the oldest memory transaction has waited.
+    @returns true if the watchdog has fired.
+    */
+    bool check (
+        uint64_t cycle,
+        bool     asleep,
+        uint64_t bus_wait
+    );
+
+    //! Print why the watchdog fired, and the last retired instructions.
+    void print_report(std::ostream & os);
+
+    //! Fold v into a running GPR hash.
+    static uint64_t hash(uint64_t h, uint64_t v) {
+        return (h ^ v) * 0x100000001B3UL;
+    }
+
+    //! Initial value for hash.
+    static const uint64_t hash_init = 0xCBF29CE484222325UL;
+
+protected:
+
+    //! One retired instruction.
+    typedef struct wdog_retired {
+        uint64_t cycle;
+        uint64_t pc;
+        uint32_t instr;
+    } wdog_retired_t;
+
+    //! Number of retired instructions kept for the report.
+    static const size_t history_len = 32;
+
+    //! Ring buffer of the last history_len retired instructions.
+    std::vector<wdog_retired_t> history;
+
+    //! Next entry of history to write.
+    size_t   history_next   = 0;
+
+    //! Cycle of the last retirement, or of waking from WFI.
+    uint64_t last_retire    = 0;
+
+    //! PC of the last retired instruction.
+    uint64_t prev_pc        = 0;
+    bool     prev_valid     = false;
+
+    //! Instructions retired since the last loop head.
+    uint64_t loop_len       = 0;
+
+    //! Loop being watched: its head, GPR hash and first cycle.
+    uint64_t loop_pc        = 0;
+    uint64_t loop_state     = 0;
+    uint64_t loop_start     = 0;
+    bool     loop_valid     = false;
+
+    //! Cycle the watchdog fired on, and the wait which fired it.
+    uint64_t fired_cycle    = 0;
+    uint64_t fired_wait     = 0;
+
+};
+
+#endif
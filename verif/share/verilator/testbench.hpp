@@ -0,0 +1,354 @@
+
+#include <iostream>
+#include <string>
+
+#include "memory_txns.hpp"
+#include "memory_device.hpp"
+#include "memory_device_ram.hpp"
+#include "memory_device_uart.hpp"
+#include "memory_device_htif.hpp"
+#include "memory_bus.hpp"
+
+#include "dut_wrapper.hpp"
+#include "tb_roi.hpp"
+#include "tb_watchdog.hpp"
+
+#ifndef TESTBENCH_HPP
+#define TESTBENCH_HPP
+
+/*!
+@brief Memory bus, devices and DUT for one Verilated top level.
+@tparam TOP - Top level traits, as for dut_wrapper. These must also
+    provide add_devices(memory_bus*), which adds the top's own memories
+    to the bus. The UART and HTIF devices are common to every top.
+*/
+template <class TOP>
+class testbench {
+
+public:
+
+    //! Create a new testbench.
+    testbench (
+        std::string waves_file,
+        bool        waves_dump
+    ) {
+
+        this -> waves_file = waves_file;
+        this -> waves_dump = waves_dump;
+
+        this -> build();
+    }
+
+    //! Free the DUT, then the bus and every device on it.
+    ~testbench() {
+        delete this -> dut;
+        delete this -> bus;
+    }
+
+    //! Memory device bus.
+    memory_bus  * bus;
+
+    //! UART device used to print messages.
+    memory_device_uart * uart_0;
+
+    //! Host interface device, for exit codes and host file I/O.
+    memory_device_htif * htif_0;
+
+    //! The design under test.
+    dut_wrapper<TOP> * dut;
+
+    //! Run the simulation from beginning to end.
+    void run_simulation() {
+        this -> pre_run();
+        this -> run();
+        this -> post_run();
+    }
+
+    uint64_t        max_sim_time        = 10000;
+
+    //! If the DUT traces out this address, indicate a pass.
+    memory_address  pass_address     = 0;
+
+    //! If the DUT traces out this address, indicate a failure.
+    memory_address  fail_address     = -1;
+
+    //! Return total simulation time so far.
+    uint64_t get_sim_time() {
+        return this -> dut -> get_sim_time();
+    }
+
+    bool            sim_finished    = false;
+
+    bool            sim_passed      = false;
+
+    //! Set if the watchdog ended the simulation early.
+    bool            sim_hung        = false;
+
+    //! Watches for hangs during run(). Set its limits before running.
+    tb_watchdog     wdog;
+
+    //! Regions of interest marked out by the program.
+    tb_roi          roi;
+
+    //! Only dump waves while at least one region is active.
+    bool            roi_waves       = false;
+
+    //! Only write the pipeline view while at least one region is active.
+    bool            roi_trace       = false;
+
+    //! Longest region name read from memory.
+    const size_t    roi_name_max    = 64;
+
+protected:
+
+    //! Construct all of the objects we need inside the testbench.
+    void build();
+
+    //! Called immediately before the run function.
+    void pre_run();
+
+    //! The main phase of the DUT simulation.
+    void run();
+
+    //! Called after the run function has returned.
+    void post_run();
+
+    //! Current clock cycle, as counted by the watchdog.
+    uint64_t wdog_cycle() {
+        return dut -> get_sim_time() / dut -> ticks_per_cycle();
+    }
+
+    //! Hash of the GPRs, for the watchdog's loop check.
+    uint64_t gpr_hash();
+
+    //! Print the watchdog report, trap CSRs and outstanding transactions.
+    void print_hang(std::ostream & os);
+
+    //! Begin or end a region of interest, for a retired marker instr.
+    void roi_marker(uint32_t instr, uint64_t cycle);
+
+    //! Turn waves and the pipeline view on or off, to match the regions.
+    void roi_gate();
+
+    //! Where to dump waveforms.
+    std::string waves_file;
+
+    //! Whether or not to dump waveforms.
+    bool        waves_dump;
+
+    //! Default base address of the UART.
+    size_t      uart_base_addr = 0x11000000;
+
+    //! Default base address of the host interface.
+    size_t      htif_base_addr = 0x11001000;
+
+};
+
+
+//! Construct all of the objects we need inside the testbench.
+template <class TOP>
+void testbench<TOP>::build() {
+
+    this -> bus         = new memory_bus();
+
+    this -> uart_0 = new memory_device_uart (
+        this -> uart_base_addr
+    );
+
+    this -> htif_0 = new memory_device_htif (
+        this -> htif_base_addr,
+        this -> bus
+    );
+
+    this -> bus -> add_device(this -> uart_0);
+    this -> bus -> add_device(this -> htif_0);
+
+    TOP::add_devices(this -> bus);
+
+    this -> dut = new dut_wrapper<TOP>(
+        this -> bus,
+        this -> waves_dump,
+        this -> waves_file
+    );
+
+}
+
+//! Called immediately before the run function.
+template <class TOP>
+void testbench<TOP>::pre_run() {
+
+    this -> dut -> dut_set_reset();
+
+}
+
+//! The main phase of the DUT simulation.
+template <class TOP>
+void testbench<TOP>::run() {
+
+    // Run the DUT for a few cycles while held in reset.
+    for(int i = 0; i < 5; i ++) {
+        dut -> dut_step_clk();
+    }
+
+    // Start running the DUT proper.
+    dut -> dut_clear_reset();
+
+    dut_trace_pkt_t trs_item;
+
+    wdog.loop_ignore.insert(pass_address);
+    wdog.loop_ignore.insert(fail_address);
+    wdog.reset(wdog_cycle());
+
+    roi_gate();
+
+    while(dut -> get_sim_time() < max_sim_time && !sim_finished) {
+
+        dut -> dut_step_clk();
+
+        dut -> dut_wfi_fast_forward(max_sim_time - dut -> get_sim_time());
+
+        uint64_t cycle = wdog_cycle();
+
+        while(dut -> dut_trace.empty() == false && !sim_finished) {
+            trs_item = dut -> dut_trace.front();
+
+            if(trs_item.program_counter == pass_address) {
+                sim_passed  = true;
+                sim_finished= true;
+            } else if (trs_item.program_counter == fail_address) {
+                sim_passed  = false;
+                sim_finished= true;
+            }
+
+            if(tb_roi::is_marker(trs_item.instr_word)) {
+                roi_marker(trs_item.instr_word, cycle);
+            }
+
+            if(wdog.retire(cycle, trs_item.program_counter,
+                                  trs_item.instr_word)) {
+                wdog.loop_iteration(
+                    cycle, trs_item.program_counter, gpr_hash()
+                );
+            }
+
+            dut -> dut_trace.pop();
+        }
+
+        if(htif_0 -> exited()) {
+            std::cout << ">> HTIF exit code " << std::dec
+                      << htif_0 -> exit_code() << std::endl;
+            sim_passed  = htif_0 -> exit_code() == 0;
+            sim_finished= true;
+        }
+
+        if(!sim_finished && wdog.check(cycle, dut -> dut_wfi_sleep(),
+                                       dut -> agents -> max_wait())) {
+            print_hang(std::cout);
+            sim_passed  = false;
+            sim_hung    = true;
+            sim_finished= true;
+        }
+
+    }
+
+    roi.finish(wdog_cycle(), dut -> cpi);
+
+}
+
+/*!
+@details The name is read from memory through the bus, so it must be
+    somewhere the testbench can see. If it cannot be read, the region
+    is named after its ID instead.
+*/
+template <class TOP>
+void testbench<TOP>::roi_marker(uint32_t instr, uint64_t cycle) {
+
+    unsigned id = tb_roi::marker_id(instr);
+
+    if(tb_roi::marker_end(instr)) {
+
+        roi.end(id, cycle, dut -> cpi);
+
+    } else {
+
+        std::string name;
+        uint64_t  * rs1 = dut -> dut_gpr(tb_roi::marker_rs1(instr));
+
+        for(size_t i = 0; rs1 != NULL && *rs1 != 0 && i < roi_name_max; i++) {
+            uint8_t c;
+            if(!bus -> read_range(*rs1 + i, 1, &c)) {
+                name.clear();
+                break;
+            }
+            if(c == 0) {
+                break;
+            }
+            name.push_back(c);
+        }
+
+        roi.begin(id, name, cycle, dut -> cpi);
+
+    }
+
+    roi_gate();
+}
+
+//! Turn waves and the pipeline view on or off, to match the regions.
+template <class TOP>
+void testbench<TOP>::roi_gate() {
+
+    bool on = roi.active() > 0;
+
+    if(roi_waves) {
+        dut -> waves_on = on;
+    }
+
+    if(roi_trace && dut -> pipeview != NULL) {
+        dut -> pipeview -> active = on;
+    }
+}
+
+//! Hash of the GPRs, for the watchdog's loop check.
+template <class TOP>
+uint64_t testbench<TOP>::gpr_hash() {
+
+    uint64_t h = tb_watchdog::hash_init;
+
+    for(unsigned i = 1; i < 32; i ++) {
+        h = tb_watchdog::hash(h, *dut -> dut_gpr(i));
+    }
+
+    return h;
+}
+
+//! Print the watchdog report, trap CSRs and outstanding transactions.
+template <class TOP>
+void testbench<TOP>::print_hang(std::ostream & os) {
+
+    wdog.print_report(os);
+
+    dut_csrs_t csrs = dut -> dut_csrs();
+
+    os << std::hex
+       << ">> mepc   0x" << csrs.mepc   << std::endl
+       << ">> mcause 0x" << csrs.mcause << std::endl
+       << ">> mtval  0x" << csrs.mtval  << std::endl
+       << ">> mtvec  0x" << csrs.mtvec  << std::endl
+       << std::dec;
+
+    os << ">> Outstanding memory transactions:" << std::endl;
+
+    dut -> agents -> print_outstanding(os);
+}
+
+//! Called after the run function has returned.
+template <class TOP>
+void testbench<TOP>::post_run() {
+
+    if(this -> waves_dump) {
+        dut -> trace_fh -> close();
+    }
+
+}
+
+#endif